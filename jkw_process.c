@@ -1,78 +1,466 @@
+/**
+ * Synchronization primitive contention benchmark.
+ * Runs 1, 2, 4, ... threads (up to all cores) that increment a shared counter for a fixed time,
+ * once for each way of protecting the counter: pthread mutex, spinlock, ticket lock, atomic_fetch_add,
+ * and per-thread counters on separate cache lines (shards), and reports for each run:
+ * - throughput (increments per second),
+ * - fairness (Jain's index over the per-thread counts: 1.0 == every thread got the same share),
+ * - latency percentiles of one increment (lock, increment, unlock), sampled every LATENCY_SAMPLE ops.
+ * The final counter is checked against the per-thread counts, so a broken lock shows up as an error.
+ *
+ * Compile: gcc -O2 -o jkw_process jkw_process.c -lpthread
+ * Usage:   ./jkw_process [-t max threads] [-s seconds per run] [-w work between increments]
+ *                        [-p none|compact|spread] [-l mutex,spin,ticket,atomic,shard] [-c]
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#define _GNU_SOURCE	// pthread_setaffinity_np
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include <unistd.h>
-#include <pthread.h>
+
+#define CACHE_LINE 64
+#define LATENCY_SAMPLE 64	// Every 64th increment is timed.
+#define HISTOGRAM_BUCKETS 320	// Log-linear buckets: exact below 16 ns, then 8 per power of two.
+#define MAX_THREADS 256
+
+enum LockType {
+	LOCK_MUTEX,
+	LOCK_SPIN,
+	LOCK_TICKET,
+	LOCK_ATOMIC,
+	LOCK_SHARD,
+	NUM_LOCK_TYPES
+};
+
+enum PinMode {
+	PIN_NONE,	// Let the scheduler place threads.
+	PIN_COMPACT,	// Thread i on CPU i.
+	PIN_SPREAD	// Threads spaced evenly over all CPUs.
+};
+
+/**
+ * Ticket lock: each thread takes the next ticket and waits for it to be served, so the lock is
+ * handed out strictly in arrival order.
+ */
+struct TicketLock {
+	atomic_uint next;
+	atomic_uint serving;
+};
+
+/**
+ * The shared state: every kind of lock next to the counter it protects, as it would be in a real structure.
+ */
+struct SharedCounter {
+	pthread_mutex_t mutex;
+	atomic_bool spin;
+	struct TicketLock ticket;
+	long long value;		// Protected by the lock under test.
+	atomic_llong atomic_value;
+} __attribute__((aligned(CACHE_LINE)));
+
+/**
+ * One counter per thread, each on its own cache line, summed when the run is over.
+ */
+struct Shard {
+	atomic_llong value;
+} __attribute__((aligned(CACHE_LINE)));
+
+struct Worker {
+	pthread_t tid;
+	int index;
+	long long ops;
+	long long histogram[HISTOGRAM_BUCKETS];
+} __attribute__((aligned(CACHE_LINE)));
 
 /* Global Variables */
-pthread_mutex_t mutex_value;
-int value = 0;
+const char *lock_names[NUM_LOCK_TYPES] = { "mutex", "spin", "ticket", "atomic", "shard" };
+struct SharedCounter counter;
+struct Shard shards[MAX_THREADS];
+atomic_int num_ready;		// Workers pinned and waiting for the start.
+atomic_bool go;			// Starts the workers, also set to abandon a run.
+atomic_bool stop;
+enum LockType lock_type;
+enum PinMode pin_mode = PIN_NONE;
+int num_threads;
+int num_cpus;
+int work = 0;			// Iterations of private work between increments.
 
 
-void *threadOne(void *ptr)
+/**
+ * Nanoseconds on the monotonic clock.
+ */
+static inline long long _now()
 {
-	// pthread_lock_mutex checks if mutex is locked:
-	/// If it is, waits until unlocked.
-	/// If it isnt, locks it and proceeds.
-	// checks value again to ensure we dont increment over 50.
-	// unlocks mutex and sleeps for a random time.
-	// exits when value == 50
-
-	while (value < 50) {
-		pthread_mutex_lock(&mutex_value);
-		if (value < 50) {
-			value++;
-			printf("\nThread One has incremeneted value to: %d", value);
-		}
-		pthread_mutex_unlock(&mutex_value);
-		sleep(0.01);
-	}
-	pthread_exit(0);
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1000000000LL + now.tv_nsec;
 }
 
-void *threadTwo(void *ptr)
+/**
+ * Tells the CPU this is a spin-wait loop (saves power, and lets a hyper-thread sibling run).
+ */
+static inline void _cpuRelax()
 {
-	// pthread_lock_mutex checks if mutex is locked:
-	/// If it is, waits until unlocked.
-	/// If it isnt, locks it and proceeds.
-	// checks value again to ensure we dont increment over 50.
-	// unlocks mutex and sleeps for a random time.
-	// exits when value == 50
-	
-	while (value < 50) {
-		pthread_mutex_lock(&mutex_value);
-		if (value < 50) {
-			value++;
-			printf("\nThread Two has incremeneted value to: %d", value);
-		}
-		pthread_mutex_unlock(&mutex_value);
-		sleep(0.01);
-	}
-	pthread_exit(0);
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__)
+	__asm__ __volatile__("yield");
+#endif
 }
 
-int main(void)
+/**
+ * Histogram bucket of a latency in nanoseconds, and the lowest value in a bucket.
+ */
+static int _bucket(long long ns)
 {
-	// initialize mutex
-	// create threadOne, threadTwo
-	// increment number in mutex from 0 to 50 using threads
-	// when number is 50, done
+	if (ns < 16) {
+		return (ns < 0) ? 0 : (int)ns;
+	}
+	int exponent = 63 - __builtin_clzll((unsigned long long)ns);
+	int bucket = 16 + (exponent - 4) * 8 + (int)((ns >> (exponent - 3)) & 7);
+	return (bucket < HISTOGRAM_BUCKETS) ? bucket : HISTOGRAM_BUCKETS - 1;
+}
 
-	pthread_mutex_init(&mutex_value, NULL);
+static long long _bucketValue(int bucket)
+{
+	if (bucket < 16) {
+		return bucket;
+	}
+	int exponent = (bucket - 16) / 8 + 4;
+	return (8LL + (bucket - 16) % 8) << (exponent - 3);
+}
 
-	pthread_t threadOne_tid, threadTwo_tid;
-	int count = 1;
-	pthread_create(&threadOne_tid, NULL, threadOne, NULL);
-	pthread_create(&threadTwo_tid, NULL, threadTwo, NULL);
+/**
+ * Test-and-test-and-set spinlock: waits on a plain load, so waiting threads do not keep stealing
+ * the cache line from the owner.
+ */
+static inline void _spinLock(atomic_bool *lock)
+{
+	while (atomic_exchange_explicit(lock, true, memory_order_acquire)) {
+		while (atomic_load_explicit(lock, memory_order_relaxed)) {
+			_cpuRelax();
+		}
+	}
+}
 
-	pthread_join(threadOne_tid, NULL);
-	pthread_join(threadTwo_tid, NULL);
+static inline void _spinUnlock(atomic_bool *lock)
+{
+	atomic_store_explicit(lock, false, memory_order_release);
+}
 
-	if (value == 50) {
-		printf("\nThe threads have successfully incremented the value to 50.\n");
+static inline void _ticketLock(struct TicketLock *lock)
+{
+	unsigned ticket = atomic_fetch_add_explicit(&lock->next, 1, memory_order_relaxed);
+	while (atomic_load_explicit(&lock->serving, memory_order_acquire) != ticket) {
+		_cpuRelax();
+	}
+}
+
+static inline void _ticketUnlock(struct TicketLock *lock)
+{
+	unsigned next = atomic_load_explicit(&lock->serving, memory_order_relaxed) + 1;
+	atomic_store_explicit(&lock->serving, next, memory_order_release);
+}
+
+/**
+ * One increment of the shared counter, protected the way the current run asks for.
+ */
+static inline void _increment(int index)
+{
+	switch (lock_type) {
+		case LOCK_MUTEX:
+			pthread_mutex_lock(&counter.mutex);
+			counter.value++;
+			pthread_mutex_unlock(&counter.mutex);
+			break;
+		case LOCK_SPIN:
+			_spinLock(&counter.spin);
+			counter.value++;
+			_spinUnlock(&counter.spin);
+			break;
+		case LOCK_TICKET:
+			_ticketLock(&counter.ticket);
+			counter.value++;
+			_ticketUnlock(&counter.ticket);
+			break;
+		case LOCK_ATOMIC:
+			atomic_fetch_add_explicit(&counter.atomic_value, 1, memory_order_relaxed);
+			break;
+		default:
+			// Only this thread writes its shard, a relaxed load and store is enough.
+			atomic_store_explicit(&shards[index].value,
+					      atomic_load_explicit(&shards[index].value, memory_order_relaxed) + 1,
+					      memory_order_relaxed);
+			break;
+	}
+}
+
+/**
+ * Pins the calling thread according to pin_mode.
+ */
+static void _pin(int index)
+{
+#ifdef __linux__
+	if (pin_mode == PIN_NONE) {
+		return;
+	}
+	int cpu = (pin_mode == PIN_COMPACT) ? index % num_cpus : (int)((long long)index * num_cpus / num_threads);
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+void *workerThread(void *ptr)
+{
+	// Pin, wait for every thread, then increment until told to stop.
+	// Every LATENCY_SAMPLE-th increment is timed on its own.
+	struct Worker *worker = ptr;
+	long long ops = 0;
+	volatile int sink = 0;
+
+	_pin(worker->index);
+	atomic_fetch_add_explicit(&num_ready, 1, memory_order_release);
+	while (!atomic_load_explicit(&go, memory_order_acquire)) {
+		sched_yield();
+	}
+
+	while (!atomic_load_explicit(&stop, memory_order_relaxed)) {
+		if (ops % LATENCY_SAMPLE == 0) {
+			long long start = _now();
+			_increment(worker->index);
+			worker->histogram[_bucket(_now() - start)]++;
+		}
+		else {
+			_increment(worker->index);
+		}
+		ops++;
+		for (int i = 0; i < work; i++) {
+			sink = sink + i;
+		}
+	}
+	worker->ops = ops;
+	return NULL;
+}
+
+/**
+ * Latency at a percentile (0-100) of a histogram, in nanoseconds.
+ */
+static long long _percentile(const long long *histogram, long long samples, double percent)
+{
+	long long rank = (long long)(samples * percent / 100.0);
+	long long seen = 0;
+	for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+		seen += histogram[i];
+		if (seen > rank) {
+			return _bucketValue(i);
+		}
+	}
+	return _bucketValue(HISTOGRAM_BUCKETS - 1);
+}
+
+/**
+ * Runs one lock type with a number of threads and prints one result line.
+ *
+ * @return bool False if a thread could not be created or the counter does not match the number of increments.
+ */
+static bool _run(enum LockType type, int threads, double seconds, bool csv)
+{
+	struct Worker *workers = aligned_alloc(CACHE_LINE, threads * sizeof(struct Worker));
+	if (workers == NULL) {
+		return false;
+	}
+	memset(workers, 0, threads * sizeof(struct Worker));
+	memset(shards, 0, sizeof(shards));
+	counter.value = 0;
+	atomic_store(&counter.atomic_value, 0);
+	atomic_store(&stop, false);
+	atomic_store(&num_ready, 0);
+	atomic_store(&go, false);
+	lock_type = type;
+	num_threads = threads;
+
+	// A start flag rather than a barrier, so a run whose threads could not all be created can be abandoned.
+	int started = 0;
+	for (; started < threads; started++) {
+		workers[started].index = started;
+		int error = pthread_create(&workers[started].tid, NULL, workerThread, &workers[started]);
+		if (error != 0) {
+			fprintf(stderr, "%s: could not create thread %d of %d: %s ! ! !\n", lock_names[type], started + 1, threads, strerror(error));
+			break;
+		}
+	}
+	if (started < threads) {
+		atomic_store(&stop, true);
+		atomic_store(&go, true);
+		for (int i = 0; i < started; i++) {
+			pthread_join(workers[i].tid, NULL);
+		}
+		free(workers);
+		return false;
+	}
+	while (atomic_load(&num_ready) < threads) {
+		sched_yield();
+	}
+	atomic_store(&go, true);
+	long long start = _now();
+	usleep((useconds_t)(seconds * 1e6));
+	atomic_store(&stop, true);
+
+	long long histogram[HISTOGRAM_BUCKETS] = { 0 };
+	long long total = 0, samples = 0;
+	double sum_squares = 0;
+	for (int i = 0; i < threads; i++) {
+		pthread_join(workers[i].tid, NULL);
+		total += workers[i].ops;
+		sum_squares += (double)workers[i].ops * workers[i].ops;
+		for (int b = 0; b < HISTOGRAM_BUCKETS; b++) {
+			histogram[b] += workers[i].histogram[b];
+			samples += workers[i].histogram[b];
+		}
+	}
+	double elapsed = (_now() - start) / 1e9;
+
+	long long value;
+	switch (type) {
+		case LOCK_ATOMIC:
+			value = atomic_load(&counter.atomic_value);
+			break;
+		case LOCK_SHARD:
+			value = 0;
+			for (int i = 0; i < threads; i++) {
+				value += atomic_load(&shards[i].value);
+			}
+			break;
+		default:
+			value = counter.value;
+			break;
+	}
+
+	// Jain's fairness index: (sum x)^2 / (n * sum x^2).
+	double fairness = (sum_squares > 0) ? ((double)total * total) / (threads * sum_squares) : 1.0;
+	long long p50 = _percentile(histogram, samples, 50);
+	long long p99 = _percentile(histogram, samples, 99);
+	long long p999 = _percentile(histogram, samples, 99.9);
+	long long max = 0;
+	for (int b = HISTOGRAM_BUCKETS - 1; b >= 0; b--) {
+		if (histogram[b] > 0) {
+			max = _bucketValue(b);
+			break;
+		}
+	}
+
+	if (csv) {
+		printf("%s,%d,%.0f,%.4f,%lld,%lld,%lld,%lld\n", lock_names[type], threads, total / elapsed, fairness, p50, p99, p999, max);
+	}
+	else {
+		printf("%-7s %7d %14.0f %9.4f %9lld %9lld %9lld %10lld\n", lock_names[type], threads, total / elapsed, fairness, p50, p99, p999, max);
+	}
+	fflush(stdout);
+	free(workers);
+
+	if (value != total) {
+		fprintf(stderr, "%s: counter is %lld after %lld increments ! ! !\n", lock_names[type], value, total);
+		return false;
+	}
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	// Read the options, then run every lock type with 1, 2, 4, ... threads.
+	num_cpus = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	int max_threads = num_cpus;
+	double seconds = 1.0;
+	bool csv = false;
+	bool selected[NUM_LOCK_TYPES] = { true, true, true, true, true };
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-t") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+			max_threads = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc && atof(argv[i + 1]) > 0) {
+			seconds = atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc && atoi(argv[i + 1]) >= 0) {
+			work = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+			i++;
+			if (strcmp(argv[i], "none") == 0) {
+				pin_mode = PIN_NONE;
+			}
+			else if (strcmp(argv[i], "compact") == 0) {
+				pin_mode = PIN_COMPACT;
+			}
+			else if (strcmp(argv[i], "spread") == 0) {
+				pin_mode = PIN_SPREAD;
+			}
+			else {
+				fprintf(stderr, "Unknown pinning mode: %s\n", argv[i]);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+			// Comma-separated list of lock types.
+			memset(selected, 0, sizeof(selected));
+			char *list = argv[++i];
+			for (char *name = strtok(list, ","); name != NULL; name = strtok(NULL, ",")) {
+				int type = 0;
+				while (type < NUM_LOCK_TYPES && strcmp(name, lock_names[type]) != 0) {
+					type++;
+				}
+				if (type == NUM_LOCK_TYPES) {
+					fprintf(stderr, "Unknown lock type: %s\n", name);
+					return 1;
+				}
+				selected[type] = true;
+			}
+		}
+		else if (strcmp(argv[i], "-c") == 0) {
+			csv = true;
+		}
+		else {
+			fprintf(stderr, "Usage: %s [-t max threads] [-s seconds per run] [-w work between increments] [-p none|compact|spread] [-l mutex,spin,ticket,atomic,shard] [-c]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (max_threads > MAX_THREADS) {
+		max_threads = MAX_THREADS;
+	}
+
+	pthread_mutex_init(&counter.mutex, NULL);
+	if (csv) {
+		printf("lock,threads,ops_per_sec,fairness,p50_ns,p99_ns,p999_ns,max_ns\n");
 	}
 	else {
-		printf("\nThe threads failed to increment the value to 50.\nInstead the value is: %d\n", value);
+		printf("%d CPUs, %.1f s per run, work %d, latency sampled every %d ops\n", num_cpus, seconds, work, LATENCY_SAMPLE);
+		printf("%-7s %7s %14s %9s %9s %9s %9s %10s\n", "lock", "threads", "ops/s", "fairness", "p50 ns", "p99 ns", "p99.9 ns", "max ns");
 	}
 
-	return 0;
-}
\ No newline at end of file
+	bool correct = true;
+	for (int type = 0; type < NUM_LOCK_TYPES; type++) {
+		if (!selected[type]) {
+			continue;
+		}
+		for (int threads = 1; threads <= max_threads; threads = (threads * 2 > max_threads && threads < max_threads) ? max_threads : threads * 2) {
+			correct = _run(type, threads, seconds, csv) && correct;
+		}
+	}
+	pthread_mutex_destroy(&counter.mutex);
+
+	return correct ? 0 : 1;
+}
@@ -0,0 +1,717 @@
+/**
+ * Batch command stream implementation file.
+ * Input is read in large blocks and tokenized in place, output is collected in a buffer and
+ * written in large blocks, so neither scanf nor per-line printf sits on the hot path.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#include "batch.h"
+#include "journal.h"
+#include "manager.h"
+#include "output.h"
+#include "schedule.h"
+#include "snapshot.h"
+#include "timeline.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BATCH_INPUT_SIZE (1 << 20)      // Input block size, also the longest accepted line.
+#define BATCH_OUTPUT_SIZE (1 << 16)     // Output buffer size.
+
+/* Global Variables */
+static char input_buffer[BATCH_INPUT_SIZE];
+static char output_buffer[BATCH_OUTPUT_SIZE];
+static size_t output_length = 0;
+static struct Timeline timeline;        // Slices of the last simulate command (zeroed == empty, see timeline_init).
+static bool timeline_valid = false;     // True once a simulate command has filled the timeline.
+static struct ScheduleSection *sections = NULL; // Critical sections set by lock commands, for algorithm 10.
+static uint32_t num_sections = 0;
+static uint32_t section_capacity = 0;
+
+/**
+ * Writes out (or queues, see output.h) and empties the output buffer.
+ */
+static void _batchFlush() {
+    output_write(output_buffer, output_length);
+    output_length = 0;
+}
+
+/**
+ * Appends a string to the output buffer.
+ */
+static void _batchText(const char *str) {
+    size_t length = strlen(str);
+    if (output_length + length > BATCH_OUTPUT_SIZE) {
+        _batchFlush();
+    }
+    memcpy(output_buffer + output_length, str, length);
+    output_length += length;
+}
+
+/**
+ * Appends a space followed by a decimal integer to the output buffer.
+ */
+static void _batchInt(long long value) {
+    char digits[24];
+    int num_digits = 0;
+    unsigned long long magnitude = (value < 0) ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+
+    do {
+        digits[num_digits++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    if (output_length + num_digits + 2 > BATCH_OUTPUT_SIZE) {
+        _batchFlush();
+    }
+    output_buffer[output_length++] = ' ';
+    if (value < 0) {
+        output_buffer[output_length++] = '-';
+    }
+    while (num_digits > 0) {
+        output_buffer[output_length++] = digits[--num_digits];
+    }
+}
+
+/**
+ * Skips spaces, tabs, and carriage returns.
+ */
+static char *_batchSkip(char *cursor, char *end) {
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) {
+        cursor++;
+    }
+    return cursor;
+}
+
+/**
+ * Parses one integer argument and advances the cursor past it.
+ *
+ * @return bool False if there is no integer, it does not fit in an int, or it is followed by garbage.
+ */
+static bool _batchParseInt(char **cursor, char *end, int *out) {
+    char *c = _batchSkip(*cursor, end);
+    bool negative = false;
+    long long value = 0;
+
+    if (c < end && (*c == '-' || *c == '+')) {
+        negative = (*c == '-');
+        c++;
+    }
+    char *digits_start = c;
+    while (c < end && *c >= '0' && *c <= '9') {
+        value = value * 10 + (*c - '0');
+        if (value > 2147483648LL) {
+            return false;
+        }
+        c++;
+    }
+    if (c == digits_start || (c < end && *c != ' ' && *c != '\t' && *c != '\r')) {
+        return false;
+    }
+
+    value = negative ? -value : value;
+    if (value > 2147483647LL) {
+        return false;
+    }
+    *out = (int)value;
+    *cursor = c;
+    return true;
+}
+
+/**
+ * Algorithms as numbered in the process scheduler's menu (1: FCFS, 2: SJF, 3: RR, 4: PRI),
+ * plus 5: PSJF, 6: PSRTF, 7: lottery, 8: stride, 9: adaptive round robin, and 10: preemptive
+ * priority with locks (simulate only, compare takes one digit per algorithm).
+ */
+static const enum SchedulePolicy batch_policies[] = {
+    SCHED_FCFS, SCHED_SJF, SCHED_RR, SCHED_PRI, SCHED_PSJF, SCHED_PSRTF, SCHED_LOTTERY, SCHED_STRIDE, SCHED_ADAPTIVE_RR,
+    SCHED_PPRI
+};
+#define BATCH_NUM_POLICIES (int)(sizeof(batch_policies) / sizeof(batch_policies[0]))
+
+/**
+ * Reads the optional settings of simulate and compare, which follow the algorithm: quantum, alpha in
+ * percent, first estimate, fairness window, lottery seed, burst percentile, and lock protocol
+ * (0: none, 1: inheritance, 2: ceiling). The critical sections are the ones set by lock commands.
+ */
+static struct ScheduleParams _batchParams(const int *args, int num_args) {
+    struct ScheduleParams params = {
+        (num_args > 1) ? args[1] : SCHEDULE_DEFAULT_QUANTUM,
+        (num_args > 2) ? args[2] / 100.0 : SCHEDULE_DEFAULT_ALPHA,
+        (num_args > 3) ? args[3] : SCHEDULE_DEFAULT_ESTIMATE,
+        (num_args > 4) ? args[4] : SCHEDULE_DEFAULT_WINDOW,
+        (num_args > 5) ? (uint64_t)(uint32_t)args[5] : SCHEDULE_DEFAULT_SEED,
+        (num_args > 6) ? args[6] : SCHEDULE_DEFAULT_PERCENTILE,
+        (num_args > 7) ? (enum ScheduleLockProtocol)args[7] : SCHED_LOCK_NONE,
+        sections, num_sections
+    };
+    return params;
+}
+
+/**
+ * @return bool True if every setting is in range, whichever algorithms use them.
+ */
+static bool _batchParamsValid(const struct ScheduleParams *params) {
+    return params->quantum > 0 && params->alpha >= 0 && params->alpha <= 1 && params->estimate > 0 && params->window > 0 &&
+           params->percentile >= 1 && params->percentile <= 100 &&
+           (params->protocol == SCHED_LOCK_NONE || params->protocol == SCHED_LOCK_INHERIT || params->protocol == SCHED_LOCK_CEILING);
+}
+
+/**
+ * Prints one "s" line of statistics, with the total prediction error for the predictive algorithms,
+ * the share errors in parts per million for the proportional-share ones, the quantum's changes and
+ * range and the dispatches for adaptive round robin, and the total blocked and inversion times, the
+ * worst inversion, and the number of blocks for preemptive priority with locks.
+ */
+static void _batchStats(int algorithm, const struct ScheduleStats *stats) {
+    _batchText("s");
+    _batchInt(algorithm);
+    _batchInt(stats->count);
+    _batchInt(stats->total_turnaround);
+    _batchInt(stats->total_wait);
+    _batchInt(stats->finish_time);
+    if (batch_policies[algorithm - 1] == SCHED_PSJF || batch_policies[algorithm - 1] == SCHED_PSRTF) {
+        _batchInt(stats->total_error);
+    }
+    if (batch_policies[algorithm - 1] == SCHED_LOTTERY || batch_policies[algorithm - 1] == SCHED_STRIDE) {
+        _batchInt((long long)(stats->share_error * 1e6 + 0.5));
+        _batchInt((long long)(stats->window_error * 1e6 + 0.5));
+        _batchInt((long long)(stats->max_window_error * 1e6 + 0.5));
+    }
+    if (batch_policies[algorithm - 1] == SCHED_ADAPTIVE_RR) {
+        _batchInt(stats->quantum_changes);
+        _batchInt(stats->min_quantum);
+        _batchInt(stats->max_quantum);
+        _batchInt(stats->last_quantum);
+        _batchInt(stats->dispatches);
+    }
+    if (batch_policies[algorithm - 1] == SCHED_PPRI) {
+        _batchInt(stats->total_blocked);
+        _batchInt(stats->total_inversion);
+        _batchInt(stats->max_inversion);
+        _batchInt(stats->blocks);
+    }
+    _batchText("\n");
+}
+
+/**
+ * Short machine-readable reason for a failed operation.
+ */
+static const char *_batchReason(enum ManagerResult result) {
+    switch (result) {
+        case PM_ERR_ID_NEGATIVE:    return " negative_id\n";
+        case PM_ERR_ID_LIMIT:       return " id_limit\n";
+        case PM_ERR_EXISTS:         return " exists\n";
+        case PM_ERR_TIMES:          return " bad_time\n";
+        case PM_ERR_FULL:           return " full\n";
+        case PM_ERR_NOT_FOUND:      return " not_found\n";
+        case PM_ERR_SCHEDULE:       return " bad_schedule\n";
+        case PM_ERR_NONE_READY:     return " none_ready\n";
+        default:                    return " unknown\n";
+    }
+}
+
+/**
+ * Prints one "p" line for a process.
+ */
+static void _batchProcess(const struct Process *process) {
+    _batchText("p");
+    _batchInt(process->id);
+    _batchInt(process->state);
+    _batchInt(process->priority);
+    _batchInt(process->start_time);
+    _batchInt(process->work_time);
+    _batchText("\n");
+}
+
+/**
+ * Prints every process, or only the processes in one state (walking that state's list), followed by the count.
+ *
+ * @param state State to list, or PT_NUM_STATES to list every process.
+ */
+static void _batchList(struct ProcessTable *table, int state) {
+    uint32_t count;
+    if (state == PT_NUM_STATES) {
+        for (ProcessHandle h = pt_first(table); h != PT_NULL_HANDLE; h = pt_next(table, h)) {
+            _batchProcess(pt_get(table, h));
+        }
+        count = table->count;
+    }
+    else {
+        for (ProcessHandle h = pt_state_first(table, state); h != PT_NULL_HANDLE; h = pt_state_next(table, h)) {
+            _batchProcess(pt_get(table, h));
+        }
+        count = pt_state_count(table, state);
+    }
+    _batchText("ok list");
+    _batchInt(count);
+    _batchText("\n");
+}
+
+/**
+ * Prints one "r" line for a slice of the timeline.
+ */
+static void _batchSlice(long long start, long long length, void *context) {
+    (void)context;
+    _batchText("r");
+    _batchInt(start);
+    _batchInt(length);
+    _batchText("\n");
+}
+
+/**
+ * Dispatch hook of adaptive round robin: prints a "q" line whenever the quantum changes.
+ *
+ * @param context Last quantum printed, 0 before the first dispatch.
+ */
+static void _batchQuantum(const struct ScheduleEvent *event, void *context) {
+    int *last = context;
+    if (event->quantum != *last) {
+        *last = event->quantum;
+        _batchText("q");
+        _batchInt(event->time);
+        _batchInt(event->quantum);
+        _batchText("\n");
+    }
+}
+
+/**
+ * Complete hook of preemptive priority with locks: prints a "b" line for every process that was blocked
+ * on a lock or kept waiting by a lower-priority process.
+ */
+static void _batchBlocked(const struct ScheduleEvent *event, void *context) {
+    (void)context;
+    if (event->blocked > 0 || event->inversion > 0) {
+        _batchText("b");
+        _batchInt(event->process->id);
+        _batchInt(event->blocked);
+        _batchInt(event->inversion);
+        _batchText("\n");
+    }
+}
+
+/**
+ * Adds a critical section, or removes every section of a process (all of them for -1).
+ *
+ * @return const char* NULL on success, else the error reason.
+ */
+static const char *_batchLock(const int *args, int num_args) {
+    if (num_args == 1) {
+        uint32_t kept = 0;
+        for (uint32_t i = 0; i < num_sections; i++) {
+            if (args[0] != -1 && sections[i].id != args[0]) {
+                sections[kept++] = sections[i];
+            }
+        }
+        num_sections = kept;
+        return NULL;
+    }
+    if (num_args != 4 || args[2] < 0 || args[3] <= 0) {
+        return " bad_section\n";
+    }
+    if (num_sections == section_capacity) {
+        uint32_t capacity = (section_capacity > 0) ? 2 * section_capacity : 64;
+        struct ScheduleSection *grown = realloc(sections, (size_t)capacity * sizeof(struct ScheduleSection));
+        if (grown == NULL) {
+            return " no_memory\n";
+        }
+        sections = grown;
+        section_capacity = capacity;
+    }
+    struct ScheduleSection section = { args[0], args[1], args[2], args[3] };
+    sections[num_sections++] = section;
+    return NULL;
+}
+
+/**
+ * Batch commands, in the same order as batch_commands.
+ */
+enum BatchCommandType {
+    BATCH_CREATE,
+    BATCH_SCHEDULE,
+    BATCH_TERMINATE,
+    BATCH_LIST,
+    BATCH_DISPATCH,
+    BATCH_PRIORITY,
+    BATCH_SNAPSHOT,
+    BATCH_PURGE,
+    BATCH_UNBLOCK,
+    BATCH_SIMULATE,
+    BATCH_AT,
+    BATCH_BUSY,
+    BATCH_SLICES,
+    BATCH_COMPARE,
+    BATCH_LOCK,
+    BATCH_NUM_COMMANDS
+};
+
+struct BatchCommand {
+    const char *name;
+    const char *alias;  // Short form, NULL if none.
+    int num_args;       // Required arguments.
+    int max_args;       // Required plus optional arguments.
+};
+
+static const struct BatchCommand batch_commands[BATCH_NUM_COMMANDS] = {
+    { "create",     "c",    4,  5 },    // Optional task.
+    { "schedule",   "s",    3,  3 },
+    { "terminate",  "t",    1,  1 },
+    { "list",       "l",    0,  1 },    // Optional state to list.
+    { "dispatch",   "d",    0,  0 },
+    { "priority",   "p",    2,  2 },
+    { "snapshot",   NULL,   0,  0 },
+    { "purge",      NULL,   1,  5 },    // Optional priority and start time bounds.
+    { "unblock",    "u",    0,  0 },
+    { "simulate",   NULL,   1,  8 },    // Optional quantum, alpha (percent), first estimate, window, seed, percentile, and lock protocol.
+    { "at",         NULL,   1,  1 },
+    { "busy",       NULL,   2,  2 },
+    { "slices",     NULL,   1,  1 },
+    { "compare",    NULL,   1,  8 },    // Algorithm digits (e.g. 1234), optional settings as for simulate.
+    { "lock",       NULL,   1,  4 }     // Lock, offset, and length, or none to remove the process's sections.
+};
+
+/**
+ * Looks up a command word by its name or alias.
+ *
+ * @return int Index into batch_commands, BATCH_NUM_COMMANDS if unknown.
+ */
+static int _batchFindCommand(const char *word, size_t length) {
+    for (int i = 0; i < BATCH_NUM_COMMANDS; i++) {
+        const struct BatchCommand *command = &batch_commands[i];
+        if ((length == strlen(command->name) && memcmp(word, command->name, length) == 0) ||
+            (command->alias != NULL && length == strlen(command->alias) && memcmp(word, command->alias, length) == 0)) {
+            return i;
+        }
+    }
+    return BATCH_NUM_COMMANDS;
+}
+
+/**
+ * Prints an error line for a failed command.
+ */
+static void _batchError(long long line_number, const char *command, const char *reason) {
+    _batchText("err");
+    _batchInt(line_number);
+    _batchText(" ");
+    _batchText(command);
+    _batchText(reason);
+}
+
+/**
+ * Answers a timeline query (at, busy, or slices) about the last simulate command.
+ * Prints its own "ok" line, even when quiet, like list.
+ *
+ * @return int 1 if the query failed, 0 otherwise.
+ */
+static int _batchTimeline(int type, const int *args, long long line_number, const char *name) {
+    if (!timeline_valid) {
+        _batchError(line_number, name, " no_timeline\n");
+        return 1;
+    }
+    long long value;
+    if (type == BATCH_AT) {
+        int id;
+        if (!timeline_at(&timeline, args[0], &id)) {
+            _batchError(line_number, name, " idle\n");
+            return 1;
+        }
+        value = id;
+    }
+    else if (type == BATCH_BUSY) {
+        if (args[1] < args[0]) {
+            _batchError(line_number, name, " bad_range\n");
+            return 1;
+        }
+        value = timeline_busy(&timeline, args[0], args[1]);
+    }
+    else {
+        value = timeline_slices(&timeline, args[0], _batchSlice, NULL);
+    }
+    _batchText("ok ");
+    _batchText(name);
+    _batchInt(value);
+    _batchText("\n");
+    return 0;
+}
+
+/**
+ * Executes a single command line.
+ *
+ * @return int 1 if the command failed, 0 if it succeeded or the line was blank.
+ */
+static int _batchLine(struct ProcessTable *table, char *line, char *end, long long line_number, const struct BatchOptions *options) {
+    char *cursor = _batchSkip(line, end);
+    if (cursor == end || *cursor == '#') {
+        return 0;
+    }
+
+    char *word = cursor;
+    while (cursor < end && *cursor >= 'a' && *cursor <= 'z') {
+        cursor++;
+    }
+    int type = _batchFindCommand(word, cursor - word);
+    if (type == BATCH_NUM_COMMANDS) {
+        _batchError(line_number, "?", " unknown_command\n");
+        return 1;
+    }
+    const struct BatchCommand *command = &batch_commands[type];
+
+    // Parse the required arguments, then any optional arguments that are present.
+    int args[8];
+    int num_args = 0;
+    bool parsed = (cursor == end || *cursor == ' ' || *cursor == '\t' || *cursor == '\r');
+    while (parsed && num_args < command->max_args &&
+           (num_args < command->num_args || _batchSkip(cursor, end) != end)) {
+        parsed = _batchParseInt(&cursor, end, &args[num_args]);
+        num_args++;
+    }
+    if (!parsed || _batchSkip(cursor, end) != end) {
+        _batchError(line_number, command->name, " parse\n");
+        return 1;
+    }
+
+    enum ManagerResult result = PM_OK;
+    switch (type) {
+        case BATCH_CREATE:
+            result = pm_create(table, args[0], args[1], args[2], args[3]);
+            if (result == PM_OK && num_args > 4) {
+                pm_set_task(table, args[0], args[4]);
+            }
+            break;
+        case BATCH_SCHEDULE:
+            result = pm_schedule(table, args[0], args[1], args[2]);
+            break;
+        case BATCH_TERMINATE:
+            result = pm_terminate(table, args[0]);
+            break;
+        case BATCH_LIST:
+            if (num_args == 1 && (args[0] < -1 || args[0] > 1)) {
+                _batchError(line_number, command->name, " bad_state\n");
+                return 1;
+            }
+            _batchList(table, (num_args == 1) ? args[0] : PT_NUM_STATES);
+            return 0;
+        case BATCH_DISPATCH:
+            result = pm_dispatch(table, &args[0]);
+            break;
+        case BATCH_PRIORITY:
+            result = pm_set_priority(table, args[0], args[1]);
+            break;
+        case BATCH_SNAPSHOT:
+            if (options->snapshot_path == NULL) {
+                _batchError(line_number, command->name, " no_snapshot_file\n");
+                return 1;
+            }
+            if (!snapshot_save(table, options->snapshot_path, journal_lsn())) {
+                _batchError(line_number, command->name, " busy\n");
+                return 1;
+            }
+            args[0] = (int)table->count;
+            break;
+        case BATCH_PURGE: {
+            if ((args[0] < -1 || args[0] > 1) && args[0] != PT_ANY_STATE) {
+                _batchError(line_number, command->name, " bad_state\n");
+                return 1;
+            }
+            // Bounds that are left out do not limit the match.
+            struct ProcessFilter filter = {
+                args[0],
+                (num_args > 1) ? args[1] : INT_MIN, (num_args > 2) ? args[2] : INT_MAX,
+                (num_args > 3) ? args[3] : INT_MIN, (num_args > 4) ? args[4] : INT_MAX
+            };
+            uint32_t count;
+            result = pm_terminate_where(table, &filter, &count);
+            if (result == PM_OK && count > 0) {
+                journal_append(JOURNAL_TERMINATE_WHERE, filter.state, filter.priority_min, filter.priority_max,
+                               filter.start_min, filter.start_max);
+            }
+            args[0] = (int)count;
+            break;
+        }
+        case BATCH_SIMULATE: {
+            struct ScheduleParams params = _batchParams(args, num_args);
+            if (args[0] < 1 || args[0] > BATCH_NUM_POLICIES) {
+                _batchError(line_number, command->name, " bad_algorithm\n");
+                return 1;
+            }
+            if (!_batchParamsValid(&params)) {
+                _batchError(line_number, command->name, " bad_setting\n");
+                return 1;
+            }
+            int last_quantum = 0;
+            struct ScheduleHooks adaptive = { _batchQuantum, NULL, NULL, &last_quantum };
+            struct ScheduleHooks locked = { NULL, NULL, _batchBlocked, NULL };
+            const struct ScheduleHooks *hooks = NULL;
+            if (batch_policies[args[0] - 1] == SCHED_ADAPTIVE_RR) {
+                hooks = &adaptive;
+            }
+            else if (batch_policies[args[0] - 1] == SCHED_PPRI) {
+                hooks = &locked;
+            }
+            struct ScheduleStats stats;
+            timeline_valid = schedule_run(table, batch_policies[args[0] - 1], &params, hooks, &timeline, &stats);
+            if (!timeline_valid) {
+                _batchError(line_number, command->name, " no_memory\n");
+                return 1;
+            }
+            _batchStats(args[0], &stats);
+            args[0] = (int)stats.count;
+            break;
+        }
+        case BATCH_COMPARE: {
+            enum SchedulePolicy selected[SCHEDULE_MAX_COMPARE];
+            int algorithms[SCHEDULE_MAX_COMPARE];
+            struct ScheduleParams params[SCHEDULE_MAX_COMPARE];
+            struct ScheduleParams shared = _batchParams(args, num_args);
+            int count = 0;
+            // Digits from the left, e.g. 1234 runs all four in that order.
+            for (int digits = args[0]; digits > 0 && count < SCHEDULE_MAX_COMPARE; digits /= 10) {
+                algorithms[count++] = digits % 10;
+            }
+            bool valid = (args[0] > 0);
+            for (int i = 0; i < count && valid; i++) {
+                int algorithm = algorithms[count - 1 - i];
+                valid = (algorithm >= 1 && algorithm <= BATCH_NUM_POLICIES);
+                selected[i] = valid ? batch_policies[algorithm - 1] : SCHED_FCFS;
+                params[i] = shared;
+            }
+            if (!valid) {
+                _batchError(line_number, command->name, " bad_algorithm\n");
+                return 1;
+            }
+            if (!_batchParamsValid(&shared)) {
+                _batchError(line_number, command->name, " bad_setting\n");
+                return 1;
+            }
+            struct ScheduleStats stats[SCHEDULE_MAX_COMPARE];
+            if (!schedule_compare(table, selected, params, count, stats)) {
+                _batchError(line_number, command->name, " no_memory\n");
+                return 1;
+            }
+            for (int i = 0; i < count; i++) {
+                _batchStats(algorithms[count - 1 - i], &stats[i]);
+            }
+            args[0] = count;
+            break;
+        }
+        case BATCH_AT:
+        case BATCH_BUSY:
+        case BATCH_SLICES:
+            return _batchTimeline(type, args, line_number, command->name);
+        case BATCH_LOCK: {
+            const char *reason = _batchLock(args, num_args);
+            if (reason != NULL) {
+                _batchError(line_number, command->name, reason);
+                return 1;
+            }
+            args[0] = (int)num_sections;
+            break;
+        }
+        case BATCH_UNBLOCK: {
+            uint32_t count;
+            result = pm_unblock_all(table, &count);
+            if (count > 0) {
+                journal_append(JOURNAL_UNBLOCK_ALL, 0, 0, 0, 0, 0);
+            }
+            args[0] = (int)count;
+            break;
+        }
+    }
+
+    if (result != PM_OK) {
+        _batchError(line_number, command->name, _batchReason(result));
+        return 1;
+    }
+    switch (type) {
+        case BATCH_CREATE:
+            journal_append(JOURNAL_CREATE, args[0], args[1], args[2], args[3], (num_args > 4) ? args[4] : 0);
+            break;
+        case BATCH_SCHEDULE:
+            journal_append(JOURNAL_SCHEDULE, args[0], args[1], args[2], 0, 0);
+            break;
+        case BATCH_TERMINATE:
+            journal_append(JOURNAL_TERMINATE, args[0], 0, 0, 0, 0);
+            break;
+        case BATCH_DISPATCH:
+            journal_append(JOURNAL_DISPATCH, args[0], 0, 0, 0, 0);
+            break;
+        case BATCH_PRIORITY:
+            journal_append(JOURNAL_PRIORITY, args[0], args[1], 0, 0, 0);
+            break;
+    }
+    if (!options->quiet) {
+        _batchText("ok ");
+        _batchText(command->name);
+        _batchInt(args[0]);
+        _batchText("\n");
+    }
+    return 0;
+}
+
+int runBatch(struct ProcessTable *table, FILE *input, const struct BatchOptions *options) {
+    struct timespec start, finish;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    long long line_number = 0;
+    int num_errors = 0;
+    size_t length = 0;      // Bytes of the current block still to be processed.
+    bool eof = false;
+    bool discarding = false;    // Dropping the rest of a line that was too long.
+
+    while (!eof) {
+        size_t num_read = fread(input_buffer + length, 1, BATCH_INPUT_SIZE - length, input);
+        eof = (num_read == 0);
+        length += num_read;
+
+        // Finish dropping a line that was too long, up to and including its newline.
+        char *cursor = input_buffer;
+        char *end = input_buffer + length;
+        if (discarding) {
+            char *newline = memchr(cursor, '\n', end - cursor);
+            discarding = (newline == NULL);
+            cursor = discarding ? end : newline + 1;
+        }
+
+        // Execute every complete line, plus the unterminated last line at end of input.
+        while (cursor < end) {
+            char *newline = memchr(cursor, '\n', end - cursor);
+            if (newline == NULL) {
+                if (!eof) {
+                    break;
+                }
+                newline = end;
+            }
+            line_number++;
+            num_errors += _batchLine(table, cursor, newline, line_number, options);
+            cursor = (newline < end) ? newline + 1 : end;
+        }
+
+        // Keep the partial line for the next block, or drop the whole line if it fills the buffer.
+        length = end - cursor;
+        if (length == BATCH_INPUT_SIZE) {
+            line_number++;
+            num_errors++;
+            _batchText("err");
+            _batchInt(line_number);
+            _batchText(" ? line_too_long\n");
+            length = 0;
+            discarding = true;
+        }
+        memmove(input_buffer, cursor, length);
+    }
+    _batchFlush();
+    output_flush();
+    timeline_destroy(&timeline);
+    timeline_valid = false;
+
+    clock_gettime(CLOCK_MONOTONIC, &finish);
+    double seconds = (finish.tv_sec - start.tv_sec) + (finish.tv_nsec - start.tv_nsec) / 1e9;
+    fprintf(stderr, "batch: %lld lines, %d errors, %.3f s, %.0f lines/s\n",
+            line_number, num_errors, seconds, (seconds > 0) ? line_number / seconds : 0.0);
+    return num_errors;
+}
@@ -0,0 +1,96 @@
+/**
+ * Batch command stream header file.
+ * Drives the process manager from a stream of commands instead of the interactive menu.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "process_table.h"
+#include <stdbool.h>
+#include <stdio.h>
+
+struct BatchOptions {
+    bool quiet;                 // Leave out "ok" lines, only print errors and list output.
+    const char *snapshot_path;  // File written by the snapshot command, NULL if snapshots are off.
+};
+
+/**
+ * Executes a command stream against a process table, one command per line:
+ *   create <id> <priority> <start time> <work time> [task]
+ *   schedule <id> <current state> <next state>
+ *   terminate <id>
+ *   list [state]
+ *   dispatch
+ *   priority <id> <priority>
+ *   snapshot
+ *   purge <state> [<min priority> [<max priority> [<min start> [<max start>]]]]
+ *   unblock
+ *   simulate <algorithm> [<quantum> [<alpha %> [<estimate> [<window> [<seed> [<percentile> [<protocol>]]]]]]]
+ *   at <time>
+ *   busy <from> <to>
+ *   slices <id>
+ *   compare <algorithms> [<quantum> [<alpha %> [<estimate> [<window> [<seed> [<percentile> [<protocol>]]]]]]]
+ *   lock <id> [<lock> <offset> <length>]
+ * Purge terminates every process in a state (2 == any state) whose priority and start time are within the
+ * given bounds, left-out bounds do not limit the match. Unblock moves every Blocked process to Ready.
+ * List prints the processes in the order they were created, or, given a state, in the order they entered it.
+ * Create's task groups processes as the CPU bursts of one task (0, the default, is no task).
+ * Simulate runs a scheduling algorithm (1: FCFS, 2: SJF, 3: RR, 4: PRI, 5: PSJF, 6: PSRTF, 7: lottery,
+ * 8: stride, 9: adaptive RR, 10: preemptive priority with locks) over the whole table in place and stores
+ * each process's finish, turnaround, and waiting time in it (see schedule.h).
+ * The settings after the algorithm are positional, and each is only used by the algorithms it applies to:
+ *   quantum                RR, lottery, and stride (2 by default), and adaptive RR until a burst completes
+ *   alpha %, estimate      PSJF and PSRTF, which predict each burst from the earlier bursts of its task:
+ *                          the weight of the last burst in percent (50) and the first estimate (10)
+ *   window, seed           lottery and stride, which share the CPU in proportion to the priorities as
+ *                          tickets: the window the share errors are measured over (20) and the seed of
+ *                          the lottery draws (1)
+ *   percentile             adaptive RR, which keeps the quantum at this percentile of the recent bursts (80)
+ *   protocol               preemptive priority, which blocks processes on locks held by others: how the
+ *                          holder's priority is raised (0: none, the default, 1: inheritance, 2: ceiling)
+ * An unknown algorithm fails with bad_algorithm, a setting out of range (even one the algorithm does not
+ * use) with bad_setting.
+ * At, busy, and slices query the execution timeline of the last simulate (see timeline.h): which process
+ * ran at a time, how long the CPU was busy in [from, to), and every slice a process ran.
+ * Compare runs several of algorithms 1 to 9, given as digits (e.g. 1234 for the first four), with the same
+ * settings side by side without changing the table, loading and sorting the processes once for all of them
+ * (see schedule_compare).
+ * Lock gives a process a critical section for preemptive priority: it holds the lock (any number) from
+ * offset into its burst for length time units. Lock with only an ID removes that process's sections,
+ * -1 removes all of them.
+ * Commands other than snapshot, purge, simulate, at, busy, slices, compare, and lock may be shortened to
+ * their first letter. Blank lines and lines starting with '#' are ignored.
+ *
+ * Results are written to stdout, one line per command:
+ *   ok <command> <id>                  (ok list <count> for list, after one "p <id> <state> <priority> <start> <work>" per process,
+ *                                       ok purge/unblock <count> with the number of processes affected,
+ *                                       ok simulate <count> after "s <algorithm> <count> <total turnaround> <total wait> <finish time>",
+ *                                       followed by the total prediction error for PSJF and PSRTF, or
+ *                                       the share error over each process's life, on average per window,
+ *                                       and at worst, in parts per million, for lottery and stride, or
+ *                                       the number of quantum changes, the smallest, largest, and last
+ *                                       quantum, and the dispatches for adaptive RR, which also prints
+ *                                       "q <time> <quantum>" at its first dispatch and every change, or
+ *                                       the total blocked and inversion times, the worst inversion, and
+ *                                       the number of blocks for preemptive priority, which also prints
+ *                                       "b <id> <blocked time> <inversion time>" for every process that
+ *                                       waited on a lock or behind a lower priority,
+ *                                       ok at <id>, ok busy <busy time>, ok slices <count> after one "r <start> <length>" per slice,
+ *                                       ok compare <count> after one "s" line per algorithm, as for simulate,
+ *                                       ok lock <count> with the number of sections set)
+ *   err <line> <command> <reason>
+ * A summary (lines, errors, elapsed time, lines per second) is written to stderr.
+ *
+ * @param table Process table to operate on.
+ * @param input Stream to read commands from.
+ * @param options Batch options.
+ * @return int Number of commands that failed.
+ */
+int runBatch(struct ProcessTable *table, FILE *input, const struct BatchOptions *options);
+
+#endif // BATCH_H
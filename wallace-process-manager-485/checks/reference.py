@@ -0,0 +1,625 @@
+#!/usr/bin/env python3
+"""
+Checks the scheduling algorithms of the batch simulate command (see schedule.h) against plain
+reference implementations over random workloads. The references keep no clever data structures
+and step through time a slice or a time unit at a time, so they are slow but easy to follow.
+Also checks that replaying a journal (see journal.h) rebuilds the table the commands left, and that
+a torn record at the end of the journal is dropped.
+
+Usage: python3 checks/reference.py [PRM] [seed]
+"""
+
+import collections
+import heapq
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+MAX_REPORTED = 5    # Mismatches printed per check, the rest are only counted.
+MASK64 = (1 << 64) - 1
+JOURNAL_RECORD_SIZE = 40
+ADAPT_GROWTH = 1 + 1 / 128     # Weight of each completed burst over the one before it.
+
+
+def run_batch(prm, lines, options=()):
+    """Runs batch commands through the process manager and returns its output lines."""
+    result = subprocess.run([prm, "--batch", "--quiet", *options], input="\n".join(lines) + "\n",
+                            capture_output=True, text=True, check=False)
+    return result.stdout.splitlines()
+
+
+def create_lines(procs):
+    """Create commands for processes given as (id, priority, start, work, task)."""
+    return ["create %d %d %d %d %d" % proc for proc in procs]
+
+
+def stat_lines(output, count):
+    """The fields of the first count "s" lines after the algorithm, as tuples of ints (None if missing)."""
+    stats = [tuple(map(int, line.split()[2:])) for line in output if line.startswith("s ")]
+    return (stats + [None] * count)[:count]
+
+
+def totals(procs, finish):
+    """(count, total turnaround, total wait, finish time) from each process's finish time."""
+    turnaround = sum(finish[proc[0]] - proc[2] for proc in procs)
+    wait = sum(finish[proc[0]] - proc[2] - proc[3] for proc in procs)
+    return (len(procs), turnaround, wait, max(finish.values()))
+
+
+def arrival_order(procs):
+    """Processes by start time, then ID, as the algorithms take them."""
+    return sorted(procs, key=lambda proc: (proc[2], proc[0]))
+
+
+def reference_basic(procs, algorithm, quantum):
+    """FCFS (1), SJF (2), RR (3), and PRI (4), without preemption except for RR's quantum."""
+    order = arrival_order(procs)
+    count = len(order)
+    time = 0
+    arrived = 0
+    finish = {}
+    if algorithm == 1:
+        for proc in order:
+            time = max(time, proc[2]) + proc[3]
+            finish[proc[0]] = time
+    elif algorithm in (2, 4):
+        ready = []
+        while len(finish) < count:
+            while arrived < count and order[arrived][2] <= time:
+                key = order[arrived][3] if algorithm == 2 else order[arrived][1]
+                heapq.heappush(ready, (key, arrived))
+                arrived += 1
+            if not ready:
+                time = order[arrived][2]
+                continue
+            _, rank = heapq.heappop(ready)
+            time += order[rank][3]
+            finish[order[rank][0]] = time
+    else:
+        ready = collections.deque()
+        left = {}
+        while len(finish) < count:
+            while arrived < count and order[arrived][2] <= time:
+                left[arrived] = order[arrived][3]
+                ready.append(arrived)
+                arrived += 1
+            if not ready:
+                time = order[arrived][2]
+                continue
+            rank = ready.popleft()
+            run = min(quantum, left[rank])
+            left[rank] -= run
+            time += run
+            # Processes that arrived during the slice queue up before the one it preempted.
+            while arrived < count and order[arrived][2] <= time:
+                left[arrived] = order[arrived][3]
+                ready.append(arrived)
+                arrived += 1
+            if left[rank] > 0:
+                ready.append(rank)
+            else:
+                finish[order[rank][0]] = time
+    return totals(procs, finish)
+
+
+def check_basic(prm, rng):
+    """FCFS, SJF, RR, and PRI over workloads from sparse to heavily overloaded."""
+    mismatches = 0
+    for trial in range(30):
+        count = rng.randint(1, 300)
+        ids = rng.sample(range(1, 100000), count)
+        spread = rng.choice([5, 50, 2000])
+        longest = rng.choice([3, 30])
+        procs = [(i, rng.randint(-3, 3), rng.randint(1, spread), rng.randint(1, longest), 0) for i in ids]
+        runs = [(algorithm, rng.randint(1, 5)) for algorithm in (1, 2, 3, 4)]
+        lines = create_lines(procs) + ["simulate %d %d" % run for run in runs]
+        for run, got in zip(runs, stat_lines(run_batch(prm, lines), len(runs))):
+            expected = reference_basic(procs, *run)
+            if got != expected:
+                mismatches += 1
+                if mismatches <= MAX_REPORTED:
+                    print("  trial %d, simulate %d %d: got %s, expected %s" % (trial, *run, got, expected))
+    return mismatches
+
+
+def reference_predictive(procs, preemptive, alpha, first_estimate):
+    """PSJF, or PSRTF if preemptive: each burst is estimated from the earlier bursts of its task."""
+    order = arrival_order(procs)
+    count = len(order)
+    task_estimates = {}
+    left = [proc[3] for proc in order]
+    ready = []
+    time = 0
+    arrived = 0
+    error = 0
+    finish = {}
+
+    def arrive():
+        nonlocal arrived, error
+        any_arrived = False
+        while arrived < count and order[arrived][2] <= time:
+            task = order[arrived][4]
+            estimate = int(task_estimates.get(task, first_estimate) + 0.5) if task else int(first_estimate + 0.5)
+            error += abs(estimate - order[arrived][3])
+            heapq.heappush(ready, (estimate, arrived))
+            arrived += 1
+            any_arrived = True
+        return any_arrived
+
+    while len(finish) < count:
+        arrive()
+        if not ready:
+            time = order[arrived][2]
+            continue
+        estimate_left, rank = heapq.heappop(ready)
+        preempted = False
+        while True:
+            time += 1
+            left[rank] -= 1
+            estimate_left = max(estimate_left - 1, 0)
+            any_arrived = arrive()
+            if left[rank] == 0:
+                break
+            if preemptive and any_arrived and ready[0][0] < estimate_left:
+                heapq.heappush(ready, (estimate_left, rank))
+                preempted = True
+                break
+        if preempted:
+            continue
+        task = order[rank][4]
+        if task:
+            task_estimates[task] = alpha * order[rank][3] + (1 - alpha) * task_estimates.get(task, first_estimate)
+        finish[order[rank][0]] = time
+    return totals(procs, finish) + (error,)
+
+
+def check_predictive(prm, rng):
+    """PSJF and PSRTF over small workloads of a few tasks, with alpha from 0 to 1."""
+    mismatches = 0
+    for trial in range(300):
+        count = rng.randint(1, 60)
+        ids = rng.sample(range(1, 1000), count)
+        procs = [(i, 0, rng.randint(1, 3 * count), rng.randint(1, 15), rng.randint(0, 5)) for i in ids]
+        alpha = rng.choice([0, 25, 50, 80, 100])
+        first_estimate = rng.randint(1, 20)
+        runs = [(algorithm, 2, alpha, first_estimate) for algorithm in (5, 6)]
+        lines = create_lines(procs) + ["simulate %d %d %d %d" % run for run in runs]
+        for run, got in zip(runs, stat_lines(run_batch(prm, lines), len(runs))):
+            expected = reference_predictive(procs, run[0] == 6, alpha / 100, first_estimate)
+            if got != expected:
+                mismatches += 1
+                if mismatches <= MAX_REPORTED:
+                    print("  trial %d, simulate %d %d %d %d: got %s, expected %s" % (trial, *run, got, expected))
+    return mismatches
+
+
+def splitmix64(state):
+    """One step of SplitMix64, the lottery's random numbers: returns (next state, draw)."""
+    state = (state + 0x9E3779B97F4A7C15) & MASK64
+    mixed = ((state ^ (state >> 30)) * 0xBF58476D1CE4E5B9) & MASK64
+    mixed = ((mixed ^ (mixed >> 27)) * 0x94D049BB133111EB) & MASK64
+    return state, mixed ^ (mixed >> 31)
+
+
+def reference_share(procs, stride, quantum, window, seed):
+    """
+    Lottery, or stride if stride is set, with the priorities as tickets (at least 1). Returns the totals
+    and the share errors: over each process's life, and on average and at worst over the windows.
+    """
+    order = arrival_order(procs)
+    count = len(order)
+    tickets = [max(1, proc[1]) for proc in order]
+    left = [proc[3] for proc in order]
+    passes = {}
+    last_pass = 0
+    state = seed
+    active = []
+    time = 0
+    arrived = 0
+    finish = {}
+    received = {}      # (window, rank) -> CPU time received.
+    entitled = {}      # (window, rank) -> CPU time it was entitled to.
+    busy = {}          # window -> CPU time used.
+    life_received = [0] * count
+    life_entitled = [0.0] * count
+
+    def pass_step(rank):
+        return max(1, (1 << 20) // tickets[rank])
+
+    while len(finish) < count:
+        while arrived < count and order[arrived][2] <= time:
+            active.append(arrived)
+            if stride:
+                passes[arrived] = last_pass + pass_step(arrived)
+            arrived += 1
+        if not active:
+            time = order[arrived][2]
+            continue
+        active.sort()
+        if stride:
+            rank = min(active, key=lambda r: (passes[r], r))
+            last_pass = passes[rank]
+        else:
+            state, draw = splitmix64(state)
+            draw %= sum(tickets[r] for r in active)
+            for rank in active:
+                if draw < tickets[rank]:
+                    break
+                draw -= tickets[rank]
+        run = min(quantum, left[rank])
+        current = time // window
+        all_tickets = sum(tickets[r] for r in active)
+        for r in active:
+            share = run * tickets[r] / all_tickets
+            entitled[(current, r)] = entitled.get((current, r), 0) + share
+            life_entitled[r] += share
+        received[(current, rank)] = received.get((current, rank), 0) + run
+        life_received[rank] += run
+        busy[current] = busy.get(current, 0) + run
+        left[rank] -= run
+        time += run
+        if left[rank] == 0:
+            active.remove(rank)
+            finish[order[rank][0]] = time
+        elif stride:
+            passes[rank] += pass_step(rank)
+
+    life_difference = sum(abs(life_received[r] - life_entitled[r]) for r in range(count))
+    life_error = life_difference / (2 * sum(proc[3] for proc in order))
+    window_errors = []
+    for current in sorted(busy):
+        ranks = [r for (w, r) in entitled if w == current]
+        difference = sum(abs(received.get((current, r), 0) - entitled[(current, r)]) for r in ranks)
+        window_errors.append(difference / (2 * busy[current]))
+    errors = (life_error, sum(window_errors) / len(window_errors), max(window_errors))
+    return totals(procs, finish) + tuple(round(error * 1e6) for error in errors)
+
+
+def check_share(prm, rng):
+    """Lottery and stride over small workloads with tickets from 1 to 100, windows from 1 to 1000."""
+    mismatches = 0
+    for trial in range(400):
+        count = rng.randint(1, 40)
+        ids = rng.sample(range(1, 1000), count)
+        procs = [(i, rng.choice([-2, 0, 1, 2, 3, 5, 10, 100]), rng.randint(1, 3 * count), rng.randint(1, 12), 0)
+                 for i in ids]
+        runs = [(algorithm, rng.randint(1, 4), 50, 10, rng.choice([1, 3, 7, 20, 1000]), rng.randint(0, 2 ** 31 - 1))
+                for algorithm in (7, 8)]
+        lines = create_lines(procs) + ["simulate %d %d %d %d %d %d" % run for run in runs]
+        for run, got in zip(runs, stat_lines(run_batch(prm, lines), len(runs))):
+            expected = reference_share(procs, run[0] == 8, run[1], run[4], run[5])
+            # The errors are printed rounded to parts per million, and may round the other way.
+            same = (got is not None and got[:4] == expected[:4] and
+                    all(abs(a - b) <= 1 for a, b in zip(got[4:], expected[4:])))
+            if not same:
+                mismatches += 1
+                if mismatches <= MAX_REPORTED:
+                    print("  trial %d, simulate %d %d %d %d %d %d: got %s, expected %s" % (trial, *run, got, expected))
+    return mismatches
+
+
+def burst_bucket(burst):
+    """Bucket of the adaptive quantum's histogram: one per length up to 15, then eight per power of two."""
+    if burst < 16:
+        return max(burst - 1, 0)
+    top = burst.bit_length() - 1
+    return 15 + (top - 4) * 8 + ((burst >> (top - 3)) & 7)
+
+
+def bucket_limit(bucket):
+    """Longest burst in a bucket."""
+    if bucket < 15:
+        return bucket + 1
+    top = 4 + (bucket - 15) // 8
+    return ((9 + (bucket - 15) % 8) << (top - 3)) - 1
+
+
+def reference_adaptive(procs, first_quantum, percentile):
+    """
+    Adaptive round robin: after every completion, the quantum becomes the longest burst of the bucket
+    holding the percentile of the completed bursts, each weighing ADAPT_GROWTH times the one before it.
+    The histogram is rebuilt from every burst each time. Returns the "q" lines and the statistics.
+    """
+    order = arrival_order(procs)
+    count = len(order)
+    left = [proc[3] for proc in order]
+    ready = collections.deque()
+    bursts = []
+    quantum = first_quantum
+    printed = 0
+    changes = 0
+    dispatches = 0
+    used = []
+    quantum_lines = []
+    time = 0
+    arrived = 0
+    finish = {}
+    while len(finish) < count:
+        while arrived < count and order[arrived][2] <= time:
+            ready.append(arrived)
+            arrived += 1
+        if not ready:
+            time = order[arrived][2]
+            continue
+        rank = ready.popleft()
+        if quantum != printed:
+            quantum_lines.append((time, quantum))
+            printed = quantum
+        used.append(quantum)
+        dispatches += 1
+        run = min(quantum, left[rank])
+        left[rank] -= run
+        time += run
+        while arrived < count and order[arrived][2] <= time:
+            ready.append(arrived)
+            arrived += 1
+        if left[rank] > 0:
+            ready.append(rank)
+            continue
+        finish[order[rank][0]] = time
+        bursts.append(order[rank][3])
+        weights = [0.0] * (burst_bucket((1 << 31) - 1) + 1)
+        for i, burst in enumerate(bursts):
+            weights[burst_bucket(burst)] += ADAPT_GROWTH ** (i - len(bursts))
+        target = percentile / 100 * sum(weights) * (1 - 1e-9)
+        below = 0
+        bucket = 0
+        while bucket < len(weights) - 1 and below + weights[bucket] < target:
+            below += weights[bucket]
+            bucket += 1
+        if bucket_limit(bucket) != quantum:
+            quantum = bucket_limit(bucket)
+            changes += 1
+    stats = totals(procs, finish) + (changes, min(used), max(used), used[-1], dispatches)
+    return quantum_lines, stats
+
+
+def check_adaptive(prm, rng):
+    """Adaptive round robin over bursts up to 3000, percentiles from 1 to 100."""
+    mismatches = 0
+    for trial in range(300):
+        count = rng.randint(1, 60)
+        ids = rng.sample(range(1, 1000), count)
+        longest = rng.choice([5, 20, 100, 3000])
+        procs = [(i, 0, rng.randint(1, 3 * count), rng.randint(1, longest), 0) for i in ids]
+        run = (9, rng.randint(1, 6), 50, 10, 20, 1, rng.choice([1, 10, 50, 80, 95, 100]))
+        output = run_batch(prm, create_lines(procs) + ["simulate %d %d %d %d %d %d %d" % run])
+        got = ([tuple(map(int, line.split()[1:])) for line in output if line.startswith("q ")],
+               stat_lines(output, 1)[0])
+        expected = reference_adaptive(procs, run[1], run[6])
+        if got != expected:
+            mismatches += 1
+            if mismatches <= MAX_REPORTED:
+                print("  trial %d, simulate %d %d %d %d %d %d %d: got %s, expected %s"
+                      % (trial, *run, got[1], expected[1]))
+    return mismatches
+
+
+def reference_locks(procs, sections, protocol):
+    """
+    Preemptive priority with locks, one time unit at a time, under protocol 0 (none), 1 (inheritance),
+    or 2 (ceiling). Sections are (id, lock, offset, length). Returns the "b" lines and the statistics.
+    """
+    order = arrival_order(procs)
+    count = len(order)
+    rank_of = {proc[0]: rank for rank, proc in enumerate(order)}
+    priority = [proc[1] for proc in order]
+    work = [proc[3] for proc in order]
+
+    # One lock at a time: a section starts no earlier than the one before it ends, and stops at the end
+    # of the burst.
+    requested = [[] for _ in range(count)]
+    for pid, lock, offset, length in sections:
+        if offset >= 0 and length > 0 and pid in rank_of:
+            requested[rank_of[pid]].append((offset, length, lock))
+    holds = []
+    for rank in range(count):
+        kept = []
+        released = 0
+        for offset, length, lock in sorted(requested[rank], key=lambda section: section[0]):
+            begin = max(offset, released)
+            if begin >= work[rank]:
+                break
+            released = min(begin + length, work[rank])
+            kept.append((begin, released, lock))
+        holds.append(kept)
+    ceiling = {}
+    for rank in range(count):
+        for _, _, lock in holds[rank]:
+            ceiling[lock] = min(ceiling.get(lock, priority[rank]), priority[rank])
+
+    owner = {}
+    waiters = {}
+    state = ["arriving"] * count
+    done_work = [0] * count
+    next_hold = [0] * count
+    holding = [None] * count
+    blocked_since = [0] * count
+    blocked = [0] * count
+    inversion = [0] * count
+
+    def effective(rank):
+        lock = holding[rank]
+        if lock is None:
+            return priority[rank]
+        if protocol == 2:
+            return min(priority[rank], ceiling[lock])
+        if protocol == 1 and waiters.get(lock):
+            return min(priority[rank], min(priority[w] for w in waiters[lock]))
+        return priority[rank]
+
+    time = 0
+    arrived = 0
+    running = None
+    finish = {}
+    block_lines = []
+    blocks = 0
+    while len(finish) < count:
+        while arrived < count and order[arrived][2] <= time:
+            state[arrived] = "ready"
+            arrived += 1
+        if running is None:
+            ready = [r for r in range(count) if state[r] == "ready"]
+            if not ready:
+                time = order[arrived][2]
+                continue
+            running = min(ready, key=lambda r: (effective(r), r))
+            state[running] = "running"
+        rank = running
+        if holding[rank] is not None and done_work[rank] == holds[rank][next_hold[rank]][1]:
+            lock = holding[rank]
+            holding[rank] = None
+            del owner[lock]
+            if waiters.get(lock):
+                woken = min(waiters[lock], key=lambda w: (priority[w], w))
+                waiters[lock].remove(woken)
+                owner[lock] = woken
+                holding[woken] = lock
+                blocked[woken] += time - blocked_since[woken]
+                state[woken] = "ready"
+            next_hold[rank] += 1
+        taking = holding[rank] is None and next_hold[rank] < len(holds[rank])
+        if taking and done_work[rank] == holds[rank][next_hold[rank]][0]:
+            lock = holds[rank][next_hold[rank]][2]
+            if lock not in owner:
+                owner[lock] = rank
+                holding[rank] = lock
+            else:
+                state[rank] = "blocked"
+                blocked_since[rank] = time
+                waiters.setdefault(lock, []).append(rank)
+                blocks += 1
+                running = None
+                continue
+        if done_work[rank] == work[rank]:
+            state[rank] = "done"
+            finish[order[rank][0]] = time
+            if blocked[rank] > 0 or inversion[rank] > 0:
+                block_lines.append((order[rank][0], blocked[rank], inversion[rank]))
+            running = None
+            continue
+        ready = [r for r in range(count) if state[r] == "ready"]
+        if ready and min(effective(r) for r in ready) < effective(rank):
+            state[rank] = "ready"
+            running = None
+            continue
+        time += 1
+        done_work[rank] += 1
+        for other in range(count):
+            if state[other] in ("ready", "blocked") and priority[other] < priority[rank]:
+                inversion[other] += 1
+    stats = totals(procs, finish) + (sum(blocked), sum(inversion), max(inversion), blocks)
+    return block_lines, stats
+
+
+def check_locks(prm, rng):
+    """Preemptive priority under each protocol, over a dozen processes sharing three locks."""
+    mismatches = 0
+    for trial in range(300):
+        count = rng.randint(1, 12)
+        ids = rng.sample(range(1, 40), count)
+        procs = [(i, rng.randint(0, 5), rng.randint(1, 31), rng.randint(1, 15), 0) for i in ids]
+        # Some sections are invalid or name no process, the batch rejects or ignores them.
+        sections = [(rng.choice(ids + [99]), rng.randint(0, 2), rng.randint(-1, 14), rng.randint(0, 8))
+                    for _ in range(rng.randint(0, 3 * count))]
+        lines = create_lines(procs) + ["lock %d %d %d %d" % section for section in sections]
+        lines += ["simulate 10 2 50 10 20 1 80 %d" % protocol for protocol in (0, 1, 2)]
+        output = run_batch(prm, lines)
+        runs = []
+        block_lines = []
+        for line in output:
+            if line.startswith("b "):
+                block_lines.append(tuple(map(int, line.split()[1:])))
+            elif line.startswith("s "):
+                runs.append((block_lines, tuple(map(int, line.split()[2:]))))
+                block_lines = []
+        runs = (runs + [None] * 3)[:3]
+        for protocol, got in enumerate(runs):
+            expected = reference_locks(procs, sections, protocol)
+            if got != expected:
+                mismatches += 1
+                if mismatches <= MAX_REPORTED:
+                    print("  trial %d, protocol %d: got %s, expected %s"
+                          % (trial, protocol, got and got[1], expected[1]))
+    return mismatches
+
+
+def table_lines(rng, count):
+    """Random table changes over a few IDs, some of them rejected (unknown IDs, invalid moves)."""
+    lines = []
+    for _ in range(count):
+        ident = rng.randint(1, 30)
+        kind = rng.random()
+        if kind < 0.35:
+            lines.append("create %d %d %d %d" % (ident, rng.randint(0, 5), rng.randint(1, 50), rng.randint(1, 9)))
+        elif kind < 0.55:
+            lines.append("schedule %d %d %d" % (ident, rng.randint(-1, 1), rng.randint(-1, 1)))
+        elif kind < 0.7:
+            lines.append("dispatch")
+        elif kind < 0.8:
+            lines.append("priority %d %d" % (ident, rng.randint(0, 5)))
+        elif kind < 0.9:
+            lines.append("terminate %d" % ident)
+        elif kind < 0.95:
+            lines.append("purge %d %d %d" % (rng.choice([-1, 0, 1, 2]), rng.randint(0, 3), rng.randint(2, 5)))
+        else:
+            lines.append("unblock")
+    return lines
+
+
+def list_lines(output):
+    """The "p" lines and the "ok list" line of a list command's output."""
+    return [line for line in output if line.startswith("p ") or line.startswith("ok list ")]
+
+
+def check_journal(prm, rng):
+    """Journal replay after random table changes, whole and with a torn last record."""
+    mismatches = 0
+    with tempfile.TemporaryDirectory() as directory:
+        for trial in range(100):
+            lines = table_lines(rng, rng.randint(1, 200))
+            # Always journaled, so tearing the journal's last record undoes exactly this create.
+            last = "create %d 0 1 1" % rng.randint(31, 40)
+            whole = os.path.join(directory, "whole.%d" % trial)
+            torn = os.path.join(directory, "torn.%d" % trial)
+            # The list output only, leaving out the errors of rejected commands.
+            expected = list_lines(run_batch(prm, lines + [last, "list"], ("--journal", whole)))
+            expected_torn = list_lines(run_batch(prm, lines + ["list"], ("--journal", torn)))
+            got = run_batch(prm, ["list"], ("--journal", whole))
+            with open(whole, "r+b") as journal:
+                journal.truncate(os.path.getsize(whole) - rng.randint(1, JOURNAL_RECORD_SIZE - 1))
+            got_torn = run_batch(prm, ["list"], ("--journal", whole))
+            for name, got_list, expected_list in (("whole", got, expected), ("torn", got_torn, expected_torn)):
+                if got_list != expected_list:
+                    mismatches += 1
+                    if mismatches <= MAX_REPORTED:
+                        print("  trial %d, %s journal: got %s, expected %s"
+                              % (trial, name, got_list[-1:], expected_list[-1:]))
+    return mismatches
+
+
+CHECKS = [
+    ("FCFS, SJF, RR, PRI", check_basic),
+    ("PSJF, PSRTF", check_predictive),
+    ("Lottery, stride", check_share),
+    ("Adaptive RR", check_adaptive),
+    ("Preemptive priority with locks", check_locks),
+    ("Journal replay", check_journal),
+]
+
+
+def main():
+    prm = sys.argv[1] if len(sys.argv) > 1 else "./PRM"
+    seed = int(sys.argv[2]) if len(sys.argv) > 2 else 1
+    failures = 0
+    for name, check in CHECKS:
+        mismatches = check(prm, random.Random(seed))
+        print("%s: %s" % (name, "ok" if mismatches == 0 else "%d mismatch(es)" % mismatches))
+        failures += mismatches
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,109 @@
+/**
+ * Process manager client library implementation file.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#include "client.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+bool client_connect(struct ProcessClient *client, const char *socket_path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        return false;
+    }
+    strcpy(address.sun_path, socket_path);
+
+    client->fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (client->fd < 0) {
+        return false;
+    }
+    if (connect(client->fd, (struct sockaddr *)&address, sizeof(address)) != 0) {
+        close(client->fd);
+        client->fd = -1;
+        return false;
+    }
+    client->queued = 0;
+    client->pending = 0;
+    return true;
+}
+
+void client_close(struct ProcessClient *client) {
+    if (client->fd >= 0) {
+        close(client->fd);
+        client->fd = -1;
+    }
+}
+
+bool client_send(struct ProcessClient *client, enum RequestOp op, int id, int arg0, int arg1, int arg2, int arg3) {
+    if (client->queued == CLIENT_QUEUE_SIZE && !client_flush(client)) {
+        return false;
+    }
+
+    struct Request *request = &client->queue[client->queued++];
+    request->op = op;
+    request->id = id;
+    request->args[0] = arg0;
+    request->args[1] = arg1;
+    request->args[2] = arg2;
+    request->args[3] = arg3;
+    return true;
+}
+
+bool client_flush(struct ProcessClient *client) {
+    const char *ptr = (const char *)client->queue;
+    size_t length = client->queued * sizeof(struct Request);
+    while (length > 0) {
+        ssize_t written = send(client->fd, ptr, length, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        ptr += written;
+        length -= written;
+    }
+    client->pending += client->queued;
+    client->queued = 0;
+    return true;
+}
+
+bool client_receive(struct ProcessClient *client, struct Response *responses, uint32_t count) {
+    if (client->queued > 0 && !client_flush(client)) {
+        return false;
+    }
+    if (count > client->pending) {
+        return false;
+    }
+
+    char *ptr = (char *)responses;
+    size_t length = count * sizeof(struct Response);
+    while (length > 0) {
+        ssize_t num_read = read(client->fd, ptr, length);
+        if (num_read < 0 && errno == EINTR) {
+            continue;
+        }
+        if (num_read <= 0) {
+            return false;
+        }
+        ptr += num_read;
+        length -= num_read;
+    }
+    client->pending -= count;
+    return true;
+}
+
+bool client_call(struct ProcessClient *client, enum RequestOp op, int id, int arg0, int arg1, int arg2, int arg3,
+                 struct Response *response) {
+    return client_send(client, op, id, arg0, arg1, arg2, arg3) && client_receive(client, response, 1);
+}
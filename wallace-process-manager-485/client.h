@@ -0,0 +1,86 @@
+/**
+ * Process manager client library header file.
+ * Connects to a process manager server (PRM --server) and exchanges requests and responses
+ * (see protocol.h). Requests are buffered and sent together, so a caller can pipeline a whole
+ * batch of requests with one write and then collect the responses in order.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#ifndef CLIENT_H
+#define CLIENT_H
+
+#include "protocol.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define CLIENT_QUEUE_SIZE 2048  // Requests buffered before they are sent automatically.
+
+struct ProcessClient {
+    int fd;
+    uint32_t queued;                            // Requests buffered but not sent.
+    uint32_t pending;                           // Requests sent but not answered.
+    struct Request queue[CLIENT_QUEUE_SIZE];
+};
+
+/**
+ * Connects to a server.
+ *
+ * @param client Client to initialize.
+ * @param socket_path Path of the server's socket.
+ * @return bool False if the server could not be reached.
+ */
+bool client_connect(struct ProcessClient *client, const char *socket_path);
+
+/**
+ * Closes the connection. Unanswered requests are dropped.
+ *
+ * @param client Connected client.
+ */
+void client_close(struct ProcessClient *client);
+
+/**
+ * Buffers a request, sending the buffer first if it is full. The server stops reading a connection
+ * whose responses are not being read, so a caller should collect responses at least every few
+ * thousand requests, or both sides end up waiting on each other.
+ *
+ * @param client Connected client.
+ * @param op Operation (enum RequestOp).
+ * @param id Process ID (the filter state for REQUEST_PURGE).
+ * @param arg0 First argument (see enum RequestOp).
+ * @param arg1 Second argument.
+ * @param arg2 Third argument.
+ * @param arg3 Fourth argument.
+ * @return bool False if sending failed.
+ */
+bool client_send(struct ProcessClient *client, enum RequestOp op, int id, int arg0, int arg1, int arg2, int arg3);
+
+/**
+ * Sends every buffered request in one write.
+ *
+ * @param client Connected client.
+ * @return bool False if the connection failed.
+ */
+bool client_flush(struct ProcessClient *client);
+
+/**
+ * Waits for the responses to the oldest sent requests, sending any buffered requests first.
+ *
+ * @param client Connected client.
+ * @param responses Receives the responses, in request order.
+ * @param count Number of responses to wait for (at most the number of requests sent).
+ * @return bool False if the connection failed or count is more than the requests outstanding.
+ */
+bool client_receive(struct ProcessClient *client, struct Response *responses, uint32_t count);
+
+/**
+ * Sends one request and waits for its response. Earlier requests must already be answered.
+ *
+ * @return bool False if the connection failed.
+ */
+bool client_call(struct ProcessClient *client, enum RequestOp op, int id, int arg0, int arg1, int arg2, int arg3,
+                 struct Response *response);
+
+#endif // CLIENT_H
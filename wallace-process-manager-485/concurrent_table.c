@@ -0,0 +1,143 @@
+/**
+ * Concurrent process table implementation file.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#include "concurrent_table.h"
+#include <sched.h>
+
+/**
+ * Shard that owns a process ID. Uses the high bits of the hash, the shard's own
+ * ID index uses the low bits.
+ */
+static struct ProcessShard *_ct_shard(struct ConcurrentTable *ct, int id) {
+    uint32_t hash = (uint32_t)id * 2654435769u;
+    return &ct->shards[hash >> (32 - CT_SHARD_BITS)];
+}
+
+/**
+ * Takes a shard's writer lock and marks the shard as being written (sequence becomes odd).
+ */
+static void _ct_write_begin(struct ProcessShard *shard) {
+    pthread_mutex_lock(&shard->lock);
+    atomic_fetch_add_explicit(&shard->sequence, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+/**
+ * Marks the shard as consistent again (sequence becomes even) and releases the writer lock.
+ */
+static void _ct_write_end(struct ProcessShard *shard) {
+    atomic_fetch_add_explicit(&shard->sequence, 1, memory_order_release);
+    pthread_mutex_unlock(&shard->lock);
+}
+
+/**
+ * Waits until no writer is inside a shard and returns the sequence number to validate against.
+ */
+static unsigned _ct_read_begin(struct ProcessShard *shard) {
+    unsigned sequence;
+    while ((sequence = atomic_load_explicit(&shard->sequence, memory_order_acquire)) & 1) {
+        sched_yield();
+    }
+    return sequence;
+}
+
+/**
+ * True if no writer entered the shard since _ct_read_begin returned the given sequence number.
+ */
+static bool _ct_read_valid(struct ProcessShard *shard, unsigned sequence) {
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&shard->sequence, memory_order_relaxed) == sequence;
+}
+
+bool ct_init(struct ConcurrentTable *ct) {
+    for (int i = 0; i < CT_NUM_SHARDS; i++) {
+        struct ProcessShard *shard = &ct->shards[i];
+        if (!pt_init(&shard->table)) {
+            for (int j = 0; j < i; j++) {
+                pt_destroy(&ct->shards[j].table);
+                pthread_mutex_destroy(&ct->shards[j].lock);
+            }
+            return false;
+        }
+        shard->table.retain_retired = true;   // Readers may still be probing a replaced ID index.
+        pthread_mutex_init(&shard->lock, NULL);
+        atomic_init(&shard->sequence, 0);
+    }
+    return true;
+}
+
+void ct_destroy(struct ConcurrentTable *ct) {
+    for (int i = 0; i < CT_NUM_SHARDS; i++) {
+        pt_destroy(&ct->shards[i].table);
+        pthread_mutex_destroy(&ct->shards[i].lock);
+    }
+}
+
+enum ManagerResult ct_create(struct ConcurrentTable *ct, int id, int priority, int start_time, int work_time) {
+    struct ProcessShard *shard = _ct_shard(ct, id);
+    _ct_write_begin(shard);
+    enum ManagerResult result = pm_create(&shard->table, id, priority, start_time, work_time);
+    _ct_write_end(shard);
+    return result;
+}
+
+enum ManagerResult ct_schedule(struct ConcurrentTable *ct, int id, int curr_state, int next_state) {
+    struct ProcessShard *shard = _ct_shard(ct, id);
+    _ct_write_begin(shard);
+    enum ManagerResult result = pm_schedule(&shard->table, id, curr_state, next_state);
+    _ct_write_end(shard);
+    return result;
+}
+
+enum ManagerResult ct_set_priority(struct ConcurrentTable *ct, int id, int priority) {
+    struct ProcessShard *shard = _ct_shard(ct, id);
+    _ct_write_begin(shard);
+    enum ManagerResult result = pm_set_priority(&shard->table, id, priority);
+    _ct_write_end(shard);
+    return result;
+}
+
+enum ManagerResult ct_terminate(struct ConcurrentTable *ct, int id) {
+    struct ProcessShard *shard = _ct_shard(ct, id);
+    _ct_write_begin(shard);
+    enum ManagerResult result = pm_terminate(&shard->table, id);
+    _ct_write_end(shard);
+    return result;
+}
+
+bool ct_lookup(struct ConcurrentTable *ct, int id, struct Process *out) {
+    struct ProcessShard *shard = _ct_shard(ct, id);
+    struct Process copy;
+    bool found;
+    unsigned sequence;
+
+    do {
+        sequence = _ct_read_begin(shard);
+        found = pt_read(&shard->table, id, &copy);
+    } while (!_ct_read_valid(shard, sequence));
+
+    if (found) {
+        *out = copy;
+    }
+    return found;
+}
+
+uint32_t ct_count(struct ConcurrentTable *ct) {
+    uint32_t total = 0;
+    for (int i = 0; i < CT_NUM_SHARDS; i++) {
+        struct ProcessShard *shard = &ct->shards[i];
+        uint32_t count;
+        unsigned sequence;
+        do {
+            sequence = _ct_read_begin(shard);
+            count = __atomic_load_n(&shard->table.count, __ATOMIC_RELAXED);
+        } while (!_ct_read_valid(shard, sequence));
+        total += count;
+    }
+    return total;
+}
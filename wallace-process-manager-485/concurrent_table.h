@@ -0,0 +1,77 @@
+/**
+ * Concurrent process table header file.
+ * A thread-safe process table split into shards by process ID. Each shard is an ordinary
+ * process table guarded by its own mutex for writers and a sequence lock for readers,
+ * so lookups never take a lock and writers only contend when they hit the same shard.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#ifndef CONCURRENT_TABLE_H
+#define CONCURRENT_TABLE_H
+
+#include "manager.h"
+#include "process_table.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+
+#define CT_SHARD_BITS 6                     // log2 of the number of shards.
+#define CT_NUM_SHARDS (1 << CT_SHARD_BITS)  // Number of shards.
+
+struct ProcessShard {
+    pthread_mutex_t lock;       // Serializes writers of this shard.
+    atomic_uint sequence;       // Sequence lock, odd while a writer is changing the table.
+    struct ProcessTable table;
+} __attribute__((aligned(64)));
+
+struct ConcurrentTable {
+    struct ProcessShard shards[CT_NUM_SHARDS];
+};
+
+/**
+ * Initializes every shard of a concurrent table.
+ *
+ * @param ct Table to initialize.
+ * @return bool False if a shard could not be initialized.
+ */
+bool ct_init(struct ConcurrentTable *ct);
+
+/**
+ * Destroys every shard. No other thread may be using the table.
+ *
+ * @param ct Table to destroy.
+ */
+void ct_destroy(struct ConcurrentTable *ct);
+
+/**
+ * Thread-safe versions of the process manager operations (see manager.h).
+ * Each call only locks the shard that owns the process ID.
+ */
+enum ManagerResult ct_create(struct ConcurrentTable *ct, int id, int priority, int start_time, int work_time);
+enum ManagerResult ct_schedule(struct ConcurrentTable *ct, int id, int curr_state, int next_state);
+enum ManagerResult ct_set_priority(struct ConcurrentTable *ct, int id, int priority);
+enum ManagerResult ct_terminate(struct ConcurrentTable *ct, int id);
+
+/**
+ * Lock-free lookup of a process by ID. Retries (without blocking writers) until it reads a
+ * consistent copy, so it never returns a half-written process.
+ *
+ * @param ct Concurrent table.
+ * @param id Process ID.
+ * @param out Receives a copy of the process if found.
+ * @return bool True if the process exists.
+ */
+bool ct_lookup(struct ConcurrentTable *ct, int id, struct Process *out);
+
+/**
+ * Total number of processes. Each shard is read consistently, but shards are read one after another.
+ *
+ * @param ct Concurrent table.
+ * @return uint32_t Process count.
+ */
+uint32_t ct_count(struct ConcurrentTable *ct);
+
+#endif // CONCURRENT_TABLE_H
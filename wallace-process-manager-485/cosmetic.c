@@ -1,30 +1,47 @@
 /**
  * Cosmetic methods implementation file.
- * Implements a function for typewriter printing, removing lines in the terminal, and clearing the terminal.
+ * Implements a function for typewriter printing, removing lines in the terminal, and clearing the terminal,
+ * plus buffered frames for printing large tables with one write.
+ * Everything is printed through output.h, so it is queued instead of waiting on the terminal
+ * while the output thread runs.
  *
  * @author  J. Kenneth Wallace
  * @version 0.1
  * @since   2024-04-13
  */
 
-// Used for clearing the terminal when starting program.
-#ifdef _WIN32
-    #define OS "Windows"
-#elif __linux__
-    #define OS "Linux"
-#else
-    #define OS "Unknown"
-#endif
-
 #include "cosmetic.h"
+#include "output.h"
+#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
-#include <windows.h>
+
+// Sleep() on Windows, terminal size on Linux.
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/ioctl.h>
+#endif
 
 /* Global Variables */
 int DELAY = 10000;      // Typewriter effect delay.
 int text_indent = 2;    // How many spaces to prefix each string.
+bool is_terminal = true;        // stdout is a terminal, so colors and cursor movement are allowed.
+bool can_page = true;           // stdin and stdout are both terminals, so tables can wait for the user.
+char frame[FRAME_BUFFER_SIZE];  // Current frame.
+size_t frame_length = 0;
+int frame_rows = 0;             // Rows added since the last page break.
+int page_rows = FRAME_DEFAULT_PAGE;
+
+void _renderInit() {
+    is_terminal = isatty(STDOUT_FILENO);
+    can_page = is_terminal && isatty(STDIN_FILENO);
+    if (!is_terminal) {
+        DELAY = 0;
+    }
+}
 
 void _toggleDelay() {
     if (DELAY == 10000) {
@@ -36,42 +53,165 @@ void _toggleDelay() {
 }
 
 void _clearTerminal() {
-    if (OS == "Windows") {
-        system("cls");
-    }
-    else if (OS == "Linux") {
-        system("clear");
+    if (!is_terminal) {
+        return;
     }
+    output_flush();
+#ifdef _WIN32
+    system("cls");
+#elif __linux__
+    system("clear");
+#endif
 }
 
 void _typewriterPrint(char *str, int new_lines)
 {
     char *text_ptr = str;
+    char prefix[64];
+    int length = 0;
+
+    for (int i = 0; i < new_lines && length < (int)sizeof(prefix); i++) {
+        prefix[length++] = '\n';
+    }
 
-    for (int i = 0; i < new_lines; i++) {
-        printf("\n");
+    for (int i = 0; i < text_indent && length < (int)sizeof(prefix); i++) {
+        prefix[length++] = ' ';
     }
+    output_write(prefix, length);
 
-    for (int i = 0; i < text_indent; i++) {
-        printf(" ");
+    // No effect: queue the text instead of flushing every character.
+    if (DELAY == 0) {
+        output_write(str, strlen(str));
+        return;
     }
 
     while (*text_ptr != '\0') {
-        putchar(*text_ptr); // Print current character.
-        fflush(stdout);     // Flush output buffer.
-        text_ptr++;         // Increment pointer.
-        
-        if (OS == "Windows") {
-            Sleep(DELAY / 1000);
-        }
-        else if (OS == "Linux") {
-            usleep(DELAY);
-        }
+        output_write(text_ptr, 1);  // Print current character.
+        output_flush();             // Flush output buffer.
+        text_ptr++;                 // Increment pointer.
+
+#ifdef _WIN32
+        Sleep(DELAY / 1000);
+#else
+        usleep(DELAY);
+#endif
     }
 }
 
 void _removeLines(int num_lines) {
+    if (!is_terminal) {
+        return;
+    }
     for (int i = 0; i < num_lines; i++) {
-        printf("\033[F\033[K");
+        output_write("\033[F\033[K", 6);
+    }
+}
+
+void _textColor(const char *code) {
+    if (is_terminal) {
+        output_write(code, strlen(code));
+    }
+}
+
+void _skipLine() {
+    output_flush();
+    int c;
+    do {
+        c = getchar();
+    } while (c != '\n' && c != EOF);
+}
+
+/**
+ * Writes the frame composed so far, after anything already queued.
+ */
+static void _frameWrite() {
+    if (output_active()) {
+        output_write(frame, frame_length);
+        frame_length = 0;
+        return;
+    }
+    fflush(stdout);
+#ifdef _WIN32
+    fwrite(frame, 1, frame_length, stdout);
+    fflush(stdout);
+#else
+    size_t written = 0;
+    while (written < frame_length) {
+        ssize_t result = write(STDOUT_FILENO, frame + written, frame_length - written);
+        if (result <= 0) {
+            break;
+        }
+        written += result;
+    }
+#endif
+    frame_length = 0;
+}
+
+/**
+ * Appends formatted text to the frame, writing the frame out first if the text does not fit.
+ */
+static void _frameFormat(const char *format, va_list args) {
+    va_list retry;
+    va_copy(retry, args);
+    int length = vsnprintf(frame + frame_length, FRAME_BUFFER_SIZE - frame_length, format, args);
+    if (length >= 0 && (size_t)length >= FRAME_BUFFER_SIZE - frame_length) {
+        _frameWrite();
+        length = vsnprintf(frame, FRAME_BUFFER_SIZE, format, retry);
+        if (length >= FRAME_BUFFER_SIZE) {
+            length = FRAME_BUFFER_SIZE - 1;     // Longer than a whole frame, cut off.
+        }
     }
+    va_end(retry);
+    if (length > 0) {
+        frame_length += length;
+    }
+}
+
+void _frameBegin() {
+    frame_length = 0;
+    frame_rows = 0;
+    page_rows = FRAME_DEFAULT_PAGE;
+#ifndef _WIN32
+    // Leave room for the header above the rows and the prompt below them.
+    struct winsize size;
+    if (can_page && ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 10) {
+        page_rows = size.ws_row - 6;
+    }
+#endif
+}
+
+void _frameAppend(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    _frameFormat(format, args);
+    va_end(args);
+}
+
+bool _frameRow(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    _frameFormat(format, args);
+    va_end(args);
+
+    frame_rows++;
+    if (!can_page || frame_rows < page_rows) {
+        return true;
+    }
+
+    // One page is ready: show it and wait for the user.
+    frame_rows = 0;
+    _frameWrite();
+    const char *prompt = "  -- MORE (ENTER: NEXT PAGE, Q: STOP) --";
+    output_write(prompt, strlen(prompt));
+    output_flush();
+    int c = getchar();
+    if (c != '\n' && c != EOF) {
+        _skipLine();
+    }
+    output_write("\033[F\033[K", 6);
+    return c != 'q' && c != 'Q' && c != EOF;
+}
+
+void _frameEnd() {
+    _frameWrite();
 }
@@ -9,6 +9,18 @@
 #ifndef COSMETIC_H
 #define COSMETIC_H
 
+#include <stdbool.h>
+
+#define FRAME_BUFFER_SIZE (1 << 20)     // Bytes of output composed before a frame is written.
+#define FRAME_DEFAULT_PAGE 40           // Rows per page when the terminal height is unknown.
+
+/**
+ * Checks whether stdout is a terminal. If it is not (output piped or redirected), the typewriter
+ * effect, colors, and line clearing are turned off so the output is plain text, and tables are
+ * not paged. Call once before printing anything.
+ */
+void _renderInit();
+
 /**
  * Toggles typewriter effect.
  */
@@ -21,6 +33,7 @@ void _clearTerminal();
 
 /**
  * Cosmetic function that applies a typewriter effect to all printed text.
+ * With the effect off, the text is simply buffered like any other output.
  */
 void _typewriterPrint(char *str, int new_lines);
 
@@ -29,4 +42,40 @@ void _typewriterPrint(char *str, int new_lines);
  */
 void _removeLines(int num_lines);
 
-#endif // COSMETIC_H
\ No newline at end of file
+/**
+ * Prints an ANSI color code (e.g. "\033[31m"), unless stdout is not a terminal.
+ */
+void _textColor(const char *code);
+
+/**
+ * Discards the rest of the current input line, such as the newline scanf leaves behind.
+ */
+void _skipLine();
+
+/**
+ * Frame functions, for printing large blocks of text such as tables. Text is composed into one
+ * buffer and written with a single write when the frame ends (or the buffer fills up), instead
+ * of one small write per printf:
+ * _frameBegin(); _frameAppend(header); for (...) { if (!_frameRow(...)) break; } _frameEnd();
+ */
+void _frameBegin();
+
+/**
+ * Appends printf-style text to the current frame.
+ */
+void _frameAppend(const char *format, ...);
+
+/**
+ * Appends one table row to the current frame. When both stdin and stdout are terminals, the frame
+ * is written a page at a time (a screen's worth of rows) and the user is asked to continue.
+ *
+ * @return bool False if the user stopped paging, the caller should stop adding rows.
+ */
+bool _frameRow(const char *format, ...);
+
+/**
+ * Writes out the rest of the current frame.
+ */
+void _frameEnd();
+
+#endif // COSMETIC_H
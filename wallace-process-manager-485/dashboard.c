@@ -0,0 +1,440 @@
+/**
+ * Live dashboard implementation file.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#include "dashboard.h"
+#include "output.h"
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * Counters written by the simulation and read by the dashboard thread.
+ * The names are only written before the thread starts.
+ */
+struct DashboardCounters {
+    const char *title;
+    const char *clock_name;
+    const char *wait_name;
+    const char *queue_names[DASHBOARD_MAX_QUEUES];
+    int num_queues;
+    int num_cpus;
+
+    _Atomic(const char *) label;
+    atomic_llong clock;
+    atomic_int queue_length[DASHBOARD_MAX_QUEUES];
+    atomic_int cpu[DASHBOARD_MAX_CPUS];
+    atomic_llong completed;
+    atomic_llong wait_total;
+    atomic_llong histogram[DASHBOARD_BUCKETS];
+};
+
+/* Global Variables */
+static struct DashboardCounters counters = { .title = "", .clock_name = "CLOCK", .wait_name = "WAIT", .num_cpus = 1 };
+static atomic_bool active;
+
+void dashboard_setup(const char *title, const char *clock_name, const char *wait_name, int num_cpus) {
+    counters.title = title;
+    counters.clock_name = clock_name;
+    counters.wait_name = wait_name;
+    counters.num_queues = 0;
+    counters.num_cpus = (num_cpus < 1) ? 1 : (num_cpus > DASHBOARD_MAX_CPUS) ? DASHBOARD_MAX_CPUS : num_cpus;
+    for (int i = 0; i < DASHBOARD_MAX_CPUS; i++) {
+        atomic_store(&counters.cpu[i], -1);
+    }
+    dashboard_reset(NULL);
+}
+
+int dashboard_add_queue(const char *name) {
+    if (counters.num_queues == DASHBOARD_MAX_QUEUES) {
+        return DASHBOARD_MAX_QUEUES - 1;
+    }
+    counters.queue_names[counters.num_queues] = name;
+    return counters.num_queues++;
+}
+
+bool dashboard_active() {
+    return atomic_load_explicit(&active, memory_order_relaxed);
+}
+
+void dashboard_reset(const char *label) {
+    atomic_store_explicit(&counters.label, label, memory_order_relaxed);
+    atomic_store_explicit(&counters.clock, 0, memory_order_relaxed);
+    atomic_store_explicit(&counters.completed, 0, memory_order_relaxed);
+    atomic_store_explicit(&counters.wait_total, 0, memory_order_relaxed);
+    for (int i = 0; i < DASHBOARD_BUCKETS; i++) {
+        atomic_store_explicit(&counters.histogram[i], 0, memory_order_relaxed);
+    }
+}
+
+void dashboard_clock(long long clock) {
+    atomic_store_explicit(&counters.clock, clock, memory_order_relaxed);
+}
+
+void dashboard_queue(int queue, int length) {
+    atomic_store_explicit(&counters.queue_length[queue], length, memory_order_relaxed);
+}
+
+void dashboard_cpu(int cpu, int id) {
+    atomic_store_explicit(&counters.cpu[cpu], id, memory_order_relaxed);
+}
+
+void dashboard_complete(int count) {
+    atomic_fetch_add_explicit(&counters.completed, count, memory_order_relaxed);
+}
+
+void dashboard_wait(long long wait) {
+    if (wait < 0) {
+        wait = 0;
+    }
+    // Bucket 0 holds 0, bucket b holds [2^(b-1), 2^b), the last bucket holds everything above.
+    int bucket = 0;
+    for (long long rest = wait; rest > 0 && bucket < DASHBOARD_BUCKETS - 1; rest >>= 1) {
+        bucket++;
+    }
+    atomic_fetch_add_explicit(&counters.histogram[bucket], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&counters.wait_total, wait, memory_order_relaxed);
+}
+
+#ifdef _WIN32
+
+bool dashboard_start(int fps) {
+    fprintf(stderr, "dashboard: not supported on Windows\n");
+    return false;
+}
+
+void dashboard_stop() {
+}
+
+#else
+
+#include <errno.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DASHBOARD_MAX_ROWS (5 + DASHBOARD_MAX_CPUS / 4 + DASHBOARD_BUCKETS + 1)
+#define DASHBOARD_BAR 40            // Columns of the longest histogram bar.
+#define DASHBOARD_GAP 4             // Unchanged cells shorter than this between two changes are rewritten
+                                    // rather than skipped, since moving the cursor costs about as much.
+
+// Longest frame: every row split into runs of one changed cell and DASHBOARD_GAP unchanged ones, each
+// run after a cursor move (\033[<row>;<col>H, at most 12 bytes), plus saving and restoring the cursor.
+#define DASHBOARD_FRAME_SIZE (DASHBOARD_MAX_ROWS * (DASHBOARD_WIDTH + (DASHBOARD_WIDTH / (DASHBOARD_GAP + 1) + 1) * 12) + 4)
+
+/**
+ * Values read from the counters for one frame.
+ */
+struct DashboardSnapshot {
+    const char *label;
+    long long clock;
+    int queue_length[DASHBOARD_MAX_QUEUES];
+    int cpu[DASHBOARD_MAX_CPUS];
+    long long completed;
+    long long wait_total;
+    long long histogram[DASHBOARD_BUCKETS];
+};
+
+/* Global Variables */
+static pthread_t drawer;
+static pthread_mutex_t dashboard_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t dashboard_wake;   // Signals the drawer to stop.
+static bool stopping = false;
+static long frame_ns;                   // Time between frames.
+static int rows;                        // Rows used by the dashboard, including the separator.
+static int width;
+static int screen_rows;
+static char cells[DASHBOARD_MAX_ROWS][DASHBOARD_WIDTH];
+static char shown[DASHBOARD_MAX_ROWS][DASHBOARD_WIDTH];     // Cells currently on the screen.
+
+/**
+ * Seconds on the monotonic clock.
+ */
+static double _dashboardNow() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * Copies every counter, one relaxed load each, so the frame is drawn from stable values.
+ */
+static void _dashboardRead(struct DashboardSnapshot *snap) {
+    snap->label = atomic_load_explicit(&counters.label, memory_order_relaxed);
+    snap->clock = atomic_load_explicit(&counters.clock, memory_order_relaxed);
+    for (int i = 0; i < counters.num_queues; i++) {
+        snap->queue_length[i] = atomic_load_explicit(&counters.queue_length[i], memory_order_relaxed);
+    }
+    for (int i = 0; i < counters.num_cpus; i++) {
+        snap->cpu[i] = atomic_load_explicit(&counters.cpu[i], memory_order_relaxed);
+    }
+    snap->completed = atomic_load_explicit(&counters.completed, memory_order_relaxed);
+    snap->wait_total = atomic_load_explicit(&counters.wait_total, memory_order_relaxed);
+    for (int i = 0; i < DASHBOARD_BUCKETS; i++) {
+        snap->histogram[i] = atomic_load_explicit(&counters.histogram[i], memory_order_relaxed);
+    }
+}
+
+/**
+ * Writes printf-style text into one row of cells, padded with spaces to the full width.
+ */
+static void _dashboardRow(int row, const char *format, ...) {
+    char text[DASHBOARD_WIDTH + 1];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    if (length < 0) {
+        length = 0;
+    }
+    if (length > width) {
+        length = width;
+    }
+    memcpy(cells[row], text, length);
+    memset(cells[row] + length, ' ', width - length);
+}
+
+/**
+ * Draws one frame into the cells.
+ */
+static void _dashboardDraw(const struct DashboardSnapshot *snap, long frame, double elapsed, double rate) {
+    char line[DASHBOARD_WIDTH + 1];
+    int row = 0;
+
+    if (snap->label != NULL) {
+        snprintf(line, sizeof(line), "%s - %s", counters.title, snap->label);
+    }
+    else {
+        snprintf(line, sizeof(line), "%s", counters.title);
+    }
+    _dashboardRow(row++, " %-*.*s FRAME %-6ld %7.1f s", width - 24, width - 24, line, frame, elapsed);
+    _dashboardRow(row++, " %-10s %-14lld COMPLETED %-12lld %.0f/s", counters.clock_name, snap->clock, snap->completed, rate);
+
+    int length = snprintf(line, sizeof(line), " QUEUES    ");
+    for (int i = 0; i < counters.num_queues && length < width; i++) {
+        length += snprintf(line + length, sizeof(line) - length, " %s %-8d", counters.queue_names[i], snap->queue_length[i]);
+    }
+    _dashboardRow(row++, "%s", line);
+
+    for (int first = 0; first < counters.num_cpus; first += 4) {
+        length = 0;
+        for (int i = first; i < first + 4 && i < counters.num_cpus && length < width; i++) {
+            if (snap->cpu[i] < 0) {
+                length += snprintf(line + length, sizeof(line) - length, " CPU %-2d %-11s", i, "IDLE");
+            }
+            else {
+                length += snprintf(line + length, sizeof(line) - length, " CPU %-2d P %-9d", i, snap->cpu[i]);
+            }
+        }
+        _dashboardRow(row++, "%s", line);
+    }
+
+    long long samples = 0, highest = 1;
+    for (int i = 0; i < DASHBOARD_BUCKETS; i++) {
+        samples += snap->histogram[i];
+        if (snap->histogram[i] > highest) {
+            highest = snap->histogram[i];
+        }
+    }
+    _dashboardRow(row++, " %-20s SAMPLES %-12lld MEAN %.2f", counters.wait_name, samples,
+                  (samples > 0) ? (double)snap->wait_total / samples : 0.0);
+
+    for (int i = 0; i < DASHBOARD_BUCKETS; i++) {
+        char range[16];
+        if (i <= 1) {
+            snprintf(range, sizeof(range), "%d", i);
+        }
+        else if (i == DASHBOARD_BUCKETS - 1) {
+            snprintf(range, sizeof(range), "%lld+", 1LL << (i - 1));
+        }
+        else {
+            snprintf(range, sizeof(range), "%lld-%lld", 1LL << (i - 1), (1LL << i) - 1);
+        }
+        char bar[DASHBOARD_BAR + 1];
+        int bar_length = (int)(snap->histogram[i] * DASHBOARD_BAR / highest);
+        memset(bar, '#', bar_length);
+        bar[bar_length] = '\0';
+        _dashboardRow(row++, "   %-10s|%-*s| %lld", range, DASHBOARD_BAR, bar, snap->histogram[i]);
+    }
+
+    memset(cells[row], '-', width);
+}
+
+/**
+ * Writes terminal output in one piece: through the output thread if it is running (see output.h),
+ * otherwise straight to stdout, holding its lock so the text does not land in the middle of another print.
+ */
+static void _dashboardSend(const char *text, size_t length) {
+    if (output_active()) {
+        output_write(text, length);
+        return;
+    }
+    flockfile(stdout);
+    fflush(stdout);
+    fwrite(text, 1, length, stdout);
+    fflush(stdout);
+    funlockfile(stdout);
+}
+
+/**
+ * Writes the cells that differ from what is on the screen, each run of changes after one cursor move.
+ * The cursor is saved and restored around the frame, so the simulation's output carries on where it was.
+ *
+ * @return size_t Bytes written.
+ */
+static size_t _dashboardEmit() {
+    static char out[DASHBOARD_FRAME_SIZE];
+    size_t length = 2;
+    memcpy(out, "\0337", 2);
+
+    for (int row = 0; row < rows; row++) {
+        int col = 0;
+        while (col < width) {
+            if (cells[row][col] == shown[row][col]) {
+                col++;
+                continue;
+            }
+            // Extend the run over short stretches of unchanged cells.
+            int end = col + 1, same = 0;
+            for (int i = end; i < width && same < DASHBOARD_GAP; i++) {
+                if (cells[row][i] == shown[row][i]) {
+                    same++;
+                }
+                else {
+                    same = 0;
+                    end = i + 1;
+                }
+            }
+            length += sprintf(out + length, "\033[%d;%dH", row + 1, col + 1);
+            memcpy(out + length, cells[row] + col, end - col);
+            length += end - col;
+            col = end;
+        }
+        memcpy(shown[row], cells[row], width);
+    }
+    if (length == 2) {
+        return 0;
+    }
+    memcpy(out + length, "\0338", 2);
+    length += 2;
+    _dashboardSend(out, length);
+    return length;
+}
+
+/**
+ * Dashboard thread: draws frames until dashboard_stop, then draws one last frame.
+ */
+static void *_dashboardThread(void *ptr) {
+    (void)ptr;
+    struct DashboardSnapshot snap;
+    double start = _dashboardNow();
+    double rate_time = start, rate = 0;
+    long long rate_completed = 0;
+    long frame = 0;
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    bool last = false;
+    while (!last) {
+        pthread_mutex_lock(&dashboard_lock);
+        while (!stopping) {
+            deadline.tv_nsec += frame_ns;
+            if (deadline.tv_nsec >= 1000000000L) {
+                deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+                deadline.tv_nsec %= 1000000000L;
+            }
+            if (pthread_cond_timedwait(&dashboard_wake, &dashboard_lock, &deadline) == ETIMEDOUT) {
+                break;
+            }
+        }
+        last = stopping;
+        pthread_mutex_unlock(&dashboard_lock);
+
+        _dashboardRead(&snap);
+        double now = _dashboardNow();
+        // Completions per second over the last half second, so the number is readable.
+        if (now - rate_time >= 0.5 || last) {
+            long long done = snap.completed - rate_completed;
+            rate = (done > 0 && now > rate_time) ? done / (now - rate_time) : 0;
+            rate_time = now;
+            rate_completed = snap.completed;
+        }
+        _dashboardDraw(&snap, ++frame, now - start, rate);
+        _dashboardEmit();
+
+        // A slow terminal should not make frames pile up: skip ahead rather than catching up.
+        struct timespec current;
+        clock_gettime(CLOCK_MONOTONIC, &current);
+        if (current.tv_sec > deadline.tv_sec || (current.tv_sec == deadline.tv_sec && current.tv_nsec > deadline.tv_nsec)) {
+            deadline = current;
+        }
+    }
+    return NULL;
+}
+
+bool dashboard_start(int fps) {
+    if (dashboard_active()) {
+        return true;
+    }
+    struct winsize size;
+    if (!isatty(STDOUT_FILENO) || ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0) {
+        fprintf(stderr, "dashboard: stdout is not a terminal\n");
+        return false;
+    }
+    rows = 5 + (counters.num_cpus + 3) / 4 + DASHBOARD_BUCKETS;
+    width = (size.ws_col < DASHBOARD_WIDTH) ? size.ws_col : DASHBOARD_WIDTH;
+    screen_rows = size.ws_row;
+    if (screen_rows < rows + 5 || width < 60) {
+        fprintf(stderr, "dashboard: terminal too small (needs %dx%d)\n", 60, rows + 5);
+        return false;
+    }
+    frame_ns = 1000000000L / ((fps > 0) ? fps : DASHBOARD_DEFAULT_FPS);
+    memset(shown, 0, sizeof(shown));    // Nothing is on the screen yet, so the first frame is drawn in full.
+    stopping = false;
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&dashboard_wake, &attr);
+    pthread_condattr_destroy(&attr);
+
+    // Clear the screen and keep normal output scrolling below the dashboard.
+    char text[64];
+    int length = snprintf(text, sizeof(text), "\033[2J\033[%d;%dr\033[%d;1H", rows + 1, screen_rows, rows + 1);
+    _dashboardSend(text, length);
+
+    if (pthread_create(&drawer, NULL, _dashboardThread, NULL) != 0) {
+        length = snprintf(text, sizeof(text), "\033[r\033[%d;1H", screen_rows);
+        _dashboardSend(text, length);
+        pthread_cond_destroy(&dashboard_wake);
+        return false;
+    }
+    atomic_store(&active, true);
+    return true;
+}
+
+void dashboard_stop() {
+    if (!dashboard_active()) {
+        return;
+    }
+    pthread_mutex_lock(&dashboard_lock);
+    stopping = true;
+    pthread_cond_signal(&dashboard_wake);
+    pthread_mutex_unlock(&dashboard_lock);
+    pthread_join(drawer, NULL);
+    pthread_cond_destroy(&dashboard_wake);
+    atomic_store(&active, false);
+
+    // Give the whole screen back, with the cursor below everything.
+    char text[32];
+    int length = snprintf(text, sizeof(text), "\033[r\033[%d;1H\n", screen_rows);
+    _dashboardSend(text, length);
+}
+
+#endif
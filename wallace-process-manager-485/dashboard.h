@@ -0,0 +1,72 @@
+/**
+ * Live dashboard header file.
+ * Shows a running simulation at the top of the terminal: the clock, queue lengths, what each CPU
+ * is running, completions per second, and a histogram of wait times. The simulation only stores
+ * counters (relaxed atomic stores, no locks); a separate thread reads them at a capped frame rate,
+ * draws the frame into a grid of cells, and writes only the cells that changed since the last frame.
+ * Normal output keeps scrolling underneath the dashboard.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#ifndef DASHBOARD_H
+#define DASHBOARD_H
+
+#include <stdbool.h>
+
+#define DASHBOARD_MAX_QUEUES 4
+#define DASHBOARD_MAX_CPUS 8
+#define DASHBOARD_BUCKETS 12        // Wait histogram buckets: 0, 1, 2-3, 4-7, ..., 1024+.
+#define DASHBOARD_WIDTH 80          // Columns used by the dashboard.
+#define DASHBOARD_DEFAULT_FPS 20
+
+/**
+ * Describes what is being shown. Call before dashboard_start.
+ *
+ * @param title Shown on the first line.
+ * @param clock_name What the clock counts, e.g. "TIME" or "REQUESTS".
+ * @param wait_name What the histogram measures, e.g. "WAIT (TICKS)".
+ * @param num_cpus Number of CPUs shown (at most DASHBOARD_MAX_CPUS).
+ */
+void dashboard_setup(const char *title, const char *clock_name, const char *wait_name, int num_cpus);
+
+/**
+ * Adds a queue to the dashboard (at most DASHBOARD_MAX_QUEUES). Call before dashboard_start.
+ *
+ * @return int Index of the queue, for dashboard_queue.
+ */
+int dashboard_add_queue(const char *name);
+
+/**
+ * Reserves the top of the terminal and starts the dashboard thread.
+ *
+ * @param fps Maximum frames per second.
+ * @return bool False if stdout is not a terminal or is too small, nothing is shown then.
+ */
+bool dashboard_start(int fps);
+
+/**
+ * Draws the last frame, stops the dashboard thread, and gives the whole terminal back.
+ */
+void dashboard_stop();
+
+/**
+ * @return bool True while the dashboard thread is running.
+ */
+bool dashboard_active();
+
+/**
+ * Counter updates, called by the simulation. These never block and are cheap enough for a hot loop.
+ * dashboard_reset clears the clock, completions, and histogram when a new run starts, and shows
+ * the run's label next to the title (the string must stay valid).
+ */
+void dashboard_reset(const char *label);
+void dashboard_clock(long long clock);
+void dashboard_queue(int queue, int length);
+void dashboard_cpu(int cpu, int id);        // ID of the process running on the CPU, -1 == idle.
+void dashboard_complete(int count);
+void dashboard_wait(long long wait);        // Adds one wait time to the histogram.
+
+#endif // DASHBOARD_H
@@ -0,0 +1,438 @@
+/**
+ * Process manager journal implementation file.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#include "journal.h"
+#include "manager.h"
+
+#ifdef _WIN32
+
+bool journal_replay(struct ProcessTable *table, const char *path, uint64_t after_lsn, uint64_t *last_lsn) {
+    fprintf(stderr, "journal: not supported on Windows\n");
+    return false;
+}
+
+bool journal_open(const char *path, uint64_t last_lsn, int budget_us) {
+    fprintf(stderr, "journal: not supported on Windows\n");
+    return false;
+}
+
+void journal_append(enum JournalOp op, int id, int arg0, int arg1, int arg2, int arg3) {
+}
+
+uint64_t journal_lsn() {
+    return 0;
+}
+
+bool journal_sync() {
+    return true;
+}
+
+void journal_close() {
+}
+
+bool journal_print(const char *path, FILE *output) {
+    fprintf(stderr, "journal: not supported on Windows\n");
+    return false;
+}
+
+#else
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define JOURNAL_READ_RECORDS 8192   // Records read per chunk when replaying.
+
+/* Global Variables */
+static int journal_fd = -1;
+static pthread_t flusher;
+static pthread_mutex_t journal_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t flush_wake;       // Signals the flusher: first record buffered, buffer full, sync, or close.
+static pthread_cond_t flush_done;       // Signals appenders and journal_sync: a group was written.
+static struct JournalRecord *buffers[2];// The flusher writes one buffer while appenders fill the other.
+static int active = 0;                  // Buffer being filled.
+static size_t fill = 0;                 // Records in the active buffer.
+static struct timespec deadline;        // When the first record in the active buffer must be written by.
+static long budget_ns = 0;
+static uint64_t appended_lsn = 0;       // Last LSN appended.
+static uint64_t durable_lsn = 0;        // Last LSN written and synced.
+static bool sync_requested = false;
+static bool closing = false;
+static bool failed = false;
+static const char *journal_op_names[] = { "?", "create", "schedule", "terminate", "dispatch", "priority", "terminate_where", "unblock_all" };
+static const int journal_op_args[] = { 0, 4, 2, 0, 0, 1, 4, 0 };       // Arguments printed per operation.
+
+/**
+ * FNV-1a checksum of a record, not including the checksum field.
+ */
+static uint32_t _journalChecksum(const struct JournalRecord *record) {
+    const unsigned char *bytes = (const unsigned char *)record;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(struct JournalRecord, checksum); i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Writes a whole buffer, retrying short writes.
+ */
+static bool _journalWrite(int fd, const void *data, size_t length) {
+    const char *ptr = data;
+    while (length > 0) {
+        ssize_t written = write(fd, ptr, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        ptr += written;
+        length -= written;
+    }
+    return true;
+}
+
+/**
+ * Reads the valid records of a journal, calling visit for each one.
+ *
+ * @param fd Journal file.
+ * @param valid_bytes Receives the length of the valid part of the file.
+ * @return bool False if the file could not be read.
+ */
+static bool _journalScan(int fd, off_t *valid_bytes, void (*visit)(const struct JournalRecord *, void *), void *context) {
+    struct JournalRecord *records = malloc(JOURNAL_READ_RECORDS * sizeof(struct JournalRecord));
+    if (records == NULL) {
+        return false;
+    }
+
+    uint64_t expected_lsn = 0;      // 0 until the first record, which may not be LSN 1.
+    off_t offset = 0;
+    bool valid = true;
+    bool ok = true;
+    while (valid) {
+        ssize_t num_read = pread(fd, records, JOURNAL_READ_RECORDS * sizeof(struct JournalRecord), offset);
+        if (num_read < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ok = false;
+            break;
+        }
+        size_t num_records = (size_t)num_read / sizeof(struct JournalRecord);
+        if (num_records == 0) {
+            break;
+        }
+        for (size_t i = 0; i < num_records; i++) {
+            const struct JournalRecord *record = &records[i];
+            if (record->checksum != _journalChecksum(record) || (expected_lsn != 0 && record->lsn != expected_lsn) ||
+                record->op < JOURNAL_CREATE || record->op > JOURNAL_UNBLOCK_ALL) {
+                valid = false;
+                break;
+            }
+            visit(record, context);
+            expected_lsn = record->lsn + 1;
+            offset += sizeof(struct JournalRecord);
+        }
+    }
+
+    free(records);
+    *valid_bytes = offset;
+    return ok;
+}
+
+struct JournalReplay {
+    struct ProcessTable *table;
+    uint64_t after_lsn;
+    uint64_t last_lsn;
+    long long applied;
+    long long rejected;     // Records the table did not accept, which means the journal and table disagree.
+};
+
+/**
+ * Applies one journal record to the table.
+ */
+static void _journalApply(const struct JournalRecord *record, void *context) {
+    struct JournalReplay *replay = context;
+    replay->last_lsn = record->lsn;
+    if (record->lsn <= replay->after_lsn) {
+        return;
+    }
+
+    enum ManagerResult result = PM_OK;
+    switch (record->op) {
+        case JOURNAL_CREATE:
+            result = pm_create(replay->table, record->id, record->args[0], record->args[1], record->args[2]);
+            if (result == PM_OK && record->args[3] != 0) {
+                result = pm_set_task(replay->table, record->id, record->args[3]);
+            }
+            break;
+        case JOURNAL_SCHEDULE:
+            result = pm_schedule(replay->table, record->id, record->args[0], record->args[1]);
+            break;
+        case JOURNAL_TERMINATE:
+            result = pm_terminate(replay->table, record->id);
+            break;
+        case JOURNAL_DISPATCH:
+            result = pm_schedule(replay->table, record->id, 0, 1);
+            break;
+        case JOURNAL_PRIORITY:
+            result = pm_set_priority(replay->table, record->id, record->args[0]);
+            break;
+        case JOURNAL_TERMINATE_WHERE: {
+            struct ProcessFilter filter = { record->id, record->args[0], record->args[1], record->args[2], record->args[3] };
+            uint32_t count;
+            result = pm_terminate_where(replay->table, &filter, &count);
+            break;
+        }
+        case JOURNAL_UNBLOCK_ALL: {
+            uint32_t count;
+            result = pm_unblock_all(replay->table, &count);
+            break;
+        }
+    }
+    if (result == PM_OK) {
+        replay->applied++;
+    }
+    else {
+        replay->rejected++;
+    }
+}
+
+bool journal_replay(struct ProcessTable *table, const char *path, uint64_t after_lsn, uint64_t *last_lsn) {
+    *last_lsn = after_lsn;
+    int fd = open(path, O_RDWR);
+    if (fd < 0) {
+        if (errno == ENOENT) {
+            return true;
+        }
+        perror(path);
+        return false;
+    }
+
+    struct timespec start, finish;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    struct JournalReplay replay = { table, after_lsn, after_lsn, 0, 0 };
+    off_t valid_bytes;
+    bool ok = _journalScan(fd, &valid_bytes, _journalApply, &replay);
+    off_t file_size = lseek(fd, 0, SEEK_END);
+    if (ok && file_size > valid_bytes) {
+        fprintf(stderr, "journal: %s: dropping %lld bytes of incomplete records\n", path, (long long)(file_size - valid_bytes));
+        ok = ftruncate(fd, valid_bytes) == 0 && fdatasync(fd) == 0;
+    }
+    close(fd);
+    if (!ok) {
+        perror(path);
+        return false;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &finish);
+    double ms = (finish.tv_sec - start.tv_sec) * 1e3 + (finish.tv_nsec - start.tv_nsec) / 1e6;
+    fprintf(stderr, "journal: replayed %lld records from %s in %.3f ms", replay.applied, path, ms);
+    if (replay.rejected > 0) {
+        fprintf(stderr, " (%lld did not apply)", replay.rejected);
+    }
+    fprintf(stderr, "\n");
+
+    if (replay.last_lsn < after_lsn) {
+        fprintf(stderr, "journal: %s ends before the snapshot, it may belong to a different snapshot\n", path);
+        replay.last_lsn = after_lsn;
+    }
+    *last_lsn = replay.last_lsn;
+    return true;
+}
+
+/**
+ * Group commit thread: waits until the oldest buffered record reaches its deadline (or a sync,
+ * a full buffer, or close), then writes and syncs the whole buffer while appenders fill the other.
+ */
+static void *_journalFlusher(void *unused) {
+    (void)unused;
+    pthread_mutex_lock(&journal_lock);
+    while (true) {
+        while (fill == 0 && !closing) {
+            pthread_cond_wait(&flush_wake, &journal_lock);
+        }
+        if (fill == 0) {
+            break;
+        }
+        while (fill < JOURNAL_BUFFER_RECORDS && !sync_requested && !closing &&
+               pthread_cond_timedwait(&flush_wake, &journal_lock, &deadline) != ETIMEDOUT) {
+        }
+
+        struct JournalRecord *group = buffers[active];
+        size_t group_size = fill;
+        uint64_t group_lsn = appended_lsn;
+        active ^= 1;
+        fill = 0;
+        sync_requested = false;
+        pthread_cond_broadcast(&flush_done);    // The other buffer is free for appenders.
+        pthread_mutex_unlock(&journal_lock);
+
+        bool ok = _journalWrite(journal_fd, group, group_size * sizeof(struct JournalRecord)) && fdatasync(journal_fd) == 0;
+
+        pthread_mutex_lock(&journal_lock);
+        if (!ok && !failed) {
+            perror("journal");
+            failed = true;
+        }
+        durable_lsn = group_lsn;
+        pthread_cond_broadcast(&flush_done);
+    }
+    pthread_mutex_unlock(&journal_lock);
+    return NULL;
+}
+
+bool journal_open(const char *path, uint64_t last_lsn, int budget_us) {
+    journal_fd = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (journal_fd < 0) {
+        perror(path);
+        return false;
+    }
+    buffers[0] = malloc(JOURNAL_BUFFER_RECORDS * sizeof(struct JournalRecord));
+    buffers[1] = malloc(JOURNAL_BUFFER_RECORDS * sizeof(struct JournalRecord));
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&flush_wake, &attr);
+    pthread_cond_init(&flush_done, NULL);
+    pthread_condattr_destroy(&attr);
+
+    active = 0;
+    fill = 0;
+    budget_ns = (long)budget_us * 1000;
+    appended_lsn = last_lsn;
+    durable_lsn = last_lsn;
+    sync_requested = false;
+    closing = false;
+    failed = false;
+
+    if (buffers[0] == NULL || buffers[1] == NULL || pthread_create(&flusher, NULL, _journalFlusher, NULL) != 0) {
+        fprintf(stderr, "journal: could not start the journal\n");
+        free(buffers[0]);
+        free(buffers[1]);
+        close(journal_fd);
+        journal_fd = -1;
+        return false;
+    }
+    return true;
+}
+
+void journal_append(enum JournalOp op, int id, int arg0, int arg1, int arg2, int arg3) {
+    if (journal_fd < 0) {
+        return;
+    }
+
+    pthread_mutex_lock(&journal_lock);
+    while (fill == JOURNAL_BUFFER_RECORDS) {
+        pthread_cond_wait(&flush_done, &journal_lock);
+    }
+
+    struct JournalRecord *record = &buffers[active][fill];
+    record->lsn = ++appended_lsn;
+    record->op = op;
+    record->id = id;
+    record->args[0] = arg0;
+    record->args[1] = arg1;
+    record->args[2] = arg2;
+    record->args[3] = arg3;
+    record->reserved = 0;
+    record->checksum = _journalChecksum(record);
+
+    fill++;
+    if (fill == 1) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_nsec += budget_ns;
+        deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+        deadline.tv_nsec %= 1000000000L;
+        pthread_cond_signal(&flush_wake);
+    }
+    else if (fill == JOURNAL_BUFFER_RECORDS) {
+        pthread_cond_signal(&flush_wake);
+    }
+    pthread_mutex_unlock(&journal_lock);
+}
+
+uint64_t journal_lsn() {
+    pthread_mutex_lock(&journal_lock);
+    uint64_t lsn = appended_lsn;
+    pthread_mutex_unlock(&journal_lock);
+    return lsn;
+}
+
+bool journal_sync() {
+    if (journal_fd < 0) {
+        return true;
+    }
+
+    pthread_mutex_lock(&journal_lock);
+    uint64_t target = appended_lsn;
+    while (durable_lsn < target) {
+        sync_requested = true;
+        pthread_cond_signal(&flush_wake);
+        pthread_cond_wait(&flush_done, &journal_lock);
+    }
+    bool ok = !failed;
+    pthread_mutex_unlock(&journal_lock);
+    return ok;
+}
+
+void journal_close() {
+    if (journal_fd < 0) {
+        return;
+    }
+
+    pthread_mutex_lock(&journal_lock);
+    closing = true;
+    pthread_cond_signal(&flush_wake);
+    pthread_mutex_unlock(&journal_lock);
+    pthread_join(flusher, NULL);    // The flusher writes whatever is left before it exits.
+
+    if (failed) {
+        fprintf(stderr, "journal: some records could not be written\n");
+    }
+    close(journal_fd);
+    journal_fd = -1;
+    free(buffers[0]);
+    free(buffers[1]);
+    buffers[0] = buffers[1] = NULL;
+    pthread_cond_destroy(&flush_wake);
+    pthread_cond_destroy(&flush_done);
+}
+
+/**
+ * Prints one journal record.
+ */
+static void _journalPrintRecord(const struct JournalRecord *record, void *context) {
+    FILE *output = context;
+    fprintf(output, "%llu %s %d", (unsigned long long)record->lsn, journal_op_names[record->op], record->id);
+    for (int i = 0; i < journal_op_args[record->op]; i++) {
+        fprintf(output, " %d", record->args[i]);
+    }
+    fprintf(output, "\n");
+}
+
+bool journal_print(const char *path, FILE *output) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        return false;
+    }
+    off_t valid_bytes;
+    bool ok = _journalScan(fd, &valid_bytes, _journalPrintRecord, output);
+    close(fd);
+    return ok;
+}
+
+#endif
@@ -0,0 +1,111 @@
+/**
+ * Process manager journal header file.
+ * Append-only write-ahead journal of every change made to the process table, in a fixed-size
+ * binary record format. Records are group-committed: a background thread writes everything
+ * appended so far with one write + fdatasync once the oldest unwritten record reaches the
+ * latency budget, so the cost of syncing is shared by every operation in the group.
+ * Replaying the journal on startup rebuilds the table. Linux/Unix only.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "process_table.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define JOURNAL_BUDGET_US 1000      // Default group commit latency budget in microseconds.
+#define JOURNAL_BUFFER_RECORDS 8192 // Records per group commit buffer.
+
+enum JournalOp {
+    JOURNAL_CREATE = 1,     // args: priority, start time, work time, task (0 if none)
+    JOURNAL_SCHEDULE,       // args: current state, next state
+    JOURNAL_TERMINATE,
+    JOURNAL_DISPATCH,       // Ready -> Running, chosen by pm_dispatch
+    JOURNAL_PRIORITY,       // args: priority
+    JOURNAL_TERMINATE_WHERE,// id: filter state, args: min/max priority, min/max start time
+    JOURNAL_UNBLOCK_ALL     // no arguments
+};
+
+/**
+ * One journal record, 40 bytes on disk.
+ */
+struct JournalRecord {
+    uint64_t lsn;           // Log sequence number, starts at 1 and increases by 1 per record.
+    uint32_t op;            // enum JournalOp.
+    int32_t id;             // Process ID.
+    int32_t args[4];        // Unused arguments are 0.
+    uint32_t reserved;      // 0, keeps records 8-byte aligned.
+    uint32_t checksum;      // FNV-1a of the bytes before it, catches a torn last record.
+};
+
+/**
+ * Replays a journal into a table, skipping records already contained in the table.
+ * Replay stops at the first record that is torn or out of sequence (the tail of a write that
+ * never completed), and the file is truncated there so new records can be appended after it.
+ *
+ * @param table Initialized process table.
+ * @param path Journal file, a missing file counts as empty.
+ * @param after_lsn Records up to and including this LSN are skipped (0 to replay everything).
+ * @param last_lsn Receives the LSN of the last valid record (after_lsn if there are none).
+ * @return bool False if the file could not be read or repaired.
+ */
+bool journal_replay(struct ProcessTable *table, const char *path, uint64_t after_lsn, uint64_t *last_lsn);
+
+/**
+ * Opens a journal for appending and starts the group commit thread.
+ *
+ * @param path Journal file, created if missing.
+ * @param last_lsn LSN of the last record already in the file (from journal_replay).
+ * @param budget_us Longest time in microseconds a record may wait before it is written and synced.
+ * @return bool False if the file or the thread could not be opened.
+ */
+bool journal_open(const char *path, uint64_t last_lsn, int budget_us);
+
+/**
+ * Appends a record. Returns as soon as the record is buffered, it becomes durable with the
+ * next group commit. Does nothing if no journal is open.
+ *
+ * @param op Operation.
+ * @param id Process ID.
+ * @param arg0 First argument (see enum JournalOp).
+ * @param arg1 Second argument.
+ * @param arg2 Third argument.
+ * @param arg3 Fourth argument.
+ */
+void journal_append(enum JournalOp op, int id, int arg0, int arg1, int arg2, int arg3);
+
+/**
+ * LSN of the last record appended, matching the current contents of the table.
+ *
+ * @return uint64_t LSN, 0 if no journal is open and nothing was replayed.
+ */
+uint64_t journal_lsn();
+
+/**
+ * Waits until every record appended so far is durable.
+ *
+ * @return bool False if writing the journal failed.
+ */
+bool journal_sync();
+
+/**
+ * Syncs the journal, stops the group commit thread, and closes the file.
+ */
+void journal_close();
+
+/**
+ * Prints every valid record of a journal as text, one "<lsn> <op> <id> <args...>" line each.
+ *
+ * @param path Journal file.
+ * @param output Stream to print to.
+ * @return bool False if the file could not be read.
+ */
+bool journal_print(const char *path, FILE *output);
+
+#endif // JOURNAL_H
@@ -0,0 +1,170 @@
+/**
+ * Process manager server load generator. See README for more information.
+ * Opens a number of connections to a running server (PRM --server), each on its own thread,
+ * and sends pipelined batches of random create/schedule/terminate/query requests,
+ * reporting the request rate and the batch round-trip times.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#include "client.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define KEY_SPACE (1 << 20)     // Process IDs are drawn from [0, KEY_SPACE).
+
+struct LoadWorker {
+    pthread_t tid;
+    uint64_t seed;
+    long long requests;
+    long long batches;
+    long long errors;           // Connection failures, the worker stops after one.
+    double total_latency;       // Sum of batch round-trip times in seconds.
+    double max_latency;
+};
+
+/* Global Variables */
+const char *socket_path;
+int batch_size = 64;
+atomic_bool stop;
+
+/**
+ * xorshift64 pseudo-random generator, one state per thread.
+ */
+static uint64_t _loadRandom(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+/**
+ * Seconds on the monotonic clock.
+ */
+static double _loadNow() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * Worker thread: sends batches on its own connection until told to stop.
+ * Half of the requests are queries, the rest are split between creates, schedules, and terminates.
+ */
+void *loadWorker(void *ptr) {
+    struct LoadWorker *worker = ptr;
+    struct ProcessClient *client = malloc(sizeof(struct ProcessClient));
+    struct Response *responses = malloc(batch_size * sizeof(struct Response));
+
+    if (client == NULL || responses == NULL || !client_connect(client, socket_path)) {
+        worker->errors++;
+        free(client);
+        free(responses);
+        return NULL;
+    }
+
+    while (!atomic_load_explicit(&stop, memory_order_relaxed)) {
+        double start = _loadNow();
+        for (int i = 0; i < batch_size; i++) {
+            uint64_t r = _loadRandom(&worker->seed);
+            int id = (int)(r % KEY_SPACE);
+            int op = (int)((r >> 32) % 100);
+            if (op < 50) {
+                client_send(client, REQUEST_QUERY, id, 0, 0, 0, 0);
+            }
+            else if (op < 70) {
+                client_send(client, REQUEST_CREATE, id, (int)(r >> 48) % 10, id % 50 + 1, id % 1000 + 1, 0);
+            }
+            else if (op < 80) {
+                client_send(client, REQUEST_SCHEDULE, id, 0, 1, 0, 0);
+            }
+            else if (op < 90) {
+                client_send(client, REQUEST_SCHEDULE, id, 1, 0, 0, 0);
+            }
+            else {
+                client_send(client, REQUEST_TERMINATE, id, 0, 0, 0, 0);
+            }
+        }
+        if (!client_receive(client, responses, batch_size)) {
+            worker->errors++;
+            break;
+        }
+
+        double latency = _loadNow() - start;
+        worker->total_latency += latency;
+        if (latency > worker->max_latency) {
+            worker->max_latency = latency;
+        }
+        worker->requests += batch_size;
+        worker->batches++;
+    }
+
+    client_close(client);
+    free(client);
+    free(responses);
+    return NULL;
+}
+
+/**
+ * Main function.
+ * Usage: PRM_LOAD <socket> [connections] [seconds] [batch size]
+ *
+ * @return int Successful run returns 0, otherwise returns 1.
+ */
+int main(int argc, char *argv[]) {
+    int num_connections = (argc > 2) ? atoi(argv[2]) : 4;
+    double seconds = (argc > 3) ? atof(argv[3]) : 2.0;
+    batch_size = (argc > 4) ? atoi(argv[4]) : 64;
+    if (argc < 2 || num_connections < 1 || seconds <= 0 || batch_size < 1 || batch_size > CLIENT_QUEUE_SIZE) {
+        fprintf(stderr, "Usage: %s <socket> [connections] [seconds] [batch size (1-%d)]\n", argv[0], CLIENT_QUEUE_SIZE);
+        return 1;
+    }
+    socket_path = argv[1];
+
+    struct LoadWorker *workers = calloc(num_connections, sizeof(struct LoadWorker));
+    if (workers == NULL) {
+        return 1;
+    }
+
+    double start = _loadNow();
+    for (int i = 0; i < num_connections; i++) {
+        workers[i].seed = 0x9E3779B97F4A7C15ULL * (i + 1);
+        pthread_create(&workers[i].tid, NULL, loadWorker, &workers[i]);
+    }
+    usleep((useconds_t)(seconds * 1e6));
+    atomic_store(&stop, true);
+
+    long long requests = 0, batches = 0, errors = 0;
+    double total_latency = 0, max_latency = 0;
+    for (int i = 0; i < num_connections; i++) {
+        pthread_join(workers[i].tid, NULL);
+        requests += workers[i].requests;
+        batches += workers[i].batches;
+        errors += workers[i].errors;
+        total_latency += workers[i].total_latency;
+        if (workers[i].max_latency > max_latency) {
+            max_latency = workers[i].max_latency;
+        }
+    }
+    double elapsed = _loadNow() - start;
+    free(workers);
+
+    printf("%d connections, batches of %d, %.1f s\n", num_connections, batch_size, elapsed);
+    printf("%lld requests, %.0f requests/s\n", requests, requests / elapsed);
+    if (batches > 0) {
+        printf("batch round trip: %.1f us average, %.1f us max\n", total_latency / batches * 1e6, max_latency * 1e6);
+    }
+    if (errors > 0) {
+        printf("%lld connections failed\n", errors);
+        return 1;
+    }
+    return 0;
+}
@@ -6,29 +6,42 @@
  * @since   2024-04-13
  */
 
+#include "batch.h"
 #include "cosmetic.h"
+#include "dashboard.h"
+#include "journal.h"
+#include "manager.h"
+#include "os_process.h"
+#include "output.h"
+#include "process_table.h"
+#include "server.h"
+#include "snapshot.h"
+#include "trace.h"
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
-#include <windows.h>
 #include <stdbool.h>
-#define SIZE 100    // Default process list size.
-
-struct Process {
-    int id;
-    int state;
-    int priority;
-    int start_time;
-    int work_time;
-};
+#include <string.h>
+#include <time.h>
 
 /* Global Variables */
-struct Process process_list[SIZE];
-int num_processes = 0;  // Number of processes, used for process list indexing.
+struct ProcessTable process_table;  // Slab-allocated table that holds all processes.
+
+/**
+ * Progress of a trace import (see _importTrace).
+ */
+struct TraceImportCounts {
+    bool per_task;          // Process ID == PID, otherwise jobs are numbered.
+    int next_id;            // Next process ID to try for a numbered job.
+    uint64_t rejected;      // Jobs whose process could not be created.
+};
 
 /**
- * Prints out a user interface with four options:
- * 1. Create a New Process, 2. Schedule a Process, 3. Terminate a Process, 4. Process Information
+ * Prints out a user interface with nine options:
+ * 1. Create a New Process, 2. Schedule a Process, 3. Terminate a Process, 4. Process Information,
+ * 5. Toggle Typewriter Effect, 6. Dispatch Next Process, 7. Terminate Matching Processes,
+ * 8. Unblock All Processes, 9. Exit Program
  */
 void userInterface();
 
@@ -47,15 +60,10 @@ void createProcess();
 void scheduleProcess();
 
 /**
- * scheduleProcess helper that ensures valid scheduling inputs.
- * 
- * @param p_index Process index within the process_list.
- * @param p_id Process ID.
- * @param p_curr_state Process's current state.
- * @param p_next_state State the user wants to move the process to.
- * @return bool T/F depending on if the inputs are valid and the state movement is valid.
+ * Dispatches the highest-priority Ready process, moving it to the Running state.
+ * Lower priority value == Higher priority, ties go to the earliest start time.
  */
-bool _validateSchedule(int p_index, int p_id, int p_curr_state, int p_next_state);
+void dispatchProcess();
 
 /**
  * Terminates a process, removing it from the list of processes.
@@ -63,54 +71,355 @@ bool _validateSchedule(int p_index, int p_id, int p_curr_state, int p_next_state
 void terminateProcess();
 
 /**
- * terminateProcess helper that adjusts the process list.
- * 
- * @param p_index Index of the process to remove from the process_list.
+ * Terminates every process matching a filter in one pass.
+ * User must specify a state (or any state), a priority range, and a start time range.
  */
-void _removeProcess(int p_index);
+void terminateMatching();
+
+/**
+ * Moves every Blocked process to the Ready state in one pass.
+ */
+void unblockAll();
 
 /**
  * Prints a list of all processes with related information (ID, State, etc.)
  */
 void printProcesses();
 
+/**
+ * Loads the process table from the snapshot file if one is given and exists, otherwise starts empty,
+ * then replays and opens the journal if one is given.
+ *
+ * @param snapshot_path Snapshot file, or NULL.
+ * @param journal_path Journal file, or NULL.
+ * @param budget_us Journal group commit latency budget in microseconds.
+ * @return bool False if the table or journal could not be initialized.
+ */
+bool _loadTable(const char *snapshot_path, const char *journal_path, int budget_us);
+
+/**
+ * Creates a process for every job in a scheduler trace (see trace.h), journaling each one.
+ * In per-task mode the process ID is the task's PID, otherwise jobs are numbered from the lowest free ID.
+ *
+ * @param path Trace file, "-" for stdin.
+ * @param options Job mode and time unit.
+ * @return bool False if the trace could not be read or the table filled up.
+ */
+bool _importTrace(const char *path, const struct TraceOptions *options);
+
+/**
+ * Trace job callback for _importTrace.
+ */
+bool _importJob(const struct TraceJob *job, void *context);
+
+/**
+ * Closes the journal, writes the process table to the snapshot file if one is given, then frees the table.
+ *
+ * @param snapshot_path Snapshot file, or NULL.
+ */
+void _saveTable(const char *snapshot_path);
+
 /**
  * Main function that primarily calls userInterface.
+ * With "--batch [file]", runs a command stream from the file (or stdin) instead. See batch.h.
+ * "--quiet" only prints errors and list output in batch mode.
+ * With "--snapshot <file>", the process table is loaded from the file at startup and saved to it on exit.
+ * With "--journal <file>", every change is appended to the journal, which is replayed at startup.
+ * "--commit-us <n>" sets the journal group commit latency budget, "--dump-journal <file>" prints a journal.
+ * With "--server <socket>", serves the process table over a Unix domain socket until interrupted. See server.h.
+ * "--dashboard" shows a live dashboard of the server at the top of the terminal. See dashboard.h.
+ * With "--os [command]", every process in the interactive menu is backed by a real child process
+ * (the command, or a CPU burner) that only runs while the process is Running. See os_process.h.
+ * With "--os-run <n>", creates n processes backed by real children and runs the user-space scheduler
+ * ("--os-policy pri|rr", "--os-quantum-us n", "--os-seconds n", "--os-cpus n"), without saving the table.
+ * With "--trace <file>", a Linux scheduler trace is imported into the table at startup, one process per CPU burst
+ * ("--trace-tasks" for one per task, "--trace-unit-us n" for the length of a time unit). See trace.h.
  * 
  * @return int Successful run returns 0, otherwise returns 1.
  */
-int main() {
+int main(int argc, char *argv[]) {
+    bool batch_mode = false;
+    char *batch_path = NULL;
+    struct BatchOptions options = { false, NULL };
+    char *journal_path = NULL;
+    char *server_path = NULL;
+    bool show_dashboard = false;
+    int budget_us = JOURNAL_BUDGET_US;
+    bool os_mode = false;
+    int os_run = 0;
+    struct OspOptions os_options = { OSP_PRIORITY, OSP_DEFAULT_QUANTUM_US, OSP_DEFAULT_SECONDS, 1 };
+    char *trace_path = NULL;
+    struct TraceOptions trace_options = { false, TRACE_DEFAULT_UNIT_US };
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--batch") == 0) {
+            batch_mode = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                batch_path = argv[++i];
+            }
+        }
+        else if (strcmp(argv[i], "--quiet") == 0) {
+            options.quiet = true;
+        }
+        else if (strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc) {
+            options.snapshot_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--journal") == 0 && i + 1 < argc) {
+            journal_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--commit-us") == 0 && i + 1 < argc && atoi(argv[i + 1]) >= 0) {
+            budget_us = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--server") == 0 && i + 1 < argc) {
+            server_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--dashboard") == 0) {
+            show_dashboard = true;
+        }
+        else if (strcmp(argv[i], "--os") == 0) {
+            os_mode = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                osp_enable(argv[++i]);
+            }
+        }
+        else if (strcmp(argv[i], "--os-run") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+            os_run = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--os-policy") == 0 && i + 1 < argc
+                 && (strcmp(argv[i + 1], "pri") == 0 || strcmp(argv[i + 1], "rr") == 0)) {
+            os_options.policy = (strcmp(argv[++i], "rr") == 0) ? OSP_ROUND_ROBIN : OSP_PRIORITY;
+        }
+        else if (strcmp(argv[i], "--os-quantum-us") == 0 && i + 1 < argc && atol(argv[i + 1]) > 0) {
+            os_options.quantum_us = atol(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--os-seconds") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+            os_options.seconds = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--os-cpus") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+            os_options.cpus = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--trace-tasks") == 0) {
+            trace_options.per_task = true;
+        }
+        else if (strcmp(argv[i], "--trace-unit-us") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+            trace_options.unit_us = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--dump-journal") == 0 && i + 1 < argc) {
+            return journal_print(argv[i + 1], stdout) ? 0 : 1;
+        }
+        else if (strcmp(argv[i], "-") != 0) {
+            fprintf(stderr, "Usage: %s [--batch [file]] [--quiet] [--snapshot file] [--journal file] [--commit-us n] [--dump-journal file] [--server socket] [--dashboard] [--os [command]] [--os-run n [--os-policy pri|rr] [--os-quantum-us n] [--os-seconds n] [--os-cpus n]] [--trace file [--trace-tasks] [--trace-unit-us n]]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (!_loadTable(options.snapshot_path, journal_path, budget_us)) {
+        return 1;
+    }
+    if (trace_path != NULL && !_importTrace(trace_path, &trace_options)) {
+        _saveTable(NULL);
+        return 1;
+    }
+
+    if (os_run > 0) {
+        if (os_run > OSP_MAX_PROCESSES) {
+            fprintf(stderr, "os_process: at most %d processes\n", OSP_MAX_PROCESSES);
+            _saveTable(NULL);
+            return 1;
+        }
+        // Priorities cycle through 0-3, so the priority policy has something to choose between.
+        for (int id = 0, created = 0; created < os_run; id++) {
+            if (pm_create(&process_table, id, id % 4, id + 1, 1) == PM_OK) {
+                created++;
+            }
+        }
+        int result = runOsScheduler(&process_table, &os_options);
+        _saveTable(NULL);
+        return result;
+    }
+
+    if (server_path != NULL) {
+        if (show_dashboard) {
+            dashboard_setup("PROCESS MANAGER SERVER", "REQUESTS", "BATCH TIME (US)", 1);
+            dashboard_add_queue("BLOCKED");
+            dashboard_add_queue("READY");
+            dashboard_add_queue("RUNNING");
+            dashboard_start(DASHBOARD_DEFAULT_FPS);
+        }
+        int result = runServer(&process_table, server_path);
+        dashboard_stop();
+        _saveTable(options.snapshot_path);
+        return result;
+    }
+
+    if (batch_mode) {
+        FILE *input = (batch_path != NULL) ? fopen(batch_path, "rb") : stdin;
+        if (input == NULL) {
+            perror(batch_path);
+            _saveTable(NULL);
+            return 1;
+        }
+        // Results are written by the output thread, so a slow reader (e.g. a pipe to less) does not stall the batch.
+        output_start(OUTPUT_BLOCK);
+        runBatch(&process_table, input, &options);
+        output_stop();
+        if (input != stdin) {
+            fclose(input);
+        }
+        _saveTable(options.snapshot_path);
+        return 0;
+    }
+
+    if (os_mode && !osp_enabled() && !osp_enable(NULL)) {
+        _saveTable(NULL);
+        return 1;
+    }
+    if (!osp_sync(&process_table)) {
+        osp_shutdown();
+        _saveTable(NULL);
+        return 1;
+    }
+
+    _renderInit();
     _clearTerminal();
 
     char *intro_text_1    = "PROCESS MANAGEMENT SIMULATION     ";
     char *intro_text_2    = "KENNETH WALLACE - CSCI 485        ";
     char *exit_text       = "EXITING PROGRAM ! ! !";
     
-    printf("\033[30m"); // black text
-    printf("\033[41m"); // red background
+    _textColor("\033[30m"); // black text
+    _textColor("\033[41m"); // red background
     _typewriterPrint(intro_text_1, 3);
     _typewriterPrint(intro_text_2, 2);
     
-    printf("\033[0m");  // normal text and background
+    _textColor("\033[0m");  // normal text and background
     userInterface();
 
-    printf("\033[32m"); // green text
+    _textColor("\033[32m"); // green text
     _typewriterPrint(exit_text, 2);
-    printf("\033[0m\n");  // default text
+    _textColor("\033[0m");  // default text
+    printf("\n");
+    osp_shutdown();
+    _saveTable(options.snapshot_path);
     return 0;
 }
 
+bool _loadTable(const char *snapshot_path, const char *journal_path, int budget_us) {
+    uint64_t lsn = 0;
+    bool loaded = false;
+    if (snapshot_path != NULL) {
+        struct timespec start, finish;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        loaded = snapshot_load(&process_table, snapshot_path, &lsn);
+        if (loaded) {
+            clock_gettime(CLOCK_MONOTONIC, &finish);
+            double ms = (finish.tv_sec - start.tv_sec) * 1e3 + (finish.tv_nsec - start.tv_nsec) / 1e6;
+            fprintf(stderr, "snapshot: loaded %u processes from %s in %.3f ms\n", process_table.count, snapshot_path, ms);
+        }
+    }
+    if (!loaded && !pt_init(&process_table)) {
+        return false;
+    }
+
+    // Records after the snapshot's LSN are changes made since the snapshot was taken.
+    if (journal_path != NULL &&
+        (!journal_replay(&process_table, journal_path, lsn, &lsn) || !journal_open(journal_path, lsn, budget_us))) {
+        pt_destroy(&process_table);
+        snapshot_unmap();
+        return false;
+    }
+    return true;
+}
+
+bool _importTrace(const char *path, const struct TraceOptions *options) {
+    FILE *input = (strcmp(path, "-") == 0) ? stdin : fopen(path, "rb");
+    if (input == NULL) {
+        perror(path);
+        return false;
+    }
+    struct TraceImportCounts counts = { options->per_task, 0, 0 };
+    struct TraceStats stats;
+    enum TraceResult result = trace_import(input, options, _importJob, &counts, &stats);
+    if (input != stdin) {
+        fclose(input);
+    }
+
+    fprintf(stderr, "trace: %llu processes from %llu events (%llu lines, %.1f MB) in %.3f s, %.0f MB/s\n",
+            (unsigned long long)(stats.jobs - counts.rejected), (unsigned long long)stats.events,
+            (unsigned long long)stats.lines, stats.bytes / 1e6, stats.seconds,
+            (stats.seconds > 0) ? stats.bytes / 1e6 / stats.seconds : 0.0);
+    if (counts.rejected > 0 || stats.partial > 0) {
+        fprintf(stderr, "trace: %llu jobs rejected (ID taken), %llu bursts cut off by the start of the trace\n",
+                (unsigned long long)counts.rejected, (unsigned long long)stats.partial);
+    }
+    if (result != TRACE_OK) {
+        fprintf(stderr, "trace: %s\n", (result == TRACE_ERR_STOPPED) ? "process table full" : trace_error(result));
+        return false;
+    }
+    return true;
+}
+
+bool _importJob(const struct TraceJob *job, void *context) {
+    struct TraceImportCounts *counts = context;
+    int id = job->pid;
+    enum ManagerResult result;
+    if (counts->per_task) {
+        result = pm_create(&process_table, id, job->priority, job->arrival_time, job->burst_time);
+    }
+    else {
+        do {
+            if (counts->next_id == INT_MAX) {
+                return false;
+            }
+            id = counts->next_id++;
+            result = pm_create(&process_table, id, job->priority, job->arrival_time, job->burst_time);
+        } while (result == PM_ERR_EXISTS);
+        // Every burst of a task is estimated from the ones before it (see SCHED_PSJF).
+        if (result == PM_OK) {
+            pm_set_task(&process_table, id, job->pid);
+        }
+    }
+
+    if (result == PM_ERR_FULL) {
+        return false;
+    }
+    if (result != PM_OK) {
+        counts->rejected++;
+        return true;
+    }
+    journal_append(JOURNAL_CREATE, id, job->priority, job->arrival_time, job->burst_time, counts->per_task ? 0 : job->pid);
+    return true;
+}
+
+void _saveTable(const char *snapshot_path) {
+    journal_close();
+    if (snapshot_path != NULL) {
+        snapshot_wait();
+        if (!snapshot_save(&process_table, snapshot_path, journal_lsn()) || !snapshot_wait()) {
+            fprintf(stderr, "snapshot: could not save %s\n", snapshot_path);
+        }
+    }
+    pt_destroy(&process_table);
+    snapshot_unmap();
+}
+
 void userInterface() {
     int user_option = -1;
 
-    while (user_option != 6) {
+    while (user_option != 9) {
         char *option_menu = "PLEASE INPUT A COMMAND:";
         char *option_1    = "> [1] CREATE A NEW PROCESS";
         char *option_2    = "> [2] SCHEDULE A PROCESS";
         char *option_3    = "> [3] TERMINATE A PROCESS";
         char *option_4    = "> [4] PRINT PROCESS INFORMATION";
         char *option_5    = "> [5] TOGGLE TYPEWRITER EFFECT";
-        char *option_6    = "> [6] EXIT PROGRAM";
+        char *option_6    = "> [6] DISPATCH NEXT PROCESS";
+        char *option_7    = "> [7] TERMINATE MATCHING PROCESSES";
+        char *option_8    = "> [8] UNBLOCK ALL PROCESSES";
+        char *option_9    = "> [9] EXIT PROGRAM";
         char *invalid     = "INVALID COMMAND ! ! !";
 
         _typewriterPrint(option_menu, 2);
@@ -120,11 +429,15 @@ void userInterface() {
         _typewriterPrint(option_4, 1);
         _typewriterPrint(option_5, 1);
         _typewriterPrint(option_6, 1);
+        _typewriterPrint(option_7, 1);
+        _typewriterPrint(option_8, 1);
+        _typewriterPrint(option_9, 1);
         printf("\n\n  User > ");
 
         scanf("%d", &user_option);
+        _skipLine();
 
-        _removeLines(10);
+        _removeLines(13);
         switch (user_option) {
             case 1:
                 printf("  User > [1] CREATE A NEW PROCESS");
@@ -147,14 +460,27 @@ void userInterface() {
                 _toggleDelay();
                 break;
             case 6:
-                printf("  User > [6] EXIT PROGRAM");
+                printf("  User > [6] DISPATCH NEXT PROCESS");
+                dispatchProcess();
+                break;
+            case 7:
+                printf("  User > [7] TERMINATE MATCHING PROCESSES");
+                terminateMatching();
+                break;
+            case 8:
+                printf("  User > [8] UNBLOCK ALL PROCESSES");
+                unblockAll();
+                break;
+            case 9:
+                printf("  User > [9] EXIT PROGRAM");
                 return;
             default:
                 printf("  User > [%d]", user_option);
-                printf("\033[31m"); // red text
+                _textColor("\033[31m"); // red text
                 _typewriterPrint(invalid, 2);
-                printf("\033[0m");  // default text
+                _textColor("\033[0m");  // default text
         }
+        osp_sync(&process_table);
     }
 }
 
@@ -202,57 +528,23 @@ void createProcess() {
     _removeLines(4);
     printf("  User > NEW PROCESS WORK TIME: %d", p_work_time);
 
-    // Check if process id is valid (>= 0) (< 2147483647).
-    if (p_id < 0) {
-        printf("\033[31m"); // red text
-        _typewriterPrint(error_1, 2);
-        printf("\033[0m");  // default text
-        return;
+    char *error = NULL;
+    switch (pm_create(&process_table, p_id, p_priority, p_start_time, p_work_time)) {
+        case PM_ERR_ID_NEGATIVE:    error = error_1; break;
+        case PM_ERR_EXISTS:         error = error_2; break;
+        case PM_ERR_TIMES:          error = error_3; break;
+        case PM_ERR_FULL:           error = error_4; break;
+        case PM_ERR_ID_LIMIT:       error = error_5; break;
+        default:                    break;
     }
-    else if (p_id >= 2147483647) {
-        printf("\033[31m"); // red text
-        _typewriterPrint(error_5, 2);
-        printf("\033[0m");  // default text
+    if (error != NULL) {
+        _textColor("\033[31m"); // red text
+        _typewriterPrint(error, 2);
+        _textColor("\033[0m");  // default text
         return;
     }
-    
-
-    // Check if process exists.
-    for (int i = 0; i < num_processes; i++) {
-        if (process_list[i].id == p_id) {
-            printf("\033[31m"); // red text
-            _typewriterPrint(error_2, 2);
-            printf("\033[0m");  // default text
-            return;
-        }
-    }
-
-    // Check if Start Time and Work Time are valid (> 0).
-    if (p_start_time <= 0 || p_work_time <= 0) {
-        printf("\033[31m"); // red text
-        _typewriterPrint(error_3, 2);
-        printf("\033[0m");  // default text
-        return;
-    }
-
-    struct Process new_process;
-    new_process.id = p_id;
-    new_process.state = 0;
-    new_process.priority = p_priority;
-    new_process.start_time = p_start_time;
-    new_process.work_time = p_work_time;
-
-    // Check if process list is full.
-    if (num_processes >= SIZE) {
-        printf("\033[31m"); // red text
-        _typewriterPrint(error_4, 2);
-        printf("\033[0m");  // default text
-        return;
-    }
-
-    process_list[num_processes] = new_process;
-    num_processes++;
 
+    journal_append(JOURNAL_CREATE, p_id, p_priority, p_start_time, p_work_time, 0);
     printf("\n\n  Syst > Sucessfully created process %d with priority %d, start time %d, and work time %d.", p_id, p_priority, p_start_time, p_work_time);
 }
 
@@ -260,7 +552,6 @@ void scheduleProcess() {
     int p_id;
     int p_curr_state;
     int p_next_state;
-    int p_index = -1;
 
     char *schedule_1    = "PLEASE ENTER PROCESS ID:";
     char *schedule_2    = "PLEASE ENTER CURRENT STATE: (Blocked = -1, Ready = 0, Running = 1)";
@@ -289,82 +580,41 @@ void scheduleProcess() {
     _removeLines(4);
     printf("  User > TO NEW STATE: %d", p_next_state);
 
-    // Check if process exists.
-    for (int i = 0; i < num_processes; i++) {
-        if (process_list[i].id == p_id) {
-            p_index = i;
-            break;
-        }
-    }
-    if (p_index == -1) {
-        printf("\033[31m"); // red text
-        _typewriterPrint(error_1, 2);
-        printf("\033[0m");  // default text
-        return;
+    char *error = NULL;
+    switch (pm_schedule(&process_table, p_id, p_curr_state, p_next_state)) {
+        case PM_ERR_NOT_FOUND:      error = error_1; break;
+        case PM_ERR_SCHEDULE:       error = error_2; break;
+        default:                    break;
     }
-
-    // Validate user input.
-    bool valid = _validateSchedule(p_index, p_id, p_curr_state, p_next_state);
-    if (!valid) {
-        printf("\033[31m"); // red text
-        _typewriterPrint(error_2, 2);
-        printf("\033[0m");  // default text
+    if (error != NULL) {
+        _textColor("\033[31m"); // red text
+        _typewriterPrint(error, 2);
+        _textColor("\033[0m");  // default text
         return;
     }
 
-    process_list[p_index].state = p_next_state;
+    journal_append(JOURNAL_SCHEDULE, p_id, p_curr_state, p_next_state, 0, 0);
     printf("\n\n  Syst > Sucessfully moved process %d from state %d to state %d.", p_id, p_curr_state, p_next_state);
 }
 
-bool _validateSchedule(int p_index, int p_id, int p_curr_state, int p_next_state) {
-    // Check if state inputs are valid
-    if (p_curr_state > 1 || p_curr_state < -1) {
-        return false;
-    }
-    else if (p_next_state > 1 || p_next_state < -1) {
-        return false;
-    }
-    
-    // Check if current state matches
-    if (process_list[p_index].state != p_curr_state) {
-        return false;
-    }
+void dispatchProcess() {
+    int p_id;
 
-    // Check if valid next state
-    switch (p_curr_state) {
-        case -1:    // Blocked.
-            switch (p_next_state) {
-                case -1:
-                    return false;
-                case 0:
-                    return true;
-                case 1:
-                    return false;
-            }
-        case 0:     // Ready.
-            switch (p_next_state) {
-                case -1:
-                    return false;
-                case 0:
-                    return false;
-                case 1:
-                    return true;
-            }
-        case 1:     // Running.
-            switch (p_next_state) {
-                case -1:
-                    return true;
-                case 0:
-                    return true;
-                case 1:
-                    return false;
-            }
+    char *error_1   = "NO PROCESS IS READY ! ! !";
+
+    if (pm_dispatch(&process_table, &p_id) != PM_OK) {
+        _textColor("\033[31m"); // red text
+        _typewriterPrint(error_1, 2);
+        _textColor("\033[0m");  // default text
+        return;
     }
+
+    journal_append(JOURNAL_DISPATCH, p_id, 0, 0, 0, 0);
+    printf("\n\n  Syst > Successfully dispatched process %d, moved from state 0 to state 1.", p_id);
 }
 
 void terminateProcess() {
     int p_id;
-    int p_index = -1;
 
     char *remove_1  = "PLEASE ENTER THE ID OF THE PROCESS TO TERMINATE:";
     char *error_1   = "PROCESS NOT FOUND ! ! !";
@@ -376,55 +626,94 @@ void terminateProcess() {
     _removeLines(4);
     printf("  User > TERMINATE PROCESS: %d", p_id);
 
-    // Check if process exists.
-    for (int i = 0; i < num_processes; i++) {
-        if (process_list[i].id == p_id) {
-            p_index = i;
-            break;
-        }
-    }
-    if (p_index == -1) {
-        printf("\033[31m"); // red text
+    if (pm_terminate(&process_table, p_id) != PM_OK) {
+        _textColor("\033[31m"); // red text
         _typewriterPrint(error_1, 2);
-        printf("\033[0m");  // default text
+        _textColor("\033[0m");  // default text
         return;
     }
 
-    _removeProcess(p_index);
-
+    journal_append(JOURNAL_TERMINATE, p_id, 0, 0, 0, 0);
     printf("\n\n  Syst > Successfully terminated process %d.", p_id);
 }
 
-void _removeProcess(int p_index) {
-    for (int i = p_index; i < num_processes - 1; i++) {
-        process_list[i] = process_list[i + 1];
+void terminateMatching() {
+    struct ProcessFilter filter;
+    uint32_t count;
+
+    char *match_1   = "PLEASE ENTER STATE TO MATCH: (Blocked = -1, Ready = 0, Running = 1, Any = 2)";
+    char *match_2   = "PLEASE ENTER LOWEST AND HIGHEST PRIORITY TO MATCH:";
+    char *match_3   = "PLEASE ENTER EARLIEST AND LATEST START TIME TO MATCH:";
+    char *error_1   = "STATE INPUT NOT VALID ! ! !";
+
+    _typewriterPrint(match_1, 2);
+    printf("\n\n  User > ");
+    scanf("%d", &filter.state);
+
+    _removeLines(4);
+    printf("  User > MATCH STATE: %d", filter.state);
+
+    _typewriterPrint(match_2, 2);
+    printf("\n\n  User > ");
+    scanf("%d %d", &filter.priority_min, &filter.priority_max);
+
+    _removeLines(4);
+    printf("  User > MATCH PRIORITY: %d TO %d", filter.priority_min, filter.priority_max);
+
+    _typewriterPrint(match_3, 2);
+    printf("\n\n  User > ");
+    scanf("%d %d", &filter.start_min, &filter.start_max);
+
+    _removeLines(4);
+    printf("  User > MATCH START TIME: %d TO %d", filter.start_min, filter.start_max);
+
+    if (pm_terminate_where(&process_table, &filter, &count) != PM_OK) {
+        _textColor("\033[31m"); // red text
+        _typewriterPrint(error_1, 2);
+        _textColor("\033[0m");  // default text
+        return;
     }
 
-    num_processes--;
+    if (count > 0) {
+        journal_append(JOURNAL_TERMINATE_WHERE, filter.state, filter.priority_min, filter.priority_max, filter.start_min, filter.start_max);
+    }
+    printf("\n\n  Syst > Successfully terminated %u matching processes.", count);
 }
 
-void printProcesses() {
-    /* If you are reading this, I was too lazy to create a separate function for printing borders. */
-    // Top Border
-    printf("\n\n");
-    printf("  ");
-    for (int i = 0; i < 48; i++) { printf("="); }
-    printf("\n");
-    printf("  | ----ID---- | STATE | PRIORITY | START | WORK |\n");
-    printf("  ");
-    for (int i = 0; i < 48; i++) { printf("="); }
-    printf("\n");
+void unblockAll() {
+    uint32_t count;
+
+    pm_unblock_all(&process_table, &count);
+    if (count > 0) {
+        journal_append(JOURNAL_UNBLOCK_ALL, 0, 0, 0, 0, 0);
+    }
+    printf("\n\n  Syst > Successfully moved %u processes from state -1 to state 0.", count);
+}
 
-    for (int i = 0; i < num_processes; i++) {
-        int p_id = process_list[i].id;
-        int p_state = process_list[i].state;
-        int p_priority = process_list[i].priority;
-        int p_start = process_list[i].start_time;
-        int p_work = process_list[i].work_time;
-        printf("  | %-10d | %-5d | %-8d | %-5d | %-4d |\n", p_id, p_state, p_priority, p_start, p_work);
+void printProcesses() {
+    // The whole table is composed into one frame and written at once (a page at a time on a terminal).
+    char border[52];
+    memset(border, '=', 48);
+    border[48] = '\0';
+
+    _frameBegin();
+    _frameAppend("\n\n  %s\n", border);
+    _frameAppend("  | ----ID---- | STATE | PRIORITY | START | WORK |\n");
+    _frameAppend("  %s\n", border);
+
+    for (ProcessHandle h = pt_first(&process_table); h != PT_NULL_HANDLE; h = pt_next(&process_table, h)) {
+        struct Process *process = pt_get(&process_table, h);
+        int p_id = process->id;
+        int p_state = process->state;
+        int p_priority = process->priority;
+        int p_start = process->start_time;
+        int p_work = process->work_time;
+        if (!_frameRow("  | %-10d | %-5d | %-8d | %-5d | %-4d |\n", p_id, p_state, p_priority, p_start, p_work)) {
+            break;
+        }
     }
 
     // Bottom Border
-    printf("  ");
-    for (int i = 0; i < 48; i++) { printf("="); }
+    _frameAppend("  %s", border);
+    _frameEnd();
 }
@@ -0,0 +1,157 @@
+/**
+ * Process manager operations implementation file.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#include "manager.h"
+#include <stdbool.h>
+
+/**
+ * Valid state movements, indexed [current state + 1][next state + 1].
+ * Blocked -> Ready, Ready -> Running, Running -> Blocked or Ready.
+ */
+static const bool valid_transitions[PT_NUM_STATES][PT_NUM_STATES] = {
+    /* Blocked */   { false, true,  false },
+    /* Ready   */   { false, false, true  },
+    /* Running */   { true,  true,  false }
+};
+
+/**
+ * pm_schedule helper that ensures valid scheduling inputs with a constant-time table lookup.
+ *
+ * @param process Process to schedule.
+ * @param p_curr_state Process's current state.
+ * @param p_next_state State the user wants to move the process to.
+ * @return bool T/F depending on if the inputs are valid and the state movement is valid.
+ */
+static bool _validateSchedule(const struct Process *process, int p_curr_state, int p_next_state) {
+    // Check if state inputs are valid (-1, 0, or 1) and the current state matches.
+    if ((unsigned)(p_curr_state + 1) >= PT_NUM_STATES || (unsigned)(p_next_state + 1) >= PT_NUM_STATES) {
+        return false;
+    }
+    if (process->state != p_curr_state) {
+        return false;
+    }
+    return valid_transitions[p_curr_state + 1][p_next_state + 1];
+}
+
+/**
+ * pm_terminate helper that releases the process's slot in O(1).
+ *
+ * @param table Process table.
+ * @param p_handle Handle of the process to remove.
+ */
+static void _removeProcess(struct ProcessTable *table, ProcessHandle p_handle) {
+    pt_remove(table, p_handle);
+}
+
+enum ManagerResult pm_create(struct ProcessTable *table, int id, int priority, int start_time, int work_time) {
+    // Check if process id is valid (>= 0) (< 2147483647).
+    if (id < 0) {
+        return PM_ERR_ID_NEGATIVE;
+    }
+    else if (id >= 2147483647) {
+        return PM_ERR_ID_LIMIT;
+    }
+
+    // Check if process exists.
+    if (pt_find(table, id) != PT_NULL_HANDLE) {
+        return PM_ERR_EXISTS;
+    }
+
+    // Check if Start Time and Work Time are valid (> 0).
+    if (start_time <= 0 || work_time <= 0) {
+        return PM_ERR_TIMES;
+    }
+
+    struct Process new_process;
+    new_process.id = id;
+    new_process.state = 0;
+    new_process.priority = priority;
+    new_process.start_time = start_time;
+    new_process.work_time = work_time;
+    new_process.finish_time = 0;
+    new_process.turnaround_time = 0;
+    new_process.waiting_time = 0;
+    new_process.task = 0;
+
+    // Insert the process, fails if the process table is full.
+    if (pt_insert(table, &new_process) == PT_NULL_HANDLE) {
+        return PM_ERR_FULL;
+    }
+    return PM_OK;
+}
+
+enum ManagerResult pm_schedule(struct ProcessTable *table, int id, int curr_state, int next_state) {
+    ProcessHandle p_handle = pt_find(table, id);
+    if (p_handle == PT_NULL_HANDLE) {
+        return PM_ERR_NOT_FOUND;
+    }
+
+    struct Process *process = pt_get(table, p_handle);
+    if (!_validateSchedule(process, curr_state, next_state)) {
+        return PM_ERR_SCHEDULE;
+    }
+
+    pt_set_state(table, p_handle, next_state);
+    return PM_OK;
+}
+
+enum ManagerResult pm_dispatch(struct ProcessTable *table, int *id) {
+    ProcessHandle p_handle = pt_ready_top(table);
+    if (p_handle == PT_NULL_HANDLE) {
+        return PM_ERR_NONE_READY;
+    }
+
+    *id = pt_get(table, p_handle)->id;
+    pt_set_state(table, p_handle, 1);
+    return PM_OK;
+}
+
+enum ManagerResult pm_set_priority(struct ProcessTable *table, int id, int priority) {
+    ProcessHandle p_handle = pt_find(table, id);
+    if (p_handle == PT_NULL_HANDLE) {
+        return PM_ERR_NOT_FOUND;
+    }
+
+    pt_set_priority(table, p_handle, priority);
+    return PM_OK;
+}
+
+enum ManagerResult pm_set_task(struct ProcessTable *table, int id, int task) {
+    ProcessHandle p_handle = pt_find(table, id);
+    if (p_handle == PT_NULL_HANDLE) {
+        return PM_ERR_NOT_FOUND;
+    }
+
+    pt_get(table, p_handle)->task = task;
+    return PM_OK;
+}
+
+enum ManagerResult pm_terminate(struct ProcessTable *table, int id) {
+    ProcessHandle p_handle = pt_find(table, id);
+    if (p_handle == PT_NULL_HANDLE) {
+        return PM_ERR_NOT_FOUND;
+    }
+
+    _removeProcess(table, p_handle);
+    return PM_OK;
+}
+
+enum ManagerResult pm_terminate_where(struct ProcessTable *table, const struct ProcessFilter *filter, uint32_t *count) {
+    *count = 0;
+    if ((unsigned)(filter->state + 1) >= PT_NUM_STATES && filter->state != PT_ANY_STATE) {
+        return PM_ERR_SCHEDULE;
+    }
+
+    *count = pt_remove_where(table, filter);
+    return PM_OK;
+}
+
+enum ManagerResult pm_unblock_all(struct ProcessTable *table, uint32_t *count) {
+    *count = pt_move_state(table, -1, 0);
+    return PM_OK;
+}
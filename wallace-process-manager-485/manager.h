@@ -0,0 +1,112 @@
+/**
+ * Process manager operations header file.
+ * Creating, scheduling, and terminating processes without any user interface, shared by
+ * the interactive menu and the batch command stream.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#ifndef MANAGER_H
+#define MANAGER_H
+
+#include "process_table.h"
+
+/**
+ * Result of a process manager operation.
+ */
+enum ManagerResult {
+    PM_OK = 0,
+    PM_ERR_ID_NEGATIVE,     // Process ID is below 0.
+    PM_ERR_ID_LIMIT,        // Process ID is at or above the integer limit.
+    PM_ERR_EXISTS,          // Process with that ID already exists.
+    PM_ERR_TIMES,           // Start time or work time is not above 0.
+    PM_ERR_FULL,            // Process table is full.
+    PM_ERR_NOT_FOUND,       // No process with that ID.
+    PM_ERR_SCHEDULE,        // Invalid state or state movement.
+    PM_ERR_NONE_READY       // No process is Ready to be dispatched.
+};
+
+/**
+ * Creates a new process in the Ready state.
+ *
+ * @param table Process table.
+ * @param id Process ID (>= 0).
+ * @param priority Process priority.
+ * @param start_time Process start time (> 0).
+ * @param work_time Process work time (> 0).
+ * @return enum ManagerResult PM_OK, or the first validation that failed.
+ */
+enum ManagerResult pm_create(struct ProcessTable *table, int id, int priority, int start_time, int work_time);
+
+/**
+ * Moves a process from its current state to a new state.
+ *
+ * @param table Process table.
+ * @param id Process ID.
+ * @param curr_state State the process is expected to be in.
+ * @param next_state State to move the process to.
+ * @return enum ManagerResult PM_OK, PM_ERR_NOT_FOUND, or PM_ERR_SCHEDULE.
+ */
+enum ManagerResult pm_schedule(struct ProcessTable *table, int id, int curr_state, int next_state);
+
+/**
+ * Dispatches the highest-priority Ready process (lowest priority value, earliest start time),
+ * moving it from Ready to Running in O(log n).
+ *
+ * @param table Process table.
+ * @param id Set to the ID of the dispatched process.
+ * @return enum ManagerResult PM_OK or PM_ERR_NONE_READY.
+ */
+enum ManagerResult pm_dispatch(struct ProcessTable *table, int *id);
+
+/**
+ * Changes the priority of a process in O(log n).
+ *
+ * @param table Process table.
+ * @param id Process ID.
+ * @param priority New priority (lower value == higher priority).
+ * @return enum ManagerResult PM_OK or PM_ERR_NOT_FOUND.
+ */
+enum ManagerResult pm_set_priority(struct ProcessTable *table, int id, int priority);
+
+/**
+ * Makes a process one CPU burst of a task, for the predictive scheduling algorithms (see schedule.h).
+ *
+ * @param table Process table.
+ * @param id Process ID.
+ * @param task Task ID, 0 for a task of its own.
+ * @return enum ManagerResult PM_OK or PM_ERR_NOT_FOUND.
+ */
+enum ManagerResult pm_set_task(struct ProcessTable *table, int id, int task);
+
+/**
+ * Terminates a process, removing it from the process table.
+ *
+ * @param table Process table.
+ * @param id Process ID.
+ * @return enum ManagerResult PM_OK or PM_ERR_NOT_FOUND.
+ */
+enum ManagerResult pm_terminate(struct ProcessTable *table, int id);
+
+/**
+ * Terminates every process matching a filter in one pass over the table.
+ *
+ * @param table Process table.
+ * @param filter State (-1, 0, 1, or PT_ANY_STATE), priority range, and start time range to match.
+ * @param count Set to the number of processes terminated.
+ * @return enum ManagerResult PM_OK or PM_ERR_SCHEDULE if the filter state is invalid.
+ */
+enum ManagerResult pm_terminate_where(struct ProcessTable *table, const struct ProcessFilter *filter, uint32_t *count);
+
+/**
+ * Moves every Blocked process to Ready in one pass, keeping their order.
+ *
+ * @param table Process table.
+ * @param count Set to the number of processes moved.
+ * @return enum ManagerResult PM_OK.
+ */
+enum ManagerResult pm_unblock_all(struct ProcessTable *table, uint32_t *count);
+
+#endif // MANAGER_H
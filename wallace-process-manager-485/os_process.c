@@ -0,0 +1,561 @@
+/**
+ * Real OS process implementation file.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#include "os_process.h"
+#include "manager.h"
+#include <stdio.h>
+
+#ifdef _WIN32
+
+bool osp_enable(const char *command) {
+    fprintf(stderr, "os_process: not supported on Windows\n");
+    return false;
+}
+
+bool osp_enabled() {
+    return false;
+}
+
+bool osp_sync(const struct ProcessTable *table) {
+    return true;
+}
+
+void osp_shutdown() {
+}
+
+int runOsScheduler(struct ProcessTable *table, const struct OspOptions *options) {
+    fprintf(stderr, "os_process: not supported on Windows\n");
+    return 1;
+}
+
+#else
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/timerfd.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define OSP_SLOTS (2 * OSP_MAX_PROCESSES)  // Child index slots (power of two, at most half full).
+#define OSP_SLOT_BITS 13
+
+/**
+ * Child process backing one process. Signals go to the child's process group, so the children
+ * of a shell command are stopped and continued along with it.
+ */
+struct OspChild {
+    int id;             // Process ID in the table.
+    pid_t pid;          // 0 if the slot is empty.
+    bool running;       // Last sent SIGCONT rather than SIGSTOP.
+    bool exited;        // Command exited and the child was reaped.
+    long long cpu_us;   // CPU time used, recorded when the child exits.
+};
+
+/**
+ * Growable array of latency samples in nanoseconds.
+ */
+struct OspSamples {
+    long long *values;
+    size_t count;
+    size_t capacity;
+};
+
+/* Global Variables */
+static bool enabled = false;
+static const char *child_command = NULL;
+static struct OspChild children[OSP_SLOTS];    // Open-addressed by process ID, linear probing.
+static int num_children = 0;
+static int exited_ids[OSP_MAX_PROCESSES];       // Exits seen but not yet handled by the scheduler loop.
+static int num_exited = 0;
+static volatile sig_atomic_t stop_scheduler = 0;
+
+bool osp_enable(const char *command) {
+    child_command = command;
+    enabled = true;
+    return true;
+}
+
+bool osp_enabled() {
+    return enabled;
+}
+
+/**
+ * @return struct OspChild* Slot of the child for a process ID, or the empty slot where it would go.
+ */
+static struct OspChild *_ospSlot(int id) {
+    uint32_t index = ((uint32_t)id * 2654435769u) >> (32 - OSP_SLOT_BITS);
+    while (children[index].pid != 0 && children[index].id != id) {
+        index = (index + 1) & (OSP_SLOTS - 1);
+    }
+    return &children[index];
+}
+
+/**
+ * Empties a slot, shifting later entries of its probe run back so lookups still find them.
+ */
+static void _ospRemoveSlot(struct OspChild *child) {
+    uint32_t hole = (uint32_t)(child - children);
+    uint32_t index = hole;
+    children[hole].pid = 0;
+    for (;;) {
+        index = (index + 1) & (OSP_SLOTS - 1);
+        if (children[index].pid == 0) {
+            return;
+        }
+        uint32_t home = ((uint32_t)children[index].id * 2654435769u) >> (32 - OSP_SLOT_BITS);
+        // Move the entry into the hole unless its home lies cyclically in (hole, index].
+        if (((index - home) & (OSP_SLOTS - 1)) >= ((index - hole) & (OSP_SLOTS - 1))) {
+            children[hole] = children[index];
+            children[index].pid = 0;
+            hole = index;
+        }
+    }
+}
+
+static long long _ospNanoseconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long)now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+/**
+ * Records that a child's command exited, with the CPU time it used.
+ */
+static void _ospExited(struct OspChild *child, const struct rusage *usage) {
+    child->exited = true;
+    child->running = false;
+    child->cpu_us = (long long)(usage->ru_utime.tv_sec + usage->ru_stime.tv_sec) * 1000000LL
+                  + usage->ru_utime.tv_usec + usage->ru_stime.tv_usec;
+    if (num_exited < OSP_MAX_PROCESSES) {
+        exited_ids[num_exited++] = child->id;
+    }
+}
+
+/**
+ * Waits until the kernel reports a child stopped (WUNTRACED) or continued (WCONTINUED).
+ *
+ * @return bool False if the child exited instead.
+ */
+static bool _ospWait(struct OspChild *child, int options) {
+    int status;
+    struct rusage usage;
+    for (;;) {
+        pid_t pid = wait4(child->pid, &status, options, &usage);
+        if (pid < 0 && errno == EINTR) {
+            continue;
+        }
+        if (pid < 0 || WIFEXITED(status) || WIFSIGNALED(status)) {
+            if (pid < 0) {
+                memset(&usage, 0, sizeof(usage));
+            }
+            _ospExited(child, &usage);
+            return false;
+        }
+        if (((options & WUNTRACED) && WIFSTOPPED(status)) || ((options & WCONTINUED) && WIFCONTINUED(status))) {
+            return true;
+        }
+    }
+}
+
+/**
+ * Forks a child that stops itself before running the burner or the command, and waits until it has stopped.
+ * Only async-signal-safe calls are made in the child, since other threads may hold locks at the fork.
+ */
+static bool _ospSpawn(struct OspChild *child) {
+    pid_t pid = fork();
+    if (pid < 0) {
+        return false;
+    }
+    if (pid == 0) {
+        setpgid(0, 0);
+        prctl(PR_SET_PDEATHSIG, SIGKILL);   // Do not outlive the process manager.
+        int null_fd = open("/dev/null", O_RDWR);
+        if (null_fd >= 0) {
+            dup2(null_fd, STDIN_FILENO);
+            dup2(null_fd, STDOUT_FILENO);
+            dup2(null_fd, STDERR_FILENO);
+        }
+        raise(SIGSTOP);
+        if (child_command != NULL) {
+            execl("/bin/sh", "sh", "-c", child_command, (char *)NULL);
+            _exit(127);
+        }
+        for (volatile unsigned long spin = 0; ; spin++) {
+        }
+    }
+    setpgid(pid, pid);  // Also set here, so the group exists before the first signal.
+    child->pid = pid;
+    child->running = false;
+    child->exited = false;
+    child->cpu_us = 0;
+    num_children++;
+    _ospWait(child, WUNTRACED);
+    return true;
+}
+
+/**
+ * Kills and reaps a child, and empties its slot.
+ */
+static void _ospKill(struct OspChild *child) {
+    if (!child->exited) {
+        kill(-child->pid, SIGKILL);
+        while (waitpid(child->pid, NULL, 0) < 0 && errno == EINTR) {
+        }
+    }
+    _ospRemoveSlot(child);
+    num_children--;
+}
+
+/**
+ * Sends SIGSTOP or SIGCONT to a child unless it is already in that state.
+ *
+ * @return long long Nanoseconds until the kernel reported the change, -1 if nothing was sent.
+ */
+static long long _ospSignal(struct OspChild *child, bool run) {
+    if (child->exited || child->running == run) {
+        return -1;
+    }
+    long long start = _ospNanoseconds();
+    kill(-child->pid, run ? SIGCONT : SIGSTOP);
+    if (!_ospWait(child, run ? WCONTINUED : WUNTRACED)) {
+        return -1;
+    }
+    child->running = run;
+    return _ospNanoseconds() - start;
+}
+
+/**
+ * Reaps a running child if its command has exited.
+ */
+static void _ospPoll(struct OspChild *child) {
+    int status;
+    struct rusage usage;
+    if (child->running && !child->exited && wait4(child->pid, &status, WNOHANG, &usage) == child->pid
+            && (WIFEXITED(status) || WIFSIGNALED(status))) {
+        _ospExited(child, &usage);
+    }
+}
+
+bool osp_sync(const struct ProcessTable *table) {
+    if (!enabled) {
+        return true;
+    }
+
+    // Kill the children of processes that are gone. Removal shifts slots, so collect the IDs first.
+    int num_gone = 0;
+    static int gone[OSP_MAX_PROCESSES];
+    for (int i = 0; i < OSP_SLOTS; i++) {
+        if (children[i].pid != 0 && pt_find(table, children[i].id) == PT_NULL_HANDLE) {
+            gone[num_gone++] = children[i].id;
+        }
+    }
+    for (int i = 0; i < num_gone; i++) {
+        _ospKill(_ospSlot(gone[i]));
+    }
+
+    // Stop before continuing, so no more children run at once than there are Running processes.
+    bool spawned = true;
+    for (int pass = 0; pass < 2; pass++) {
+        for (ProcessHandle h = pt_first(table); h != PT_NULL_HANDLE; h = pt_next(table, h)) {
+            struct Process *process = pt_get(table, h);
+            struct OspChild *child = _ospSlot(process->id);
+            if (child->pid == 0) {
+                if (num_children >= OSP_MAX_PROCESSES) {
+                    spawned = false;
+                    continue;
+                }
+                child->id = process->id;
+                if (!_ospSpawn(child)) {
+                    spawned = false;
+                    continue;
+                }
+            }
+            _ospPoll(child);
+            if ((process->state == 1) == (pass == 1)) {
+                _ospSignal(child, process->state == 1);
+            }
+        }
+    }
+    num_exited = 0;    // Exits only matter to the scheduler loop.
+    if (!spawned) {
+        fprintf(stderr, "os_process: could not fork a child for every process (limit %d)\n", OSP_MAX_PROCESSES);
+    }
+    return spawned;
+}
+
+void osp_shutdown() {
+    for (int i = 0; i < OSP_SLOTS; i++) {
+        // Removal may shift a later child into this slot.
+        while (children[i].pid != 0) {
+            _ospKill(&children[i]);
+        }
+    }
+    num_exited = 0;
+}
+
+/**
+ * SIGINT/SIGTERM handler, ends the scheduler loop.
+ */
+static void _ospStop(int signal) {
+    (void)signal;
+    stop_scheduler = 1;
+}
+
+static void _ospSample(struct OspSamples *samples, long long value) {
+    if (value < 0) {
+        return;
+    }
+    if (samples->count == samples->capacity) {
+        size_t capacity = samples->capacity ? samples->capacity * 2 : 4096;
+        long long *values = realloc(samples->values, capacity * sizeof(long long));
+        if (values == NULL) {
+            return;
+        }
+        samples->values = values;
+        samples->capacity = capacity;
+    }
+    samples->values[samples->count++] = value;
+}
+
+static int _ospCompare(const void *a, const void *b) {
+    long long x = *(const long long *)a;
+    long long y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Prints the count, median, 99th percentile, and maximum of the samples, in microseconds.
+ */
+static void _ospPrintSamples(const char *name, struct OspSamples *samples) {
+    if (samples->count == 0) {
+        printf("  Syst > %-22s%10s\n", name, "-");
+        return;
+    }
+    qsort(samples->values, samples->count, sizeof(long long), _ospCompare);
+    size_t n = samples->count;
+    printf("  Syst > %-22s%10zu%10.1f%10.1f%10.1f\n", name, n,
+           samples->values[n / 2] / 1000.0,
+           samples->values[(n * 99) / 100] / 1000.0,
+           samples->values[n - 1] / 1000.0);
+}
+
+/**
+ * @return long long CPU time of a live child from /proc/<pid>/stat (utime + stime), -1 if unreadable.
+ */
+static long long _ospCpuTime(pid_t pid) {
+    char path[64];
+    char stat[1024];
+    snprintf(path, sizeof(path), "/proc/%d/stat", (int)pid);
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    ssize_t length = read(fd, stat, sizeof(stat) - 1);
+    close(fd);
+    if (length <= 0) {
+        return -1;
+    }
+    stat[length] = '\0';
+
+    // The command name may contain spaces and parentheses, so start after the last ')'.
+    char *fields = strrchr(stat, ')');
+    unsigned long utime;
+    unsigned long stime;
+    if (fields == NULL || sscanf(fields + 1, " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu", &utime, &stime) != 2) {
+        return -1;
+    }
+    return (long long)(utime + stime) * 1000000LL / sysconf(_SC_CLK_TCK);
+}
+
+int runOsScheduler(struct ProcessTable *table, const struct OspOptions *options) {
+    int cpus = options->cpus;
+    if (cpus < 1 || cpus > OSP_MAX_CPUS || options->quantum_us <= 0 || options->seconds <= 0) {
+        fprintf(stderr, "os_process: invalid scheduler options\n");
+        return 1;
+    }
+
+    // Start from nothing Running, with every child forked and stopped.
+    osp_enable(child_command);
+    pt_move_state(table, 1, 0);
+    long long spawn_start = _ospNanoseconds();
+    if (!osp_sync(table)) {
+        osp_shutdown();
+        return 1;
+    }
+    long long spawn_ns = _ospNanoseconds() - spawn_start;
+
+    int timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    struct itimerspec interval;
+    interval.it_interval.tv_sec = options->quantum_us / 1000000;
+    interval.it_interval.tv_nsec = (options->quantum_us % 1000000) * 1000;
+    interval.it_value = interval.it_interval;
+    if (timer_fd < 0 || timerfd_settime(timer_fd, 0, &interval, NULL) != 0) {
+        perror("os_process: timerfd");
+        if (timer_fd >= 0) {
+            close(timer_fd);
+        }
+        osp_shutdown();
+        return 1;
+    }
+
+    // No SA_RESTART, so a signal interrupts the timerfd read.
+    struct sigaction action;
+    struct sigaction old_int;
+    struct sigaction old_term;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = _ospStop;
+    sigaction(SIGINT, &action, &old_int);
+    sigaction(SIGTERM, &action, &old_term);
+    stop_scheduler = 0;
+
+    struct OspSamples decisions = { NULL, 0, 0 };
+    struct OspSamples stops = { NULL, 0, 0 };
+    struct OspSamples conts = { NULL, 0, 0 };
+    struct rusage usage_start;
+    struct rusage usage_end;
+    getrusage(RUSAGE_SELF, &usage_start);
+
+    int running[OSP_MAX_CPUS];
+    int num_running = 0;
+    int completed = 0;
+    long long ticks = 0;
+    long long missed = 0;
+    long long switches = 0;
+    long long deadline = _ospNanoseconds() + options->seconds * 1000000000LL;
+    long long run_start = _ospNanoseconds();
+
+    while (!stop_scheduler && _ospNanoseconds() < deadline) {
+        // Exits show up while running, or when a signal is answered by an exit instead.
+        for (int i = 0; i < num_running; i++) {
+            _ospPoll(_ospSlot(running[i]));
+        }
+        for (int i = 0; i < num_exited; i++) {
+            // The reaped child keeps its slot until shutdown, for its CPU time.
+            pm_terminate(table, exited_ids[i]);
+            completed++;
+        }
+        num_exited = 0;
+        if (pt_state_count(table, 0) + pt_state_count(table, 1) == 0) {
+            break;
+        }
+
+        // Decision: preempt every Running process, then dispatch by policy.
+        long long decision_start = _ospNanoseconds();
+        int previous[OSP_MAX_CPUS];
+        int num_previous = 0;
+        for (ProcessHandle h = pt_state_first(table, 1); h != PT_NULL_HANDLE; h = pt_state_first(table, 1)) {
+            previous[num_previous++] = pt_get(table, h)->id;
+            pt_set_state(table, h, 0);
+        }
+        num_running = 0;
+        while (num_running < cpus) {
+            int id;
+            if (options->policy == OSP_PRIORITY) {
+                if (pm_dispatch(table, &id) != PM_OK) {
+                    break;
+                }
+            }
+            else {
+                ProcessHandle h = pt_state_first(table, 0);
+                if (h == PT_NULL_HANDLE) {
+                    break;
+                }
+                id = pt_get(table, h)->id;
+                pt_set_state(table, h, 1);
+            }
+            running[num_running++] = id;
+        }
+        _ospSample(&decisions, _ospNanoseconds() - decision_start);
+
+        // Signals: stop the children that lost their CPU, then continue the new ones.
+        for (int i = 0; i < num_previous; i++) {
+            bool kept = false;
+            for (int j = 0; j < num_running; j++) {
+                kept |= (running[j] == previous[i]);
+            }
+            if (!kept) {
+                _ospSample(&stops, _ospSignal(_ospSlot(previous[i]), false));
+                switches++;
+            }
+        }
+        for (int i = 0; i < num_running; i++) {
+            long long latency = _ospSignal(_ospSlot(running[i]), true);
+            _ospSample(&conts, latency);
+        }
+
+        uint64_t expirations;
+        if (read(timer_fd, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+            ticks++;
+            missed += (long long)expirations - 1;
+        }
+    }
+    long long run_ns = _ospNanoseconds() - run_start;
+    getrusage(RUSAGE_SELF, &usage_end);
+    sigaction(SIGINT, &old_int, NULL);
+    sigaction(SIGTERM, &old_term, NULL);
+    close(timer_fd);
+
+    // Stop everything before reading CPU times, so they do not move while being read.
+    for (int i = 0; i < num_running; i++) {
+        _ospSignal(_ospSlot(running[i]), false);
+    }
+    int num_measured = 0;
+    long long cpu_total = 0;
+    long long cpu_min = -1;
+    long long cpu_max = 0;
+    double cpu_squares = 0.0;
+    for (int i = 0; i < OSP_SLOTS; i++) {
+        if (children[i].pid == 0) {
+            continue;
+        }
+        long long cpu_us = children[i].exited ? children[i].cpu_us : _ospCpuTime(children[i].pid);
+        if (cpu_us < 0) {
+            continue;
+        }
+        num_measured++;
+        cpu_total += cpu_us;
+        cpu_min = (cpu_min < 0 || cpu_us < cpu_min) ? cpu_us : cpu_min;
+        cpu_max = (cpu_us > cpu_max) ? cpu_us : cpu_max;
+        cpu_squares += (double)cpu_us * cpu_us;
+    }
+    double scheduler_cpu_us = (usage_end.ru_utime.tv_sec - usage_start.ru_utime.tv_sec
+                             + usage_end.ru_stime.tv_sec - usage_start.ru_stime.tv_sec) * 1e6
+                            + (usage_end.ru_utime.tv_usec - usage_start.ru_utime.tv_usec
+                             + usage_end.ru_stime.tv_usec - usage_start.ru_stime.tv_usec);
+
+    printf("  Syst > %s, QUANTUM %ld US, %d CPU(S), %d PROCESSES\n",
+           options->policy == OSP_PRIORITY ? "PRIORITY" : "ROUND ROBIN", options->quantum_us, cpus, num_children);
+    printf("  Syst > FORKED IN %.1f MS, RAN FOR %.2f S\n", spawn_ns / 1e6, run_ns / 1e9);
+    printf("  Syst > TICKS: %lld, MISSED: %lld, CONTEXT SWITCHES: %lld, COMPLETED: %d\n", ticks, missed, switches, completed);
+    printf("  Syst > SCHEDULER CPU: %.1f MS (%.2f%% OF ONE CPU)\n", scheduler_cpu_us / 1000.0, scheduler_cpu_us * 100.0 / (run_ns / 1000.0));
+    printf("  Syst > %-22s%10s%10s%10s%10s\n", "LATENCY (US)", "COUNT", "P50", "P99", "MAX");
+    _ospPrintSamples("DECISION", &decisions);
+    _ospPrintSamples("SIGSTOP -> STOPPED", &stops);
+    _ospPrintSamples("SIGCONT -> CONTINUED", &conts);
+    if (num_measured > 0) {
+        double mean = (double)cpu_total / num_measured;
+        double fairness = cpu_squares > 0 ? ((double)cpu_total * cpu_total) / (num_measured * cpu_squares) : 1.0;
+        printf("  Syst > CHILD CPU (MS): TOTAL %.1f, MIN %.1f, MEAN %.1f, MAX %.1f, FAIRNESS %.3f\n",
+               cpu_total / 1000.0, cpu_min / 1000.0, mean / 1000.0, cpu_max / 1000.0, fairness);
+    }
+
+    free(decisions.values);
+    free(stops.values);
+    free(conts.values);
+    osp_shutdown();
+    return 0;
+}
+
+#endif
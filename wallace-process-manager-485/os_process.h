@@ -0,0 +1,82 @@
+/**
+ * Real OS process header file (Linux only).
+ * Backs every process in the table with a real child process: a created process forks a child
+ * (a CPU burner or a user-supplied command), a Running process is sent SIGCONT, and every other
+ * state is sent SIGSTOP, so the process states drive what the kernel actually runs.
+ * A user-space scheduler loop can then enforce a policy and quantum with a timerfd and measure
+ * what its decisions and signals really cost.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#ifndef OS_PROCESS_H
+#define OS_PROCESS_H
+
+#include "process_table.h"
+#include <stdbool.h>
+
+#define OSP_MAX_PROCESSES 4096      // Children that can exist at once.
+#define OSP_DEFAULT_QUANTUM_US 10000
+#define OSP_DEFAULT_SECONDS 5
+#define OSP_MAX_CPUS 64
+
+/**
+ * Which Ready process the scheduler loop dispatches when a quantum expires.
+ */
+enum OspPolicy {
+    OSP_PRIORITY,       // Highest-priority Ready process (see pm_dispatch).
+    OSP_ROUND_ROBIN     // Ready process that has waited longest.
+};
+
+struct OspOptions {
+    enum OspPolicy policy;
+    long quantum_us;    // Time slice enforced with a timerfd.
+    int seconds;        // Length of the run.
+    int cpus;           // Processes Running at once.
+};
+
+/**
+ * Turns on real process mode. Children are only forked by osp_sync.
+ *
+ * @param command Shell command each child runs (with /bin/sh -c), NULL for a built-in CPU burner.
+ * @return bool False if real processes are not supported.
+ */
+bool osp_enable(const char *command);
+
+/**
+ * @return bool True once real process mode is on.
+ */
+bool osp_enabled();
+
+/**
+ * Brings the children in line with the table in O(n): forks a stopped child for every new process,
+ * kills the child of every process that is gone, continues the children of Running processes,
+ * and stops all others. Children whose command has exited are reaped and left alone.
+ * Does nothing unless real process mode is on.
+ *
+ * @param table Process table.
+ * @return bool False if a child could not be forked.
+ */
+bool osp_sync(const struct ProcessTable *table);
+
+/**
+ * Kills and reaps every child.
+ */
+void osp_shutdown();
+
+/**
+ * Runs the user-space scheduler until the time is up, SIGINT arrives, or no process is left.
+ * Each quantum, the Running processes are moved back to Ready and stopped, and the next ones picked
+ * by the policy are dispatched and continued. A process whose command exits is terminated.
+ * Prints the scheduling decision time, the stop and continue signal latency (until the kernel
+ * reports the child stopped or continued), missed timer ticks, and the CPU time each child received.
+ *
+ * @param table Process table, every process gets a child (real process mode is turned on if needed).
+ * @param options Policy, quantum, run length, and number of CPUs.
+ * @return int 0 after the run, 1 if it could not be set up.
+ */
+int runOsScheduler(struct ProcessTable *table, const struct OspOptions *options);
+
+#endif // OS_PROCESS_H
@@ -0,0 +1,370 @@
+/**
+ * Asynchronous output implementation file.
+ *
+ * The ring holds variable-length records, each an 8-byte header followed by the text padded to 8 bytes.
+ * A writer reserves space by advancing ring_head with a compare-and-swap, copies its text in, and then
+ * commits the record by setting the header's state. The output thread reads committed records from
+ * ring_tail, writes them out, zeroes the space, and advances ring_tail to give the space back.
+ * Because released space is zeroed, a header that has been reserved but not written yet reads as
+ * "not committed", and the output thread waits for it. A record never wraps around the end of the
+ * ring: the rest of the ring is reserved as padding instead.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#include "output.h"
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Global Variables */
+static atomic_bool active;
+static atomic_llong dropped;
+
+bool output_active() {
+    return atomic_load_explicit(&active, memory_order_acquire);
+}
+
+long long output_dropped() {
+    return atomic_load_explicit(&dropped, memory_order_relaxed);
+}
+
+void output_printf(const char *format, ...) {
+    char text[512];
+    va_list args, retry;
+    va_start(args, format);
+    va_copy(retry, args);
+    int length = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    if (length >= (int)sizeof(text)) {
+        char *long_text = malloc(length + 1);
+        if (long_text != NULL) {
+            vsnprintf(long_text, length + 1, format, retry);
+            output_write(long_text, length);
+            free(long_text);
+        }
+    }
+    else if (length > 0) {
+        output_write(text, length);
+    }
+    va_end(retry);
+}
+
+#ifdef _WIN32
+
+bool output_start(enum OutputPolicy policy) {
+    fprintf(stderr, "output: not supported on Windows\n");
+    return false;
+}
+
+void output_stop() {
+}
+
+void output_write(const char *text, size_t length) {
+    fwrite(text, 1, length, stdout);
+}
+
+void output_flush() {
+    fflush(stdout);
+}
+
+#else
+
+#include <errno.h>
+#include <pthread.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+#define OUTPUT_MASK ((uint64_t)OUTPUT_RING_SIZE - 1)
+#define OUTPUT_IOV 64                   // Records gathered into one writev.
+#define OUTPUT_IDLE_NS 10000000L        // Longest an idle output thread sleeps without being woken.
+
+enum OutputState {
+    OUTPUT_EMPTY = 0,       // Reserved but not written yet (or free).
+    OUTPUT_COMMITTED,
+    OUTPUT_PADDING          // Skipped space up to the end of the ring.
+};
+
+struct OutputHeader {
+    uint32_t length;        // Bytes of text after the header.
+    atomic_uint state;      // enum OutputState.
+};
+
+/* Global Variables */
+static char *ring;
+static atomic_uint_fast64_t ring_head;      // Next byte to reserve.
+static atomic_uint_fast64_t ring_tail;      // Next byte to write out.
+static enum OutputPolicy output_policy;
+static pthread_t writer;
+static pthread_mutex_t output_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t writer_wake;          // Signals the output thread: new records or stopping.
+static pthread_cond_t progress;             // Signals waiters: space was released.
+static atomic_bool writer_idle;             // The output thread is (about to go) waiting on writer_wake.
+static atomic_int waiters;                  // Threads waiting on progress.
+static bool stopping = false;
+
+/**
+ * Size of a record with the given text length, header included.
+ */
+static uint64_t _outputSize(uint64_t length) {
+    return sizeof(struct OutputHeader) + ((length + 7) & ~(uint64_t)7);
+}
+
+/**
+ * Wakes the output thread if it is waiting for records.
+ */
+static void _outputWake() {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&writer_idle, memory_order_relaxed)) {
+        pthread_mutex_lock(&output_lock);
+        pthread_cond_signal(&writer_wake);
+        pthread_mutex_unlock(&output_lock);
+    }
+}
+
+/**
+ * Waits until the output thread has written everything up to the given ring position.
+ */
+static void _outputWaitFor(uint64_t position) {
+    pthread_mutex_lock(&output_lock);
+    atomic_fetch_add(&waiters, 1);
+    pthread_cond_signal(&writer_wake);
+    while (atomic_load_explicit(&ring_tail, memory_order_acquire) < position) {
+        pthread_cond_wait(&progress, &output_lock);
+    }
+    atomic_fetch_sub(&waiters, 1);
+    pthread_mutex_unlock(&output_lock);
+}
+
+/**
+ * Reserves, fills, and commits one record.
+ *
+ * @return bool False if the ring was full and the record was dropped.
+ */
+static bool _outputRecord(const char *text, size_t length) {
+    uint64_t size = _outputSize(length);
+    uint64_t head = atomic_load_explicit(&ring_head, memory_order_relaxed);
+    uint64_t padding, start;
+    while (true) {
+        padding = ((head & OUTPUT_MASK) + size > OUTPUT_RING_SIZE) ? OUTPUT_RING_SIZE - (head & OUTPUT_MASK) : 0;
+        uint64_t tail = atomic_load_explicit(&ring_tail, memory_order_acquire);
+        if (head + padding + size - tail > OUTPUT_RING_SIZE) {
+            if (output_policy == OUTPUT_DROP) {
+                atomic_fetch_add_explicit(&dropped, 1, memory_order_relaxed);
+                return false;
+            }
+            _outputWaitFor(head + padding + size - OUTPUT_RING_SIZE);
+            head = atomic_load_explicit(&ring_head, memory_order_relaxed);
+            continue;
+        }
+        if (atomic_compare_exchange_weak_explicit(&ring_head, &head, head + padding + size,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    start = head;
+    if (padding > 0) {
+        struct OutputHeader *skip = (struct OutputHeader *)(ring + (start & OUTPUT_MASK));
+        skip->length = (uint32_t)(padding - sizeof(struct OutputHeader));
+        atomic_store_explicit(&skip->state, OUTPUT_PADDING, memory_order_release);
+        start += padding;
+    }
+    struct OutputHeader *header = (struct OutputHeader *)(ring + (start & OUTPUT_MASK));
+    memcpy(header + 1, text, length);
+    header->length = (uint32_t)length;
+    atomic_store_explicit(&header->state, OUTPUT_COMMITTED, memory_order_release);
+    return true;
+}
+
+void output_write(const char *text, size_t length) {
+    if (!output_active()) {
+        fwrite(text, 1, length, stdout);
+        return;
+    }
+    while (length > 0) {
+        size_t part = (length > OUTPUT_MAX_RECORD) ? OUTPUT_MAX_RECORD : length;
+        _outputRecord(text, part);
+        text += part;
+        length -= part;
+    }
+    _outputWake();
+}
+
+void output_flush() {
+    if (!output_active()) {
+        fflush(stdout);
+        return;
+    }
+    _outputWaitFor(atomic_load(&ring_head));
+}
+
+/**
+ * Writes every iovec in full.
+ */
+static void _outputWritev(struct iovec *iov, int count) {
+    while (count > 0) {
+        ssize_t written = writev(STDOUT_FILENO, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;     // Output is gone (e.g. closed pipe), nothing more can be done.
+        }
+        while (count > 0 && (size_t)written >= iov->iov_len) {
+            written -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char *)iov->iov_base + written;
+            iov->iov_len -= written;
+        }
+    }
+}
+
+/**
+ * Output thread: writes committed records in batches until stopped and drained.
+ */
+static void *_outputThread(void *ptr) {
+    (void)ptr;
+    struct iovec iov[OUTPUT_IOV + 1];
+    long long reported = 0;
+    char notice[64];
+
+    while (true) {
+        uint64_t tail = atomic_load_explicit(&ring_tail, memory_order_relaxed);
+        uint64_t position = tail;
+        int count = 0;
+
+        // Gather committed records, stopping at the first one still being written.
+        while (count < OUTPUT_IOV && position < atomic_load_explicit(&ring_head, memory_order_acquire)) {
+            struct OutputHeader *header = (struct OutputHeader *)(ring + (position & OUTPUT_MASK));
+            unsigned state = atomic_load_explicit(&header->state, memory_order_acquire);
+            if (state == OUTPUT_EMPTY) {
+                break;
+            }
+            if (state == OUTPUT_COMMITTED && header->length > 0) {
+                iov[count].iov_base = header + 1;
+                iov[count].iov_len = header->length;
+                count++;
+            }
+            position += _outputSize(header->length);
+        }
+
+        long long drops = atomic_load_explicit(&dropped, memory_order_relaxed);
+        if (drops > reported) {
+            int length = snprintf(notice, sizeof(notice), "\n[output: %lld records dropped]\n", drops - reported);
+            iov[count].iov_base = notice;
+            iov[count].iov_len = length;
+            count++;
+            reported = drops;
+        }
+
+        if (position == tail && count == 0) {
+            // Nothing to write: wait for a writer, unless stopping with everything written.
+            pthread_mutex_lock(&output_lock);
+            atomic_store(&writer_idle, true);
+            atomic_thread_fence(memory_order_seq_cst);
+            struct OutputHeader *header = (struct OutputHeader *)(ring + (tail & OUTPUT_MASK));
+            bool pending = atomic_load_explicit(&header->state, memory_order_acquire) != OUTPUT_EMPTY;
+            if (stopping && !pending && atomic_load(&ring_head) == tail) {
+                pthread_mutex_unlock(&output_lock);
+                break;
+            }
+            if (!pending) {
+                struct timespec deadline;
+                clock_gettime(CLOCK_MONOTONIC, &deadline);
+                deadline.tv_nsec += OUTPUT_IDLE_NS;
+                if (deadline.tv_nsec >= 1000000000L) {
+                    deadline.tv_sec++;
+                    deadline.tv_nsec -= 1000000000L;
+                }
+                pthread_cond_timedwait(&writer_wake, &output_lock, &deadline);
+            }
+            atomic_store(&writer_idle, false);
+            pthread_mutex_unlock(&output_lock);
+            continue;
+        }
+
+        _outputWritev(iov, count);
+
+        // Zero the written space so reserved-but-unwritten headers read as empty, then release it.
+        uint64_t from = tail & OUTPUT_MASK, to = position & OUTPUT_MASK;
+        if (position - tail == OUTPUT_RING_SIZE) {
+            memset(ring, 0, OUTPUT_RING_SIZE);
+        }
+        else if (from < to || position == tail) {
+            memset(ring + from, 0, to - from);
+        }
+        else {
+            memset(ring + from, 0, OUTPUT_RING_SIZE - from);
+            memset(ring, 0, to);
+        }
+        atomic_store_explicit(&ring_tail, position, memory_order_release);
+
+        if (atomic_load(&waiters) > 0) {
+            pthread_mutex_lock(&output_lock);
+            pthread_cond_broadcast(&progress);
+            pthread_mutex_unlock(&output_lock);
+        }
+    }
+    return NULL;
+}
+
+bool output_start(enum OutputPolicy policy) {
+    if (output_active()) {
+        return true;
+    }
+    // Aligned so every header (at a multiple of 8) is naturally aligned.
+    if (ring == NULL && posix_memalign((void **)&ring, 64, OUTPUT_RING_SIZE) != 0) {
+        ring = NULL;
+        fprintf(stderr, "output: out of memory\n");
+        return false;
+    }
+    memset(ring, 0, OUTPUT_RING_SIZE);
+    atomic_store(&ring_head, 0);
+    atomic_store(&ring_tail, 0);
+    output_policy = policy;
+    stopping = false;
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&writer_wake, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_cond_init(&progress, NULL);
+
+    fflush(stdout);
+    if (pthread_create(&writer, NULL, _outputThread, NULL) != 0) {
+        pthread_cond_destroy(&writer_wake);
+        pthread_cond_destroy(&progress);
+        fprintf(stderr, "output: could not start the output thread\n");
+        return false;
+    }
+    atomic_store_explicit(&active, true, memory_order_release);
+    return true;
+}
+
+void output_stop() {
+    if (!output_active()) {
+        return;
+    }
+    pthread_mutex_lock(&output_lock);
+    stopping = true;
+    pthread_cond_signal(&writer_wake);
+    pthread_mutex_unlock(&output_lock);
+    pthread_join(writer, NULL);
+    atomic_store_explicit(&active, false, memory_order_release);
+    pthread_cond_destroy(&writer_wake);
+    pthread_cond_destroy(&progress);
+}
+
+#endif
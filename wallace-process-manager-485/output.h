@@ -0,0 +1,70 @@
+/**
+ * Asynchronous output header file.
+ * Lets a simulation print without waiting on the terminal: callers copy preformatted records into a
+ * lock-free ring buffer, and one output thread writes everything queued so far with a single writev.
+ * Any number of threads may print at once; records are reserved with one compare-and-swap and
+ * written out in the order they were reserved.
+ * While the output thread runs, everything printed to stdout must go through these functions
+ * (otherwise it would overtake the queued records). When it is not running, they fall back to stdout.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define OUTPUT_RING_SIZE (1 << 20)                  // Bytes of queued output (power of two).
+#define OUTPUT_MAX_RECORD (OUTPUT_RING_SIZE / 4)    // Longer writes are split into several records.
+
+/**
+ * What a caller does when the ring buffer is full.
+ */
+enum OutputPolicy {
+    OUTPUT_BLOCK,       // Wait for the output thread to make room (nothing is lost).
+    OUTPUT_DROP         // Drop the record; the number dropped is reported in the output.
+};
+
+/**
+ * Flushes stdout and starts the output thread.
+ *
+ * @param policy What to do when the ring buffer is full.
+ * @return bool False if the thread could not be started, output then keeps going to stdout directly.
+ */
+bool output_start(enum OutputPolicy policy);
+
+/**
+ * Writes out everything queued and stops the output thread.
+ */
+void output_stop();
+
+/**
+ * @return bool True while the output thread is running.
+ */
+bool output_active();
+
+/**
+ * Queues text to be written.
+ */
+void output_write(const char *text, size_t length);
+
+/**
+ * Queues printf-style text to be written.
+ */
+void output_printf(const char *format, ...);
+
+/**
+ * Waits until everything queued so far has been written, e.g. before reading input after a prompt.
+ */
+void output_flush();
+
+/**
+ * @return long long Number of records dropped under OUTPUT_DROP.
+ */
+long long output_dropped();
+
+#endif // OUTPUT_H
@@ -0,0 +1,744 @@
+/**
+ * Process table implementation file.
+ * Processes live in fixed-size slabs that are never moved or freed while the table exists,
+ * so a slot index stays valid for the lifetime of the table. Released slots go on a free list
+ * and are reused before a new slab is allocated. A process ID index (linear probing) gives
+ * O(1) lookups without scanning the table, and every process is linked into the list of its
+ * state so a state can be listed without scanning the table either. The state, priority, and
+ * start time columns of each slab are kept in step with the slots for the bulk operations.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#include "process_table.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define PT_INDEX_INITIAL 256    // Initial ID index capacity (power of two).
+#define PT_BULK_SHARE 16        // Bulk removals rebuild the index and heap once more than 1/16 of the table goes.
+
+/**
+ * Returns a pointer to the slot at a given slot index. The index must be below num_slabs * PT_SLAB_SIZE.
+ */
+static struct ProcessSlot *_pt_slot(const struct ProcessTable *table, uint32_t slot_index) {
+    return &table->slabs[slot_index / PT_SLAB_SIZE]->slots[slot_index % PT_SLAB_SIZE];
+}
+
+/**
+ * Returns the slab holding a slot index. The slot's column entries are at [slot_index % PT_SLAB_SIZE].
+ */
+static struct ProcessSlab *_pt_slab(const struct ProcessTable *table, uint32_t slot_index) {
+    return table->slabs[slot_index / PT_SLAB_SIZE];
+}
+
+/**
+ * True if a block was allocated by the table, false if it lies inside borrowed memory.
+ */
+static bool _pt_owns(const struct ProcessTable *table, const void *ptr) {
+    const char *p = ptr;
+    return table->borrowed == NULL || p < table->borrowed || p >= table->borrowed + table->borrowed_size;
+}
+
+/**
+ * Builds a handle from a slot index and its current generation.
+ */
+static ProcessHandle _pt_handle(uint32_t slot_index, uint32_t generation) {
+    return ((ProcessHandle)generation << 32) | slot_index;
+}
+
+/**
+ * Resolves a handle to its slot, NULL if the handle is out of range, free, or from an older generation.
+ */
+static struct ProcessSlot *_pt_resolve(const struct ProcessTable *table, ProcessHandle handle) {
+    uint32_t slot_index = (uint32_t)handle;
+    uint32_t generation = (uint32_t)(handle >> 32);
+
+    if (handle == PT_NULL_HANDLE || slot_index / PT_SLAB_SIZE >= table->num_slabs) {
+        return NULL;
+    }
+
+    struct ProcessSlot *slot = _pt_slot(table, slot_index);
+    if (!slot->in_use || slot->generation != generation) {
+        return NULL;
+    }
+    return slot;
+}
+
+/**
+ * Home bucket of a process ID in the ID index (Fibonacci hashing).
+ */
+static uint32_t _pt_hash(int id, uint32_t capacity) {
+    return ((uint32_t)id * 2654435769u) & (capacity - 1);
+}
+
+/**
+ * Allocates an empty ID index.
+ */
+static struct ProcessIndex *_pt_index_alloc(uint32_t capacity) {
+    struct ProcessIndex *index = calloc(1, sizeof(struct ProcessIndex) + (size_t)capacity * sizeof(uint32_t));
+    if (index != NULL) {
+        index->capacity = capacity;
+        index->retired = NULL;
+    }
+    return index;
+}
+
+/**
+ * Frees an ID index and every older index retired behind it.
+ */
+static void _pt_index_free(struct ProcessTable *table, struct ProcessIndex *index) {
+    while (index != NULL) {
+        struct ProcessIndex *retired = index->retired;
+        if (_pt_owns(table, index)) {
+            free(index);
+        }
+        index = retired;
+    }
+}
+
+/**
+ * Places a slot index into an ID index without checking for duplicates or load.
+ */
+static void _pt_index_place(struct ProcessIndex *index, int id, uint32_t slot_index) {
+    uint32_t bucket = _pt_hash(id, index->capacity);
+    while (index->buckets[bucket] != 0) {
+        bucket = (bucket + 1) & (index->capacity - 1);
+    }
+    index->buckets[bucket] = slot_index + 1;
+}
+
+/**
+ * Doubles the ID index and re-inserts every live process.
+ */
+static bool _pt_index_grow(struct ProcessTable *table) {
+    struct ProcessIndex *old_index = table->index;
+    struct ProcessIndex *new_index = _pt_index_alloc(old_index->capacity * 2);
+    if (new_index == NULL) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < old_index->capacity; i++) {
+        if (old_index->buckets[i] != 0) {
+            uint32_t slot_index = old_index->buckets[i] - 1;
+            _pt_index_place(new_index, _pt_slot(table, slot_index)->process.id, slot_index);
+        }
+    }
+
+    // Publish the new index before retiring (or freeing) the old one.
+    if (table->retain_retired) {
+        new_index->retired = old_index;
+        __atomic_store_n(&table->index, new_index, __ATOMIC_RELEASE);
+    }
+    else {
+        table->index = new_index;
+        _pt_index_free(table, old_index);
+    }
+    return true;
+}
+
+/**
+ * Removes a slot index from the ID index using backward-shift deletion,
+ * so high churn never leaves tombstones behind.
+ */
+static void _pt_index_erase(struct ProcessTable *table, int id, uint32_t slot_index) {
+    struct ProcessIndex *index = table->index;
+    uint32_t mask = index->capacity - 1;
+    uint32_t hole = _pt_hash(id, index->capacity);
+
+    while (index->buckets[hole] != slot_index + 1) {
+        hole = (hole + 1) & mask;
+    }
+
+    uint32_t next = hole;
+    while (true) {
+        next = (next + 1) & mask;
+        if (index->buckets[next] == 0) {
+            break;
+        }
+
+        // Move the entry back only if its home bucket is not cyclically within (hole, next].
+        uint32_t home = _pt_hash(_pt_slot(table, index->buckets[next] - 1)->process.id, index->capacity);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            index->buckets[hole] = index->buckets[next];
+            hole = next;
+        }
+    }
+    index->buckets[hole] = 0;
+}
+
+/**
+ * Clears the ID index and re-inserts every live process, for after a bulk removal.
+ */
+static void _pt_index_rebuild(struct ProcessTable *table) {
+    struct ProcessIndex *index = table->index;
+    memset(index->buckets, 0, (size_t)index->capacity * sizeof(uint32_t));
+    for (int list = 0; list < PT_NUM_STATES; list++) {
+        for (uint32_t i = table->state_head[list]; i != PT_NO_SLOT; i = _pt_slot(table, i)->state_next) {
+            _pt_index_place(index, _pt_slot(table, i)->process.id, i);
+        }
+    }
+}
+
+/**
+ * Ready heap ordering: true if slot a should be dispatched before slot b.
+ */
+static bool _pt_heap_before(const struct ProcessTable *table, uint32_t a, uint32_t b) {
+    const struct Process *pa = &_pt_slot(table, a)->process;
+    const struct Process *pb = &_pt_slot(table, b)->process;
+
+    if (pa->priority != pb->priority) {
+        return pa->priority < pb->priority;
+    }
+    if (pa->start_time != pb->start_time) {
+        return pa->start_time < pb->start_time;
+    }
+    return pa->id < pb->id;
+}
+
+/**
+ * Places a slot index at a heap position and records the position in the slot.
+ */
+static void _pt_heap_set(struct ProcessTable *table, uint32_t pos, uint32_t slot_index) {
+    table->ready_heap[pos] = slot_index;
+    _pt_slot(table, slot_index)->heap_pos = pos;
+}
+
+/**
+ * Moves the entry at a heap position up until its parent comes before it.
+ */
+static void _pt_heap_up(struct ProcessTable *table, uint32_t pos) {
+    uint32_t slot_index = table->ready_heap[pos];
+    while (pos > 0) {
+        uint32_t parent = (pos - 1) / 2;
+        if (!_pt_heap_before(table, slot_index, table->ready_heap[parent])) {
+            break;
+        }
+        _pt_heap_set(table, pos, table->ready_heap[parent]);
+        pos = parent;
+    }
+    _pt_heap_set(table, pos, slot_index);
+}
+
+/**
+ * Moves the entry at a heap position down until both children come after it.
+ */
+static void _pt_heap_down(struct ProcessTable *table, uint32_t pos) {
+    uint32_t size = table->state_count[1];
+    uint32_t slot_index = table->ready_heap[pos];
+    while (true) {
+        uint32_t child = 2 * pos + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && _pt_heap_before(table, table->ready_heap[child + 1], table->ready_heap[child])) {
+            child++;
+        }
+        if (!_pt_heap_before(table, table->ready_heap[child], slot_index)) {
+            break;
+        }
+        _pt_heap_set(table, pos, table->ready_heap[child]);
+        pos = child;
+    }
+    _pt_heap_set(table, pos, slot_index);
+}
+
+/**
+ * Adds a slot to the ready heap. Must be called after state_count[1] has been incremented.
+ */
+static void _pt_heap_push(struct ProcessTable *table, uint32_t slot_index) {
+    uint32_t pos = table->state_count[1] - 1;
+    _pt_heap_set(table, pos, slot_index);
+    _pt_heap_up(table, pos);
+}
+
+/**
+ * Removes a slot from the ready heap. Must be called after state_count[1] has been decremented.
+ */
+static void _pt_heap_erase(struct ProcessTable *table, uint32_t slot_index) {
+    uint32_t pos = _pt_slot(table, slot_index)->heap_pos;
+    uint32_t last = table->state_count[1];
+    if (pos == last) {
+        return;
+    }
+
+    // Fill the hole with the last entry and restore the heap order in whichever direction it breaks.
+    uint32_t moved = table->ready_heap[last];
+    _pt_heap_set(table, pos, moved);
+    _pt_heap_up(table, pos);
+    _pt_heap_down(table, _pt_slot(table, moved)->heap_pos);
+}
+
+/**
+ * Rebuilds the ready heap from the Ready list in O(n), for after a bulk change.
+ */
+static void _pt_heap_build(struct ProcessTable *table) {
+    uint32_t size = 0;
+    for (uint32_t i = table->state_head[1]; i != PT_NO_SLOT; i = _pt_slot(table, i)->state_next) {
+        _pt_heap_set(table, size++, i);
+    }
+    for (uint32_t pos = size / 2; pos-- > 0; ) {
+        _pt_heap_down(table, pos);
+    }
+}
+
+/**
+ * Appends a slot to the end of a state list, without touching the ready heap.
+ */
+static void _pt_list_link(struct ProcessTable *table, uint32_t slot_index, int state) {
+    struct ProcessSlot *slot = _pt_slot(table, slot_index);
+    int list = state + 1;
+
+    slot->state_prev = table->state_tail[list];
+    slot->state_next = PT_NO_SLOT;
+    if (table->state_tail[list] != PT_NO_SLOT) {
+        _pt_slot(table, table->state_tail[list])->state_next = slot_index;
+    }
+    else {
+        table->state_head[list] = slot_index;
+    }
+    table->state_tail[list] = slot_index;
+    table->state_count[list]++;
+    _pt_slab(table, slot_index)->state_column[slot_index % PT_SLAB_SIZE] = (int8_t)state;
+}
+
+/**
+ * Appends a slot to the end of a state list.
+ */
+static void _pt_link(struct ProcessTable *table, uint32_t slot_index, int state) {
+    _pt_list_link(table, slot_index, state);
+    if (state == 0) {
+        _pt_heap_push(table, slot_index);
+    }
+}
+
+/**
+ * Unlinks a slot from the list of its current state, without touching the ready heap.
+ */
+static void _pt_list_unlink(struct ProcessTable *table, uint32_t slot_index) {
+    struct ProcessSlot *slot = _pt_slot(table, slot_index);
+    int list = slot->process.state + 1;
+
+    if (slot->state_prev != PT_NO_SLOT) {
+        _pt_slot(table, slot->state_prev)->state_next = slot->state_next;
+    }
+    else {
+        table->state_head[list] = slot->state_next;
+    }
+    if (slot->state_next != PT_NO_SLOT) {
+        _pt_slot(table, slot->state_next)->state_prev = slot->state_prev;
+    }
+    else {
+        table->state_tail[list] = slot->state_prev;
+    }
+    table->state_count[list]--;
+}
+
+/**
+ * Unlinks a slot from the list of its current state.
+ */
+static void _pt_unlink(struct ProcessTable *table, uint32_t slot_index) {
+    _pt_list_unlink(table, slot_index);
+    if (_pt_slot(table, slot_index)->process.state == 0) {
+        _pt_heap_erase(table, slot_index);
+    }
+}
+
+/**
+ * Returns a slot to the free list, making every outstanding handle to it stale.
+ */
+static void _pt_release(struct ProcessTable *table, uint32_t slot_index) {
+    struct ProcessSlot *slot = _pt_slot(table, slot_index);
+
+    // Bump the generation so every outstanding handle goes stale (skip 0 on wrap-around).
+    slot->generation++;
+    if (slot->generation == 0) {
+        slot->generation = 1;
+    }
+    if (slot->created_prev != PT_NO_SLOT) {
+        _pt_slot(table, slot->created_prev)->created_next = slot->created_next;
+    }
+    else {
+        table->created_head = slot->created_next;
+    }
+    if (slot->created_next != PT_NO_SLOT) {
+        _pt_slot(table, slot->created_next)->created_prev = slot->created_prev;
+    }
+    else {
+        table->created_tail = slot->created_prev;
+    }
+    slot->in_use = false;
+    slot->next_free = table->free_head;
+    table->free_head = slot_index;
+    table->count--;
+    _pt_slab(table, slot_index)->state_column[slot_index % PT_SLAB_SIZE] = PT_FREE_STATE;
+}
+
+/**
+ * Allocates a new slab and pushes all of its slots onto the free list.
+ */
+static bool _pt_add_slab(struct ProcessTable *table) {
+    if (table->num_slabs >= PT_MAX_SLABS) {
+        return false;
+    }
+
+    struct ProcessSlab *slab = malloc(sizeof(struct ProcessSlab));
+    if (slab == NULL) {
+        return false;
+    }
+
+    // Grow the ready heap with the slot capacity so it can always hold every process.
+    size_t heap_size = (size_t)(table->num_slabs + 1) * PT_SLAB_SIZE * sizeof(uint32_t);
+    uint32_t *ready_heap;
+    if (_pt_owns(table, table->ready_heap)) {
+        ready_heap = realloc(table->ready_heap, heap_size);
+    }
+    else {
+        ready_heap = malloc(heap_size);
+        if (ready_heap != NULL) {
+            memcpy(ready_heap, table->ready_heap, table->state_count[1] * sizeof(uint32_t));
+        }
+    }
+    if (ready_heap == NULL) {
+        free(slab);
+        return false;
+    }
+    table->ready_heap = ready_heap;
+
+    uint32_t base = table->num_slabs * PT_SLAB_SIZE;
+    for (uint32_t i = 0; i < PT_SLAB_SIZE; i++) {
+        slab->slots[i].generation = 1;
+        slab->slots[i].in_use = false;
+        slab->slots[i].next_free = (i + 1 < PT_SLAB_SIZE) ? base + i + 1 : table->free_head;
+    }
+    memset(slab->state_column, PT_FREE_STATE, sizeof(slab->state_column));
+
+    __atomic_store_n(&table->slabs[table->num_slabs], slab, __ATOMIC_RELEASE);
+    table->num_slabs++;
+    table->free_head = base;
+    return true;
+}
+
+bool pt_init(struct ProcessTable *table) {
+    table->num_slabs = 0;
+    table->free_head = PT_NO_SLOT;
+    table->count = 0;
+    for (int i = 0; i < PT_NUM_STATES; i++) {
+        table->state_head[i] = PT_NO_SLOT;
+        table->state_tail[i] = PT_NO_SLOT;
+        table->state_count[i] = 0;
+    }
+    table->created_head = PT_NO_SLOT;
+    table->created_tail = PT_NO_SLOT;
+    for (uint32_t i = 0; i < PT_MAX_SLABS; i++) {
+        table->slabs[i] = NULL;
+    }
+    table->ready_heap = NULL;
+    table->retain_retired = false;
+    table->borrowed = NULL;
+    table->borrowed_size = 0;
+    table->index = _pt_index_alloc(PT_INDEX_INITIAL);
+    return table->index != NULL;
+}
+
+void pt_destroy(struct ProcessTable *table) {
+    for (uint32_t i = 0; i < table->num_slabs; i++) {
+        if (_pt_owns(table, table->slabs[i])) {
+            free(table->slabs[i]);
+        }
+    }
+    _pt_index_free(table, table->index);
+    if (_pt_owns(table, table->ready_heap)) {
+        free(table->ready_heap);
+    }
+
+    table->num_slabs = 0;
+    table->free_head = PT_NO_SLOT;
+    table->count = 0;
+    for (int i = 0; i < PT_NUM_STATES; i++) {
+        table->state_head[i] = PT_NO_SLOT;
+        table->state_tail[i] = PT_NO_SLOT;
+        table->state_count[i] = 0;
+    }
+    table->created_head = PT_NO_SLOT;
+    table->created_tail = PT_NO_SLOT;
+    table->ready_heap = NULL;
+    table->index = NULL;
+    table->borrowed = NULL;
+    table->borrowed_size = 0;
+}
+
+ProcessHandle pt_insert(struct ProcessTable *table, const struct Process *process) {
+    if (process->state < -1 || process->state > 1) {
+        return PT_NULL_HANDLE;
+    }
+
+    // Keep the ID index at most 70% full.
+    if ((uint64_t)(table->count + 1) * 10 > (uint64_t)table->index->capacity * 7) {
+        if (!_pt_index_grow(table)) {
+            return PT_NULL_HANDLE;
+        }
+    }
+
+    if (table->free_head == PT_NO_SLOT && !_pt_add_slab(table)) {
+        return PT_NULL_HANDLE;
+    }
+
+    uint32_t slot_index = table->free_head;
+    struct ProcessSlot *slot = _pt_slot(table, slot_index);
+    table->free_head = slot->next_free;
+
+    slot->process = *process;
+    slot->in_use = true;
+    slot->created_prev = table->created_tail;
+    slot->created_next = PT_NO_SLOT;
+    if (table->created_tail != PT_NO_SLOT) {
+        _pt_slot(table, table->created_tail)->created_next = slot_index;
+    }
+    else {
+        table->created_head = slot_index;
+    }
+    table->created_tail = slot_index;
+    table->count++;
+    _pt_slab(table, slot_index)->priority_column[slot_index % PT_SLAB_SIZE] = process->priority;
+    _pt_slab(table, slot_index)->start_column[slot_index % PT_SLAB_SIZE] = process->start_time;
+    _pt_link(table, slot_index, process->state);
+
+    _pt_index_place(table->index, process->id, slot_index);
+    return _pt_handle(slot_index, slot->generation);
+}
+
+ProcessHandle pt_find(const struct ProcessTable *table, int id) {
+    const struct ProcessIndex *index = table->index;
+    uint32_t mask = index->capacity - 1;
+    uint32_t bucket = _pt_hash(id, index->capacity);
+
+    while (index->buckets[bucket] != 0) {
+        uint32_t slot_index = index->buckets[bucket] - 1;
+        struct ProcessSlot *slot = _pt_slot(table, slot_index);
+        if (slot->process.id == id) {
+            return _pt_handle(slot_index, slot->generation);
+        }
+        bucket = (bucket + 1) & mask;
+    }
+    return PT_NULL_HANDLE;
+}
+
+bool pt_read(const struct ProcessTable *table, int id, struct Process *out) {
+    const struct ProcessIndex *index = __atomic_load_n(&table->index, __ATOMIC_ACQUIRE);
+    uint32_t mask = index->capacity - 1;
+    uint32_t bucket = _pt_hash(id, index->capacity);
+
+    // Bounded probe: a concurrent writer may be shifting entries, so never trust the table to contain a hole.
+    for (uint32_t probes = 0; probes < index->capacity; probes++) {
+        uint32_t entry = __atomic_load_n(&index->buckets[bucket], __ATOMIC_RELAXED);
+        if (entry == 0) {
+            return false;
+        }
+
+        struct ProcessSlab *slab = __atomic_load_n(&table->slabs[(entry - 1) / PT_SLAB_SIZE], __ATOMIC_ACQUIRE);
+        if (slab != NULL) {
+            const struct ProcessSlot *slot = &slab->slots[(entry - 1) % PT_SLAB_SIZE];
+            if (slot->process.id == id) {
+                *out = slot->process;
+                return true;
+            }
+        }
+        bucket = (bucket + 1) & mask;
+    }
+    return false;
+}
+
+struct Process *pt_get(const struct ProcessTable *table, ProcessHandle handle) {
+    struct ProcessSlot *slot = _pt_resolve(table, handle);
+    return (slot != NULL) ? &slot->process : NULL;
+}
+
+bool pt_remove(struct ProcessTable *table, ProcessHandle handle) {
+    struct ProcessSlot *slot = _pt_resolve(table, handle);
+    if (slot == NULL) {
+        return false;
+    }
+
+    uint32_t slot_index = (uint32_t)handle;
+    _pt_index_erase(table, slot->process.id, slot_index);
+    _pt_unlink(table, slot_index);
+    _pt_release(table, slot_index);
+    return true;
+}
+
+/**
+ * Scans the columns of one slab for slots matching a filter, branch-free so the compiler can vectorize the compares.
+ *
+ * @param matches Receives the offsets of the matching slots within the slab.
+ * @return uint32_t Number of matches.
+ */
+static uint32_t _pt_match(const struct ProcessSlab *slab, const struct ProcessFilter *filter, uint16_t *matches) {
+    // A single range check on the state column covers one state, any state, and skips free slots.
+    int state_min = (filter->state == PT_ANY_STATE) ? -1 : filter->state;
+    int state_max = (filter->state == PT_ANY_STATE) ? 1 : filter->state;
+    uint32_t num_matches = 0;
+
+    for (uint32_t i = 0; i < PT_SLAB_SIZE; i++) {
+        bool match = (slab->state_column[i] >= state_min) & (slab->state_column[i] <= state_max) &
+                     (slab->priority_column[i] >= filter->priority_min) & (slab->priority_column[i] <= filter->priority_max) &
+                     (slab->start_column[i] >= filter->start_min) & (slab->start_column[i] <= filter->start_max);
+        matches[num_matches] = (uint16_t)i;
+        num_matches += match;
+    }
+    return num_matches;
+}
+
+uint32_t pt_remove_where(struct ProcessTable *table, const struct ProcessFilter *filter) {
+    if ((filter->state < -1 || filter->state > 1) && filter->state != PT_ANY_STATE) {
+        return 0;
+    }
+
+    // Remove one by one until the removals pass the bulk share, then leave the index and heap
+    // stale and rebuild both once at the end.
+    uint32_t bulk_limit = table->count / PT_BULK_SHARE;
+    uint32_t removed = 0;
+    bool bulk = false;
+    uint16_t matches[PT_SLAB_SIZE];
+
+    for (uint32_t s = 0; s < table->num_slabs; s++) {
+        uint32_t num_matches = _pt_match(table->slabs[s], filter, matches);
+        for (uint32_t m = 0; m < num_matches; m++) {
+            uint32_t slot_index = s * PT_SLAB_SIZE + matches[m];
+            if (!bulk && removed >= bulk_limit) {
+                bulk = true;
+            }
+            if (bulk) {
+                _pt_list_unlink(table, slot_index);
+            }
+            else {
+                _pt_index_erase(table, _pt_slot(table, slot_index)->process.id, slot_index);
+                _pt_unlink(table, slot_index);
+            }
+            _pt_release(table, slot_index);
+            removed++;
+        }
+    }
+
+    if (bulk) {
+        _pt_index_rebuild(table);
+        _pt_heap_build(table);
+    }
+    return removed;
+}
+
+uint32_t pt_move_state(struct ProcessTable *table, int from, int to) {
+    if (from < -1 || from > 1 || to < -1 || to > 1 || from == to || table->state_head[from + 1] == PT_NO_SLOT) {
+        return 0;
+    }
+
+    int from_list = from + 1;
+    int to_list = to + 1;
+    uint32_t moved = table->state_count[from_list];
+    uint32_t old_count = table->state_count[to_list];
+
+    // Update the processes first, then splice the whole list onto the end of the other one.
+    for (uint32_t i = table->state_head[from_list]; i != PT_NO_SLOT; i = _pt_slot(table, i)->state_next) {
+        _pt_slot(table, i)->process.state = to;
+        _pt_slab(table, i)->state_column[i % PT_SLAB_SIZE] = (int8_t)to;
+    }
+
+    uint32_t first = table->state_head[from_list];
+    if (table->state_tail[to_list] != PT_NO_SLOT) {
+        _pt_slot(table, table->state_tail[to_list])->state_next = first;
+    }
+    else {
+        table->state_head[to_list] = first;
+    }
+    _pt_slot(table, first)->state_prev = table->state_tail[to_list];
+    table->state_tail[to_list] = table->state_tail[from_list];
+    table->state_count[to_list] += moved;
+
+    table->state_head[from_list] = PT_NO_SLOT;
+    table->state_tail[from_list] = PT_NO_SLOT;
+    table->state_count[from_list] = 0;
+
+    // A few new Ready processes are pushed one by one, many are cheaper to heapify together.
+    if (to == 0 && moved > old_count / PT_BULK_SHARE) {
+        _pt_heap_build(table);
+    }
+    else if (to == 0) {
+        uint32_t pos = old_count;
+        for (uint32_t i = first; i != PT_NO_SLOT; i = _pt_slot(table, i)->state_next) {
+            _pt_heap_set(table, pos, i);
+            _pt_heap_up(table, pos);
+            pos++;
+        }
+    }
+    return moved;
+}
+
+bool pt_set_state(struct ProcessTable *table, ProcessHandle handle, int state) {
+    struct ProcessSlot *slot = _pt_resolve(table, handle);
+    if (slot == NULL || state < -1 || state > 1) {
+        return false;
+    }
+
+    uint32_t slot_index = (uint32_t)handle;
+    _pt_unlink(table, slot_index);
+    slot->process.state = state;
+    _pt_link(table, slot_index, state);
+    return true;
+}
+
+bool pt_set_priority(struct ProcessTable *table, ProcessHandle handle, int priority) {
+    struct ProcessSlot *slot = _pt_resolve(table, handle);
+    if (slot == NULL) {
+        return false;
+    }
+
+    slot->process.priority = priority;
+    _pt_slab(table, (uint32_t)handle)->priority_column[(uint32_t)handle % PT_SLAB_SIZE] = priority;
+    if (slot->process.state == 0) {
+        _pt_heap_up(table, slot->heap_pos);
+        _pt_heap_down(table, slot->heap_pos);
+    }
+    return true;
+}
+
+ProcessHandle pt_ready_top(const struct ProcessTable *table) {
+    if (table->state_count[1] == 0) {
+        return PT_NULL_HANDLE;
+    }
+    uint32_t slot_index = table->ready_heap[0];
+    return _pt_handle(slot_index, _pt_slot(table, slot_index)->generation);
+}
+
+uint32_t pt_state_count(const struct ProcessTable *table, int state) {
+    return (state >= -1 && state <= 1) ? table->state_count[state + 1] : 0;
+}
+
+ProcessHandle pt_state_first(const struct ProcessTable *table, int state) {
+    if (state < -1 || state > 1 || table->state_head[state + 1] == PT_NO_SLOT) {
+        return PT_NULL_HANDLE;
+    }
+    uint32_t slot_index = table->state_head[state + 1];
+    return _pt_handle(slot_index, _pt_slot(table, slot_index)->generation);
+}
+
+ProcessHandle pt_state_next(const struct ProcessTable *table, ProcessHandle handle) {
+    struct ProcessSlot *slot = _pt_resolve(table, handle);
+    if (slot == NULL || slot->state_next == PT_NO_SLOT) {
+        return PT_NULL_HANDLE;
+    }
+    return _pt_handle(slot->state_next, _pt_slot(table, slot->state_next)->generation);
+}
+
+ProcessHandle pt_first(const struct ProcessTable *table) {
+    uint32_t first = table->created_head;
+    return (first != PT_NO_SLOT) ? _pt_handle(first, _pt_slot(table, first)->generation) : PT_NULL_HANDLE;
+}
+
+ProcessHandle pt_next(const struct ProcessTable *table, ProcessHandle handle) {
+    struct ProcessSlot *slot = _pt_resolve(table, handle);
+    if (slot == NULL || slot->created_next == PT_NO_SLOT) {
+        return PT_NULL_HANDLE;
+    }
+    return _pt_handle(slot->created_next, _pt_slot(table, slot->created_next)->generation);
+}
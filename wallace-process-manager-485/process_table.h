@@ -0,0 +1,265 @@
+/**
+ * Process table header file.
+ * Slab-allocated process slots addressed by generation-checked handles.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#ifndef PROCESS_TABLE_H
+#define PROCESS_TABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define PT_SLAB_SIZE 4096       // Slots per slab, allocated together.
+#define PT_MAX_SLABS 4096       // Maximum number of slabs (16,777,216 slots).
+#define PT_NULL_HANDLE 0        // Handle value that never refers to a process.
+#define PT_NO_SLOT UINT32_MAX   // Slot index used to terminate the free list and the state lists.
+#define PT_NUM_STATES 3         // Blocked (-1), Ready (0), and Running (1), stored at [state + 1].
+#define PT_ANY_STATE 2          // Filter state matching every state.
+#define PT_FREE_STATE INT8_MAX  // State column value of a free slot.
+
+struct Process {
+    int id;
+    int state;
+    int priority;
+    int start_time;         // Arrival time to the scheduling algorithms (see schedule.h).
+    int work_time;          // Burst time to the scheduling algorithms.
+    int finish_time;        // Results of the last scheduling run, 0 until one runs.
+    int turnaround_time;
+    int waiting_time;
+    int task;               // Task this process is one CPU burst of, 0 for a task of its own (see schedule.h).
+};
+
+/**
+ * Process handle. The low 32 bits hold the slot index, the high 32 bits hold the
+ * generation of the slot when the handle was issued. A handle goes stale as soon as
+ * its process is removed, even if the slot is later reused.
+ */
+typedef uint64_t ProcessHandle;
+
+struct ProcessSlot {
+    struct Process process;
+    uint32_t generation;    // Incremented every time the slot is released.
+    uint32_t next_free;     // Next slot in the free list, only valid while free.
+    uint32_t state_prev;    // Previous process in the same state list.
+    uint32_t state_next;    // Next process in the same state list.
+    uint32_t created_prev;  // Previous process in creation order.
+    uint32_t created_next;  // Next process in creation order.
+    uint32_t heap_pos;      // Position in the ready heap, only valid while Ready.
+    bool in_use;
+};
+
+/**
+ * The state, priority, and start time of every slot are also kept in columns next to the slots,
+ * so the bulk operations can filter a whole slab with tight branch-free loops over a few
+ * contiguous arrays instead of striding through the slots.
+ */
+struct ProcessSlab {
+    struct ProcessSlot slots[PT_SLAB_SIZE];
+    int8_t state_column[PT_SLAB_SIZE];      // PT_FREE_STATE while the slot is free.
+    int32_t priority_column[PT_SLAB_SIZE];
+    int32_t start_column[PT_SLAB_SIZE];
+};
+
+/**
+ * Predicate for the bulk operations. Every bound is inclusive.
+ */
+struct ProcessFilter {
+    int state;              // -1, 0, 1, or PT_ANY_STATE.
+    int priority_min;
+    int priority_max;
+    int start_min;
+    int start_max;
+};
+
+/**
+ * Open-addressed process ID index. The capacity lives next to the buckets so that a reader
+ * racing a resize always sees a matching pair.
+ */
+struct ProcessIndex {
+    uint32_t capacity;              // Number of buckets (power of two).
+    struct ProcessIndex *retired;   // Older index kept alive for optimistic readers, see retain_retired.
+    uint32_t buckets[];             // (slot index + 1), 0 == empty.
+};
+
+struct ProcessTable {
+    struct ProcessSlab *slabs[PT_MAX_SLABS];
+    uint32_t num_slabs;     // Number of allocated slabs.
+    uint32_t free_head;     // First free slot index, PT_NO_SLOT when the free list is empty.
+    uint32_t count;         // Number of live processes.
+
+    // Intrusive doubly-linked list of processes per state, oldest first.
+    uint32_t state_head[PT_NUM_STATES];
+    uint32_t state_tail[PT_NUM_STATES];
+    uint32_t state_count[PT_NUM_STATES];
+
+    // Intrusive doubly-linked list of every process, oldest first.
+    uint32_t created_head;
+    uint32_t created_tail;
+
+    // Indexed binary min-heap of Ready slot indices, ordered by (priority, start time, ID).
+    // Sized to the slab capacity so pushing never allocates.
+    uint32_t *ready_heap;
+
+    struct ProcessIndex *index;
+    bool retain_retired;    // Keep replaced indexes until pt_destroy, needed by pt_read (false by default).
+
+    // Memory the table uses but does not own (e.g. a mapped snapshot, see snapshot.c).
+    // Slabs, heap, and index inside this range are never freed or resized in place.
+    const char *borrowed;
+    size_t borrowed_size;
+};
+
+/**
+ * Initializes an empty process table. No slabs are allocated until the first insert.
+ *
+ * @param table Table to initialize.
+ * @return bool False if the ID index could not be allocated.
+ */
+bool pt_init(struct ProcessTable *table);
+
+/**
+ * Frees all slabs and the ID index of a process table. Borrowed memory is left alone.
+ *
+ * @param table Table to destroy.
+ */
+void pt_destroy(struct ProcessTable *table);
+
+/**
+ * Inserts a copy of a process into the table. Slots are taken from the free list first,
+ * a new slab is only allocated when the free list is empty. The process is appended to the
+ * list of its state, which must be -1, 0, or 1.
+ * The caller is responsible for checking that the process ID is not already in use.
+ *
+ * @param table Table to insert into.
+ * @param process Process to copy into the table.
+ * @return ProcessHandle Handle of the new process, PT_NULL_HANDLE if the table is full.
+ */
+ProcessHandle pt_insert(struct ProcessTable *table, const struct Process *process);
+
+/**
+ * Looks up a process by its process ID.
+ *
+ * @param table Table to search.
+ * @param id Process ID.
+ * @return ProcessHandle Handle of the process, PT_NULL_HANDLE if not found.
+ */
+ProcessHandle pt_find(const struct ProcessTable *table, int id);
+
+/**
+ * Optimistic lookup for readers that do not hold the writer's lock (see concurrent_table.c).
+ * Never faults while a single writer mutates the table, as long as retain_retired is set,
+ * but may return a torn or stale copy; the caller must validate the result (e.g. with a seqlock).
+ *
+ * @param table Table to search.
+ * @param id Process ID.
+ * @param out Receives a copy of the process if found.
+ * @return bool True if a process with that ID was seen.
+ */
+bool pt_read(const struct ProcessTable *table, int id, struct Process *out);
+
+/**
+ * Resolves a handle to its process.
+ *
+ * @param table Table the handle was issued by.
+ * @param handle Process handle.
+ * @return struct Process* The process, NULL if the handle is stale or invalid.
+ */
+struct Process *pt_get(const struct ProcessTable *table, ProcessHandle handle);
+
+/**
+ * Removes a process in O(1), returning its slot to the free list.
+ * Every outstanding handle to the process becomes stale.
+ *
+ * @param table Table to remove from.
+ * @param handle Handle of the process to remove.
+ * @return bool False if the handle is stale or invalid.
+ */
+bool pt_remove(struct ProcessTable *table, ProcessHandle handle);
+
+/**
+ * Removes every process matching a filter in one pass over the state columns. When a large
+ * share of the table goes, the ID index and the ready heap are rebuilt once at the end
+ * instead of being updated for every removed process.
+ *
+ * @param table Table to remove from.
+ * @param filter Processes to remove, the state must be -1, 0, 1, or PT_ANY_STATE.
+ * @return uint32_t Number of processes removed.
+ */
+uint32_t pt_remove_where(struct ProcessTable *table, const struct ProcessFilter *filter);
+
+/**
+ * Moves every process in one state to the end of another state's list, in list order.
+ * The lists are spliced in O(1) and the ready heap is rebuilt once if processes become Ready.
+ *
+ * @param table Process table.
+ * @param from State to empty (-1, 0, or 1).
+ * @param to State to move the processes to (-1, 0, or 1).
+ * @return uint32_t Number of processes moved, 0 if a state is out of range.
+ */
+uint32_t pt_move_state(struct ProcessTable *table, int from, int to);
+
+/**
+ * Moves a process to another state in O(1), keeping the state lists up to date.
+ * The state field of a process in the table must only be changed through this function.
+ *
+ * @param table Table the handle was issued by.
+ * @param handle Process handle.
+ * @param state New state (-1, 0, or 1). The process is appended to the end of its list.
+ * @return bool False if the handle is stale or invalid, or the state is out of range.
+ */
+bool pt_set_state(struct ProcessTable *table, ProcessHandle handle, int state);
+
+/**
+ * Changes the priority of a process in O(log n), re-ordering the ready heap if the process is Ready.
+ * The priority field of a process in the table must only be changed through this function.
+ *
+ * @param table Table the handle was issued by.
+ * @param handle Process handle.
+ * @param priority New priority (lower value == higher priority).
+ * @return bool False if the handle is stale or invalid.
+ */
+bool pt_set_priority(struct ProcessTable *table, ProcessHandle handle, int priority);
+
+/**
+ * Highest-priority Ready process in O(1): lowest priority value, ties broken by earliest
+ * start time and then lowest ID.
+ *
+ * @param table Process table.
+ * @return ProcessHandle The process, PT_NULL_HANDLE if no process is Ready.
+ */
+ProcessHandle pt_ready_top(const struct ProcessTable *table);
+
+/**
+ * Number of processes in a state.
+ *
+ * @param table Process table.
+ * @param state State (-1, 0, or 1).
+ * @return uint32_t Process count, 0 if the state is out of range.
+ */
+uint32_t pt_state_count(const struct ProcessTable *table, int state);
+
+/**
+ * State list iteration helpers, visiting the processes in one state from oldest to newest in O(k):
+ * for (ProcessHandle h = pt_state_first(table, 0); h != PT_NULL_HANDLE; h = pt_state_next(table, h))
+ * pt_state_first on its own is the O(1) "pick next" of a state.
+ *
+ * @return ProcessHandle Next process in the same state, PT_NULL_HANDLE when there are no more.
+ */
+ProcessHandle pt_state_first(const struct ProcessTable *table, int state);
+ProcessHandle pt_state_next(const struct ProcessTable *table, ProcessHandle handle);
+
+/**
+ * Iteration helpers, visiting live processes in the order they were inserted, oldest first, in O(1) per step:
+ * for (ProcessHandle h = pt_first(table); h != PT_NULL_HANDLE; h = pt_next(table, h))
+ *
+ * @return ProcessHandle Next live process, PT_NULL_HANDLE when there are no more.
+ */
+ProcessHandle pt_first(const struct ProcessTable *table);
+ProcessHandle pt_next(const struct ProcessTable *table, ProcessHandle handle);
+
+#endif // PROCESS_TABLE_H
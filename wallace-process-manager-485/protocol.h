@@ -0,0 +1,53 @@
+/**
+ * Process manager socket protocol header file.
+ * Binary request and response records exchanged between the server (server.c) and its
+ * clients (client.c) over a Unix domain socket. Both records are fixed-size, so requests can be
+ * pipelined: a client may write any number of requests back to back, and the server answers
+ * each one with exactly one response, in order. Fields use the host's byte order, since the
+ * socket never leaves the machine.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <stdint.h>
+
+#define PROTOCOL_RESULT_BAD_OP 100  // Response result for an unknown request operation.
+
+enum RequestOp {
+    REQUEST_CREATE = 1,     // args: priority, start time, work time
+    REQUEST_SCHEDULE,       // args: current state, next state
+    REQUEST_TERMINATE,
+    REQUEST_QUERY,          // Look up a process by ID.
+    REQUEST_DISPATCH,       // id is ignored.
+    REQUEST_PRIORITY,       // args: priority
+    REQUEST_PURGE,          // id: filter state, args: min/max priority, min/max start time
+    REQUEST_UNBLOCK         // id is ignored.
+};
+
+/**
+ * One request, 24 bytes.
+ */
+struct Request {
+    uint32_t op;            // enum RequestOp.
+    int32_t id;             // Process ID.
+    int32_t args[4];        // Unused arguments are ignored.
+};
+
+/**
+ * One response, 24 bytes.
+ * query:               values = state, priority, start time, work time
+ * dispatch:            id = dispatched process
+ * purge, unblock:      values[0] = number of processes affected
+ */
+struct Response {
+    int32_t result;         // enum ManagerResult, or PROTOCOL_RESULT_BAD_OP.
+    int32_t id;             // Process ID the request was about.
+    int32_t values[4];
+};
+
+#endif // PROTOCOL_H
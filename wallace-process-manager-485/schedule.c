@@ -0,0 +1,2067 @@
+/**
+ * Scheduling algorithm implementation file.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#include "schedule.h"
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * Process in arrival order. The key holds the start time in the high 32 bits and the ID in the
+ * low 32 bits, both with the sign bit flipped so they sort as unsigned integers.
+ */
+struct ScheduleEntry {
+    uint64_t key;
+    ProcessHandle handle;
+};
+
+/**
+ * What the policy loops read on every step of one process, copied out of the table once per run
+ * (or once for every algorithm being compared), in arrival order. Kept to 8 bytes so that eight
+ * jobs share a cache line while the loops look ahead for arrivals and size up slices.
+ */
+struct ScheduleJob {
+    int start_time;
+    int work_time;
+};
+
+/**
+ * The rest of a job, in a parallel array: read once when the process arrives (by the priority
+ * and predictive policies) and when one of its slices is recorded, never by the arrival and
+ * ready-queue loops.
+ */
+struct ScheduleDetail {
+    int priority;
+    int id;
+    int task;
+};
+
+/**
+ * State of one run, shared by the policy loops and the hook helpers.
+ */
+struct ScheduleRun {
+    const struct ScheduleJob *jobs;
+    const struct ScheduleDetail *details;
+    struct ProcessTable *table;     // Where the results are written, NULL when comparing.
+    const ProcessHandle *handles;   // Table handle of each job, NULL when comparing.
+    uint32_t count;
+    uint32_t next;          // Rank of the first process that has not arrived.
+    uint32_t ready;         // Arrived processes waiting for the CPU.
+    uint32_t done;
+    long long time;
+    int quantum;            // Quantum of the slice being dispatched, 0 if the algorithm is not time-sliced.
+    const struct ScheduleHooks *hooks;
+    struct Timeline *timeline;  // NULL if the slices are not recorded.
+    bool recorded;              // False once a slice could not be recorded.
+    struct ScheduleStats totals;
+    const struct ScheduleLocking *locking;  // PPRI lock state, for the hooks, NULL otherwise.
+};
+
+/**
+ * One algorithm of a comparison, run on its own thread.
+ */
+struct ScheduleTask {
+    struct ScheduleRun run;
+    enum SchedulePolicy policy;
+    struct ScheduleParams params;
+    bool ok;
+    pthread_t thread;
+};
+
+static uint64_t _scheduleKey(int high, int low) {
+    return ((uint64_t)((uint32_t)high ^ 0x80000000u) << 32) | ((uint32_t)low ^ 0x80000000u);
+}
+
+/**
+ * LSD radix sort by key, one byte at a time. Bytes that are the same in every key are skipped,
+ * so small start times and IDs only take a few passes.
+ *
+ * @return struct ScheduleEntry* entries or scratch, whichever ended up holding the sorted result.
+ */
+static struct ScheduleEntry *_scheduleSort(struct ScheduleEntry *entries, struct ScheduleEntry *scratch, uint32_t count) {
+    uint32_t histogram[8][256];     // 8 KiB on the stack, so sorts on several threads never share it.
+    memset(histogram, 0, sizeof(histogram));
+    for (uint32_t i = 0; i < count; i++) {
+        for (int byte = 0; byte < 8; byte++) {
+            histogram[byte][(entries[i].key >> (byte * 8)) & 0xFF]++;
+        }
+    }
+
+    for (int byte = 0; byte < 8; byte++) {
+        uint32_t *buckets = histogram[byte];
+        if (buckets[(entries[0].key >> (byte * 8)) & 0xFF] == count) {
+            continue;
+        }
+        uint32_t offset = 0;
+        for (int b = 0; b < 256; b++) {
+            uint32_t size = buckets[b];
+            buckets[b] = offset;
+            offset += size;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            scratch[buckets[(entries[i].key >> (byte * 8)) & 0xFF]++] = entries[i];
+        }
+        struct ScheduleEntry *swap = entries;
+        entries = scratch;
+        scratch = swap;
+    }
+    return entries;
+}
+
+/**
+ * @param extra Bytes per process to allocate after the sort's scratch space.
+ * @return struct ScheduleEntry* Every process in arrival order (to free), NULL if empty or out of memory.
+ */
+static struct ScheduleEntry *_scheduleOrder(const struct ProcessTable *table, uint32_t *count, size_t extra) {
+    *count = table->count;
+    if (table->count == 0) {
+        return NULL;
+    }
+    struct ScheduleEntry *entries = malloc((2 * sizeof(struct ScheduleEntry) + extra) * (size_t)table->count);
+    if (entries == NULL) {
+        return NULL;
+    }
+
+    uint32_t n = 0;
+    for (ProcessHandle h = pt_first(table); h != PT_NULL_HANDLE; h = pt_next(table, h)) {
+        const struct Process *process = pt_get(table, h);
+        entries[n].key = _scheduleKey(process->start_time, process->id);
+        entries[n].handle = h;
+        n++;
+    }
+    if (_scheduleSort(entries, entries + n, n) != entries) {
+        memcpy(entries, entries + n, n * sizeof(struct ScheduleEntry));
+    }
+    return entries;
+}
+
+/**
+ * Copies every process into the job and detail arrays in arrival order. Both go in the second half of
+ * the sort's allocation, which is made large enough for them, and the handles are compacted into the
+ * first half.
+ *
+ * @param details Receives the details, parallel to the jobs.
+ * @param handles Receives the handles in arrival order. Freeing them also frees the jobs and details.
+ * @return struct ScheduleJob* The jobs, NULL if empty or out of memory.
+ */
+static struct ScheduleJob *_scheduleJobs(const struct ProcessTable *table, uint32_t *count,
+                                         struct ScheduleDetail **details, ProcessHandle **handles) {
+    size_t extra = sizeof(struct ScheduleJob) + sizeof(struct ScheduleDetail) - sizeof(struct ScheduleEntry);
+    struct ScheduleEntry *order = _scheduleOrder(table, count, extra);
+    if (order == NULL) {
+        return NULL;
+    }
+    struct ScheduleJob *jobs = (struct ScheduleJob *)(order + *count);
+    struct ScheduleDetail *detail = (struct ScheduleDetail *)(jobs + *count);
+    ProcessHandle *compact = (ProcessHandle *)order;
+    for (uint32_t i = 0; i < *count; i++) {
+        ProcessHandle handle = order[i].handle;
+        const struct Process *process = pt_get(table, handle);
+        jobs[i].start_time = process->start_time;
+        jobs[i].work_time = process->work_time;
+        detail[i].priority = process->priority;
+        detail[i].id = process->id;
+        detail[i].task = process->task;
+        compact[i] = handle;
+    }
+    *details = detail;
+    *handles = compact;
+    return jobs;
+}
+
+static void _scheduleLockEvent(const struct ScheduleRun *run, uint32_t rank, struct ScheduleEvent *event);
+
+/**
+ * Calls a hook, if set, with the current counts.
+ */
+static void _scheduleNotify(const struct ScheduleRun *run, void (*hook)(const struct ScheduleEvent *, void *), uint32_t rank) {
+    if (hook == NULL) {
+        return;
+    }
+    struct ScheduleEvent event = { run->time, pt_get(run->table, run->handles[rank]), run->count - run->next, run->ready, run->done, run->quantum,
+                                   NULL, 0, 0 };
+    if (run->locking != NULL) {
+        _scheduleLockEvent(run, rank, &event);
+    }
+    hook(&event, run->hooks->context);
+}
+
+/**
+ * Records that a process just ran for length time units, up to the current time.
+ */
+static void _scheduleRecord(struct ScheduleRun *run, uint32_t rank, long long length) {
+    if (run->timeline != NULL && !timeline_append(run->timeline, run->time - length, length, run->details[rank].id)) {
+        run->recorded = false;
+    }
+}
+
+/**
+ * Adds up the results of a process that finished at the current time, and writes them into the table.
+ */
+static void _scheduleFinish(struct ScheduleRun *run, uint32_t rank) {
+    const struct ScheduleJob *job = &run->jobs[rank];
+    long long turnaround = run->time - job->start_time;
+    run->totals.total_turnaround += turnaround;
+    run->totals.total_wait += turnaround - job->work_time;
+    run->totals.finish_time = run->time;
+    run->done++;
+    if (run->table != NULL) {
+        struct Process *process = pt_get(run->table, run->handles[rank]);
+        process->finish_time = (int)run->time;
+        process->turnaround_time = (int)turnaround;
+        process->waiting_time = (int)(turnaround - job->work_time);
+        _scheduleNotify(run, run->hooks->complete, rank);
+    }
+}
+
+static void _scheduleFCFS(struct ScheduleRun *run) {
+    const struct ScheduleJob *jobs = run->jobs;
+    for (uint32_t rank = 0; rank < run->count; rank++) {
+        if (run->time < jobs[rank].start_time) {
+            run->time = jobs[rank].start_time;
+        }
+        while (run->next < run->count && jobs[run->next].start_time <= run->time) {
+            run->next++;
+        }
+        run->ready = run->next - rank - 1;
+        _scheduleNotify(run, run->hooks->dispatch, rank);
+
+        run->time += jobs[rank].work_time;
+        _scheduleRecord(run, rank, jobs[rank].work_time);
+        while (run->next < run->count && jobs[run->next].start_time <= run->time) {
+            run->next++;
+        }
+        run->ready = run->next - rank - 1;
+        _scheduleFinish(run, rank);
+    }
+}
+
+static void _scheduleHeapPush(uint64_t *heap, uint32_t *size, uint64_t key) {
+    uint32_t pos = (*size)++;
+    while (pos > 0 && heap[(pos - 1) / 2] > key) {
+        heap[pos] = heap[(pos - 1) / 2];
+        pos = (pos - 1) / 2;
+    }
+    heap[pos] = key;
+}
+
+static uint64_t _scheduleHeapPop(uint64_t *heap, uint32_t *size) {
+    uint64_t top = heap[0];
+    uint64_t last = heap[--(*size)];
+    uint32_t pos = 0;
+    for (;;) {
+        uint32_t child = 2 * pos + 1;
+        if (child >= *size) {
+            break;
+        }
+        if (child + 1 < *size && heap[child + 1] < heap[child]) {
+            child++;
+        }
+        if (heap[child] >= last) {
+            break;
+        }
+        heap[pos] = heap[child];
+        pos = child;
+    }
+    heap[pos] = last;
+    return top;
+}
+
+/**
+ * Same as _scheduleHeapPush, for keys narrowed to 32 bits.
+ */
+static void _scheduleHeapPush32(uint32_t *heap, uint32_t *size, uint32_t key) {
+    uint32_t pos = (*size)++;
+    while (pos > 0 && heap[(pos - 1) / 2] > key) {
+        heap[pos] = heap[(pos - 1) / 2];
+        pos = (pos - 1) / 2;
+    }
+    heap[pos] = key;
+}
+
+/**
+ * Same as _scheduleHeapPop, for keys narrowed to 32 bits.
+ */
+static uint32_t _scheduleHeapPop32(uint32_t *heap, uint32_t *size) {
+    uint32_t top = heap[0];
+    uint32_t last = heap[--(*size)];
+    uint32_t pos = 0;
+    for (;;) {
+        uint32_t child = 2 * pos + 1;
+        if (child >= *size) {
+            break;
+        }
+        if (child + 1 < *size && heap[child + 1] < heap[child]) {
+            child++;
+        }
+        if (heap[child] >= last) {
+            break;
+        }
+        heap[pos] = heap[child];
+        pos = child;
+    }
+    heap[pos] = last;
+    return top;
+}
+
+/**
+ * @return int Bits needed to hold every value up to max.
+ */
+static int _scheduleBits(uint64_t max) {
+    int bits = 0;
+    while (bits < 64 && (max >> bits) != 0) {
+        bits++;
+    }
+    return bits;
+}
+
+/**
+ * Heap ordering key of a process that just arrived.
+ */
+struct ScheduleHeapKey {
+    bool narrow;            // Keys fit in 32 bits: (value - min) << rank_bits | rank.
+    int rank_bits;
+    int min;
+    bool by_priority;
+};
+
+static int _scheduleHeapValue(const struct ScheduleRun *run, const struct ScheduleHeapKey *key, uint32_t rank) {
+    return key->by_priority ? run->details[rank].priority : run->jobs[rank].work_time;
+}
+
+/**
+ * Pushes every process that has arrived by the current time.
+ */
+static void _scheduleHeapArrive(struct ScheduleRun *run, const struct ScheduleHeapKey *key, void *heap, uint32_t *size) {
+    for (; run->next < run->count && run->jobs[run->next].start_time <= run->time; run->next++) {
+        int value = _scheduleHeapValue(run, key, run->next);
+        if (key->narrow) {
+            uint32_t offset = (uint32_t)((long long)value - key->min);
+            _scheduleHeapPush32(heap, size, (offset << key->rank_bits) | run->next);
+        }
+        else {
+            _scheduleHeapPush(heap, size, ((uint64_t)((uint32_t)value ^ 0x80000000u) << 32) | run->next);
+        }
+    }
+}
+
+/**
+ * Non-preemptive shortest-burst-first or priority scheduling. The heap key holds the burst time or
+ * priority in the high bits and the arrival rank in the low bits, so ties go to the earliest arrival.
+ * When the range of values and the number of processes leave room, the keys are narrowed to 32 bits,
+ * which halves the memory the heap walks on every push and pop.
+ */
+static void _scheduleHeap(struct ScheduleRun *run, uint64_t *heap, bool by_priority) {
+    const struct ScheduleJob *jobs = run->jobs;
+    struct ScheduleHeapKey key = { false, _scheduleBits(run->count - 1), 0, by_priority };
+    if (run->count > 0) {
+        int min = _scheduleHeapValue(run, &key, 0);
+        int max = min;
+        for (uint32_t rank = 1; rank < run->count; rank++) {
+            int value = _scheduleHeapValue(run, &key, rank);
+            min = (value < min) ? value : min;
+            max = (value > max) ? value : max;
+        }
+        key.min = min;
+        key.narrow = (_scheduleBits((uint64_t)((long long)max - min)) + key.rank_bits <= 32);
+    }
+    uint32_t mask = (key.rank_bits < 32) ? ((uint32_t)1 << key.rank_bits) - 1 : UINT32_MAX;
+
+    uint32_t size = 0;
+    while (run->done < run->count) {
+        _scheduleHeapArrive(run, &key, heap, &size);
+        if (size == 0) {
+            run->time = jobs[run->next].start_time;
+            continue;
+        }
+
+        uint32_t rank = key.narrow ? (_scheduleHeapPop32((uint32_t *)heap, &size) & mask)
+                                   : (uint32_t)_scheduleHeapPop(heap, &size);
+        run->ready = size;
+        _scheduleNotify(run, run->hooks->dispatch, rank);
+
+        run->time += jobs[rank].work_time;
+        _scheduleRecord(run, rank, jobs[rank].work_time);
+        _scheduleHeapArrive(run, &key, heap, &size);
+        run->ready = size;
+        _scheduleFinish(run, rank);
+    }
+}
+
+/**
+ * @return uint32_t A ring position below 2 * count, brought back into the ring without a division.
+ */
+static uint32_t _scheduleWrap(uint32_t position, uint32_t count) {
+    return (position >= count) ? position - count : position;
+}
+
+#define SCHEDULE_ADAPT_BUCKETS 231              // Bursts of 1 to 15 exactly, then 8 buckets per power of two up to 2^31.
+#define SCHEDULE_ADAPT_GROWTH (1.0 + 1.0 / 128) // Weight of each burst over the one before it.
+#define SCHEDULE_ADAPT_RESCALE 1e200            // Burst weight at which every weight is scaled back down.
+
+/**
+ * Streaming percentile of the completed bursts, for adaptive round robin. Each burst adds its weight to
+ * a bucket of a log-scaled histogram (at most 1/8 wide), and each burst weighs SCHEDULE_ADAPT_GROWTH
+ * times the one before it, so a burst counts half as much after 89 more and the percentile follows the
+ * workload without chasing every long burst. A cursor stays on the bucket holding the percentile and moves one bucket at a time as bursts
+ * are added, so a burst costs O(1) amortized instead of a scan of the histogram.
+ */
+struct ScheduleAdapt {
+    double weights[SCHEDULE_ADAPT_BUCKETS];
+    double total;
+    double below;           // Weight of the buckets before the cursor.
+    double weight;          // Weight of the next burst.
+    double fraction;        // Percentile over 100.
+    int cursor;
+    int quantum;            // Largest burst of the cursor's bucket, the starting quantum until a burst completes.
+    long long quantum_sum;
+    uint32_t dispatches;
+};
+
+static void _scheduleAdaptInit(struct ScheduleAdapt *adapt, const struct ScheduleParams *params) {
+    memset(adapt, 0, sizeof(*adapt));
+    adapt->weight = 1;
+    adapt->fraction = params->percentile / 100.0;
+    adapt->quantum = params->quantum;
+}
+
+/**
+ * @return int Histogram bucket of a burst.
+ */
+static int _scheduleAdaptBucket(int burst) {
+    if (burst < 16) {
+        return (burst > 1) ? burst - 1 : 0;
+    }
+    int top = _scheduleBits((uint32_t)burst) - 1;
+    return 15 + (top - 4) * 8 + ((burst >> (top - 3)) & 7);
+}
+
+/**
+ * @return int Largest burst that falls in a bucket.
+ */
+static int _scheduleAdaptLimit(int bucket) {
+    if (bucket < 15) {
+        return bucket + 1;
+    }
+    int top = 4 + (bucket - 15) / 8;
+    return (int)(((long long)(9 + (bucket - 15) % 8) << (top - 3)) - 1);
+}
+
+/**
+ * Adds a completed burst and moves the quantum to the percentile's bucket.
+ */
+static void _scheduleAdaptAdd(struct ScheduleAdapt *adapt, int burst, struct ScheduleStats *totals) {
+    int bucket = _scheduleAdaptBucket(burst);
+    adapt->weights[bucket] += adapt->weight;
+    adapt->total += adapt->weight;
+    adapt->below += (bucket < adapt->cursor) ? adapt->weight : 0;
+    adapt->weight *= SCHEDULE_ADAPT_GROWTH;
+    if (adapt->weight > SCHEDULE_ADAPT_RESCALE) {
+        // Old bursts fade to nothing, recounting below also drops the rounding it picked up.
+        adapt->total = 0;
+        adapt->below = 0;
+        for (int i = 0; i < SCHEDULE_ADAPT_BUCKETS; i++) {
+            adapt->weights[i] /= adapt->weight;
+            adapt->total += adapt->weights[i];
+            adapt->below += (i < adapt->cursor) ? adapt->weights[i] : 0;
+        }
+        adapt->weight = 1;
+    }
+
+    // The percentile is in the first bucket where the weight up to and including it reaches the target,
+    // aimed a hair low so that rounding never walks the 100th percentile past the largest burst.
+    double target = adapt->fraction * adapt->total * (1 - 1e-9);
+    while (adapt->cursor < SCHEDULE_ADAPT_BUCKETS - 1 && adapt->below + adapt->weights[adapt->cursor] < target) {
+        adapt->below += adapt->weights[adapt->cursor++];
+    }
+    while (adapt->cursor > 0 && adapt->below >= target) {
+        adapt->below -= adapt->weights[--adapt->cursor];
+    }
+    int quantum = _scheduleAdaptLimit(adapt->cursor);
+    if (quantum != adapt->quantum) {
+        adapt->quantum = quantum;
+        totals->quantum_changes++;
+    }
+}
+
+/**
+ * @return int Quantum to dispatch the next process with, counted in the statistics.
+ */
+static int _scheduleAdaptDispatch(struct ScheduleAdapt *adapt, struct ScheduleStats *totals) {
+    if (adapt->dispatches == 0 || adapt->quantum < totals->min_quantum) {
+        totals->min_quantum = adapt->quantum;
+    }
+    if (adapt->quantum > totals->max_quantum) {
+        totals->max_quantum = adapt->quantum;
+    }
+    totals->last_quantum = adapt->quantum;
+    adapt->quantum_sum += adapt->quantum;
+    adapt->dispatches++;
+    return adapt->quantum;
+}
+
+/**
+ * Round robin over a ring of arrival ranks. Every process is in the ring at most once, so a ring of
+ * one slot per process never overflows. With an adapter, the quantum follows its percentile of the
+ * bursts completed so far.
+ */
+static void _scheduleRR(struct ScheduleRun *run, uint32_t *ring, int *remaining, int quantum, struct ScheduleAdapt *adapt) {
+    const struct ScheduleJob *jobs = run->jobs;
+    uint32_t head = 0;
+    uint32_t size = 0;
+    while (run->done < run->count) {
+        for (; run->next < run->count && jobs[run->next].start_time <= run->time; run->next++) {
+            remaining[run->next] = jobs[run->next].work_time;
+            ring[_scheduleWrap(head + size++, run->count)] = run->next;
+        }
+        if (size == 0) {
+            run->time = jobs[run->next].start_time;
+            continue;
+        }
+
+        uint32_t rank = ring[head];
+        head = _scheduleWrap(head + 1, run->count);
+        size--;
+        run->ready = size;
+        run->totals.dispatches++;
+        if (adapt != NULL) {
+            quantum = _scheduleAdaptDispatch(adapt, &run->totals);
+        }
+        run->quantum = quantum;
+        _scheduleNotify(run, run->hooks->dispatch, rank);
+
+        int slice = (remaining[rank] < quantum) ? remaining[rank] : quantum;
+        remaining[rank] -= slice;
+        run->time += slice;
+        _scheduleRecord(run, rank, slice);
+        // Processes that arrived during the slice queue ahead of the preempted one.
+        for (; run->next < run->count && jobs[run->next].start_time <= run->time; run->next++) {
+            remaining[run->next] = jobs[run->next].work_time;
+            ring[_scheduleWrap(head + size++, run->count)] = run->next;
+        }
+        run->ready = size;
+        if (remaining[rank] > 0) {
+            _scheduleNotify(run, run->hooks->preempt, rank);
+            ring[_scheduleWrap(head + size++, run->count)] = rank;
+        }
+        else {
+            if (adapt != NULL) {
+                _scheduleAdaptAdd(adapt, jobs[rank].work_time, &run->totals);
+            }
+            _scheduleFinish(run, rank);
+        }
+    }
+}
+
+/**
+ * Exponentially averaged burst estimates, one per task: tau(n+1) = alpha * t(n) + (1 - alpha) * tau(n).
+ */
+struct SchedulePredictor {
+    uint32_t *slot;         // Estimate of each job (by arrival rank), slot 0 for jobs without a task.
+    double *estimates;      // The estimate of slot 0 is never updated.
+    double alpha;
+    long long total_error;
+};
+
+/**
+ * Gives every task its own estimate, found through a temporary open-addressed table of task IDs.
+ *
+ * @return bool False if out of memory (nothing is left allocated).
+ */
+static bool _schedulePredictorInit(struct SchedulePredictor *predictor, const struct ScheduleRun *run,
+                                   const struct ScheduleParams *params) {
+    uint32_t capacity = 16;
+    while (capacity < 2 * (uint64_t)run->count && capacity < (1u << 31)) {
+        capacity *= 2;
+    }
+    predictor->slot = malloc((size_t)run->count * sizeof(uint32_t) + 1);
+    predictor->estimates = malloc(((size_t)run->count + 1) * sizeof(double));
+    int *tasks = malloc((size_t)capacity * sizeof(int));
+    uint32_t *slots = calloc(capacity, sizeof(uint32_t));
+    bool ok = (predictor->slot != NULL && predictor->estimates != NULL && tasks != NULL && slots != NULL);
+
+    uint32_t num_slots = 1;
+    for (uint32_t rank = 0; ok && rank < run->count; rank++) {
+        int task = run->details[rank].task;
+        uint32_t bucket = ((uint32_t)task * 2654435761u) & (capacity - 1);
+        while (task != 0 && slots[bucket] != 0 && tasks[bucket] != task) {
+            bucket = (bucket + 1) & (capacity - 1);
+        }
+        if (task != 0 && slots[bucket] == 0) {
+            tasks[bucket] = task;
+            slots[bucket] = num_slots++;
+        }
+        predictor->slot[rank] = (task != 0) ? slots[bucket] : 0;
+    }
+    for (uint32_t i = 0; ok && i < num_slots; i++) {
+        predictor->estimates[i] = params->estimate;
+    }
+    free(tasks);
+    free(slots);
+    if (!ok) {
+        free(predictor->slot);
+        free(predictor->estimates);
+        return false;
+    }
+    predictor->alpha = params->alpha;
+    predictor->total_error = 0;
+    return true;
+}
+
+/**
+ * @return uint32_t Current estimate of a job's burst, rounded.
+ */
+static uint32_t _schedulePredictorEstimate(const struct SchedulePredictor *predictor, uint32_t rank) {
+    double estimate = predictor->estimates[predictor->slot[rank]];
+    return (estimate >= UINT32_MAX) ? UINT32_MAX : (uint32_t)(estimate + 0.5);
+}
+
+/**
+ * Folds a completed burst into its task's estimate.
+ */
+static void _schedulePredictorUpdate(struct SchedulePredictor *predictor, uint32_t rank, int burst) {
+    uint32_t slot = predictor->slot[rank];
+    if (slot != 0) {
+        predictor->estimates[slot] = predictor->alpha * burst + (1 - predictor->alpha) * predictor->estimates[slot];
+    }
+}
+
+/**
+ * Queues every process that has arrived by the current time under its task's current estimate.
+ */
+static void _schedulePredictArrive(struct ScheduleRun *run, struct SchedulePredictor *predictor,
+                                   uint64_t *heap, uint32_t *size, int *remaining) {
+    for (; run->next < run->count && run->jobs[run->next].start_time <= run->time; run->next++) {
+        uint32_t estimate = _schedulePredictorEstimate(predictor, run->next);
+        long long error = (long long)estimate - run->jobs[run->next].work_time;
+        predictor->total_error += (error < 0) ? -error : error;
+        remaining[run->next] = run->jobs[run->next].work_time;
+        _scheduleHeapPush(heap, size, ((uint64_t)estimate << 32) | run->next);
+    }
+}
+
+/**
+ * Shortest-estimate-first scheduling. The heap key holds the estimated time left in the high 32 bits
+ * and the arrival rank in the low 32 bits. When preemptive, the running process is stopped at every
+ * arrival, and put back under what is left of its estimate (0 once it has run past it) if the
+ * shortest waiting estimate is now below that.
+ */
+static void _schedulePredictive(struct ScheduleRun *run, struct SchedulePredictor *predictor,
+                                uint64_t *heap, int *remaining, bool preemptive) {
+    const struct ScheduleJob *jobs = run->jobs;
+    uint32_t size = 0;
+    while (run->done < run->count) {
+        _schedulePredictArrive(run, predictor, heap, &size, remaining);
+        if (size == 0) {
+            run->time = jobs[run->next].start_time;
+            continue;
+        }
+
+        uint64_t key = _scheduleHeapPop(heap, &size);
+        uint32_t rank = (uint32_t)key;
+        long long left = (long long)(key >> 32);
+        run->ready = size;
+        _scheduleNotify(run, run->hooks->dispatch, rank);
+
+        bool preempted = false;
+        while (remaining[rank] > 0 && !preempted) {
+            long long slice = remaining[rank];
+            if (preemptive && run->next < run->count && jobs[run->next].start_time - run->time < slice) {
+                slice = jobs[run->next].start_time - run->time;
+            }
+            remaining[rank] -= (int)slice;
+            run->time += slice;
+            left = (left > slice) ? left - slice : 0;
+            _scheduleRecord(run, rank, slice);
+            _schedulePredictArrive(run, predictor, heap, &size, remaining);
+            run->ready = size;
+            preempted = (remaining[rank] > 0 && size > 0 && (long long)(heap[0] >> 32) < left);
+        }
+        if (preempted) {
+            _scheduleNotify(run, run->hooks->preempt, rank);
+            _scheduleHeapPush(heap, &size, ((uint64_t)left << 32) | rank);
+        }
+        else {
+            _schedulePredictorUpdate(predictor, rank, jobs[rank].work_time);
+            _scheduleFinish(run, rank);
+        }
+    }
+}
+
+#define SCHEDULE_STRIDE1 (1 << 20)  // Pass added per quantum by one ticket (stride = SCHEDULE_STRIDE1 / tickets).
+
+/**
+ * CPU time received versus entitled, for the proportional-share policies. A process is entitled to its
+ * tickets over the tickets of every arrived, unfinished process, so its entitlement between two moments is
+ * its tickets times the change in share, the running integral of 1 / (total tickets) over time. Windows open
+ * at the first scheduling decision at or after each multiple of the window length, so slices never cross them.
+ * A process settles its current window only when it runs or completes; the windows it skipped in between
+ * (where it got nothing) are added for all processes at once at the end, through a difference array of tickets.
+ */
+struct ScheduleFairness {
+    long long window;           // Window length.
+    double share;
+    long long share_time;       // Time the share was last brought up to.
+    uint64_t tickets;           // Tickets of every arrived, unfinished process.
+    double life_error;          // Sum of |received - entitled| over the processes that completed.
+    long long life_time;        // CPU time they received.
+    bool ok;                    // False once the window arrays could not grow.
+
+    // One per process (by arrival rank).
+    double *arrive_share;
+    double *mark_share;         // Share when the process last settled.
+    long long *received;        // CPU time received in its mark window since then.
+    uint32_t *mark_window;
+
+    // One per window.
+    double *window_share;       // Share when the window opened.
+    double *window_error;       // Sum of |received - entitled| settled so far.
+    long long *window_busy;     // CPU time given out.
+    long long *window_tickets;  // Difference array: tickets of the processes that skipped the window.
+    uint32_t num_windows;
+    uint32_t window_capacity;
+};
+
+static bool _scheduleFairInit(struct ScheduleFairness *fair, uint32_t count, int window) {
+    memset(fair, 0, sizeof(*fair));
+    fair->window = window;
+    fair->ok = true;
+    fair->arrive_share = malloc((size_t)count * sizeof(double) + 1);
+    fair->mark_share = malloc((size_t)count * sizeof(double) + 1);
+    fair->received = malloc((size_t)count * sizeof(long long) + 1);
+    fair->mark_window = malloc((size_t)count * sizeof(uint32_t) + 1);
+    return fair->arrive_share != NULL && fair->mark_share != NULL && fair->received != NULL && fair->mark_window != NULL;
+}
+
+static void _scheduleFairDestroy(struct ScheduleFairness *fair) {
+    free(fair->arrive_share);
+    free(fair->mark_share);
+    free(fair->received);
+    free(fair->mark_window);
+    free(fair->window_share);
+    free(fair->window_error);
+    free(fair->window_busy);
+    free(fair->window_tickets);
+}
+
+/**
+ * Brings the share up to a time. The total tickets must not have changed since it was last brought up.
+ */
+static void _scheduleFairAdvance(struct ScheduleFairness *fair, long long time) {
+    if (fair->tickets > 0) {
+        fair->share += (double)(time - fair->share_time) / (double)fair->tickets;
+    }
+    fair->share_time = time;
+}
+
+/**
+ * Opens every window up to the one a scheduling decision at this time falls in.
+ */
+static void _scheduleFairWindow(struct ScheduleFairness *fair, long long time) {
+    _scheduleFairAdvance(fair, time);
+    uint64_t window = (uint64_t)(time / fair->window);
+    while (fair->ok && (fair->num_windows == 0 || fair->num_windows - 1 < window)) {
+        if (fair->num_windows == fair->window_capacity) {
+            uint32_t capacity = (fair->window_capacity > 0) ? 2 * fair->window_capacity : 64;
+            double *share = realloc(fair->window_share, (size_t)capacity * sizeof(double));
+            fair->window_share = (share != NULL) ? share : fair->window_share;
+            double *error = realloc(fair->window_error, (size_t)capacity * sizeof(double));
+            fair->window_error = (error != NULL) ? error : fair->window_error;
+            long long *busy = realloc(fair->window_busy, (size_t)capacity * sizeof(long long));
+            fair->window_busy = (busy != NULL) ? busy : fair->window_busy;
+            long long *tickets = realloc(fair->window_tickets, (size_t)capacity * sizeof(long long));
+            fair->window_tickets = (tickets != NULL) ? tickets : fair->window_tickets;
+            fair->ok = (share != NULL && error != NULL && busy != NULL && tickets != NULL && capacity > fair->window_capacity);
+            if (!fair->ok) {
+                break;
+            }
+            fair->window_capacity = capacity;
+        }
+        // Windows the CPU idled through all open at the same share, so they come out empty.
+        uint32_t w = fair->num_windows++;
+        fair->window_share[w] = fair->share;
+        fair->window_error[w] = 0;
+        fair->window_busy[w] = 0;
+        fair->window_tickets[w] = 0;
+    }
+}
+
+static void _scheduleFairArrive(struct ScheduleFairness *fair, uint32_t rank, int tickets) {
+    fair->tickets += tickets;
+    fair->arrive_share[rank] = fair->share;
+    fair->mark_share[rank] = fair->share;
+    fair->received[rank] = 0;
+    fair->mark_window[rank] = fair->num_windows - 1;
+}
+
+/**
+ * Closes the window a process last settled in, if it is not the current one, and moves it to the current one.
+ */
+static void _scheduleFairSettle(struct ScheduleFairness *fair, uint32_t rank, int tickets) {
+    uint32_t current = fair->num_windows - 1;
+    uint32_t mark = fair->mark_window[rank];
+    if (!fair->ok || mark == current) {
+        return;
+    }
+    double entitled = tickets * (fair->window_share[mark + 1] - fair->mark_share[rank]);
+    double error = fair->received[rank] - entitled;
+    fair->window_error[mark] += (error < 0) ? -error : error;
+    if (mark + 1 < current) {
+        fair->window_tickets[mark + 1] += tickets;
+        fair->window_tickets[current] -= tickets;
+    }
+    fair->mark_window[rank] = current;
+    fair->mark_share[rank] = fair->window_share[current];
+    fair->received[rank] = 0;
+}
+
+/**
+ * Counts a slice a process is about to run in the current window.
+ */
+static void _scheduleFairRun(struct ScheduleFairness *fair, uint32_t rank, int tickets, long long length) {
+    _scheduleFairSettle(fair, rank, tickets);
+    fair->received[rank] += length;
+    if (fair->ok) {
+        fair->window_busy[fair->num_windows - 1] += length;
+    }
+}
+
+/**
+ * Settles a process that completed at a time, after receiving its work time.
+ */
+static void _scheduleFairComplete(struct ScheduleFairness *fair, uint32_t rank, int tickets, long long time, int work_time) {
+    _scheduleFairAdvance(fair, time);
+    _scheduleFairSettle(fair, rank, tickets);
+    if (fair->ok) {
+        double error = fair->received[rank] - tickets * (fair->share - fair->mark_share[rank]);
+        fair->window_error[fair->num_windows - 1] += (error < 0) ? -error : error;
+    }
+    double error = work_time - tickets * (fair->share - fair->arrive_share[rank]);
+    fair->life_error += (error < 0) ? -error : error;
+    fair->life_time += work_time;
+    fair->tickets -= tickets;
+}
+
+/**
+ * Adds up the skipped windows and writes the errors into the statistics.
+ */
+static void _scheduleFairFinish(struct ScheduleFairness *fair, struct ScheduleStats *totals) {
+    totals->share_error = (fair->life_time > 0) ? fair->life_error / (2.0 * fair->life_time) : 0;
+    long long skipping = 0;
+    double sum = 0;
+    for (uint32_t w = 0; fair->ok && w < fair->num_windows; w++) {
+        double end = (w + 1 < fair->num_windows) ? fair->window_share[w + 1] : fair->share;
+        skipping += fair->window_tickets[w];
+        if (fair->window_busy[w] == 0) {
+            continue;
+        }
+        double error = (fair->window_error[w] + skipping * (end - fair->window_share[w])) / (2.0 * fair->window_busy[w]);
+        sum += error;
+        totals->max_window_error = (error > totals->max_window_error) ? error : totals->max_window_error;
+        totals->num_windows++;
+    }
+    totals->window_error = (totals->num_windows > 0) ? sum / totals->num_windows : 0;
+}
+
+/**
+ * @return int Tickets of a process: its priority, at least 1.
+ */
+static int _scheduleTickets(const struct ScheduleRun *run, uint32_t rank) {
+    int priority = run->details[rank].priority;
+    return (priority > 0) ? priority : 1;
+}
+
+/**
+ * @return uint64_t Next number of a splitmix64 sequence.
+ */
+static uint64_t _scheduleRandom(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Adds to the tickets of one arrival rank in a Fenwick tree (1-based, size + 1 entries).
+ */
+static void _scheduleFenwickAdd(uint64_t *tree, uint32_t size, uint32_t rank, uint64_t delta) {
+    for (uint64_t i = (uint64_t)rank + 1; i <= size; i += i & (0 - i)) {
+        tree[i] += delta;
+    }
+}
+
+/**
+ * @return uint32_t Arrival rank holding the ticket with this number (below the total), in O(log n).
+ */
+static uint32_t _scheduleFenwickFind(const uint64_t *tree, uint32_t size, uint64_t ticket) {
+    uint32_t step = 1;
+    while (step <= size / 2) {
+        step *= 2;
+    }
+    uint32_t pos = 0;
+    for (; step > 0; step /= 2) {
+        if ((uint64_t)pos + step <= size && tree[pos + step] <= ticket) {
+            pos += step;
+            ticket -= tree[pos];
+        }
+    }
+    return pos;
+}
+
+/**
+ * Lottery scheduling: each quantum, a ticket is drawn from the tickets of every arrived process and its
+ * holder runs. The tickets live in a Fenwick tree by arrival rank, so a draw, an arrival, and a completion
+ * each take O(log n).
+ */
+static void _scheduleLottery(struct ScheduleRun *run, struct ScheduleFairness *fair, uint64_t *tree, int *remaining,
+                             const struct ScheduleParams *params) {
+    const struct ScheduleJob *jobs = run->jobs;
+    uint64_t state = params->seed;
+    uint64_t total = 0;
+    uint32_t active = 0;
+    run->quantum = params->quantum;
+    memset(tree, 0, ((size_t)run->count + 1) * sizeof(uint64_t));
+    while (run->done < run->count) {
+        _scheduleFairWindow(fair, run->time);
+        for (; run->next < run->count && jobs[run->next].start_time <= run->time; run->next++) {
+            int tickets = _scheduleTickets(run, run->next);
+            _scheduleFenwickAdd(tree, run->count, run->next, tickets);
+            _scheduleFairArrive(fair, run->next, tickets);
+            remaining[run->next] = jobs[run->next].work_time;
+            total += tickets;
+            active++;
+        }
+        if (active == 0) {
+            run->time = jobs[run->next].start_time;
+            continue;
+        }
+
+        uint32_t rank = _scheduleFenwickFind(tree, run->count, _scheduleRandom(&state) % total);
+        int tickets = _scheduleTickets(run, rank);
+        run->ready = active - 1;
+        run->totals.dispatches++;
+        _scheduleNotify(run, run->hooks->dispatch, rank);
+
+        int slice = (remaining[rank] < params->quantum) ? remaining[rank] : params->quantum;
+        remaining[rank] -= slice;
+        _scheduleFairRun(fair, rank, tickets, slice);
+        run->time += slice;
+        _scheduleRecord(run, rank, slice);
+        if (remaining[rank] > 0) {
+            _scheduleNotify(run, run->hooks->preempt, rank);
+        }
+        else {
+            _scheduleFenwickAdd(tree, run->count, rank, 0 - (uint64_t)tickets);
+            total -= tickets;
+            _scheduleFairComplete(fair, rank, tickets, run->time, jobs[rank].work_time);
+            active--;
+            run->ready = active;
+            _scheduleFinish(run, rank);
+        }
+    }
+}
+
+/**
+ * Heap entry of stride scheduling, ordered by pass, then arrival rank.
+ */
+struct ScheduleStride {
+    uint64_t pass;
+    uint32_t rank;
+};
+
+/**
+ * @return uint64_t Pass a process advances by per quantum, at least 1.
+ */
+static uint64_t _scheduleStrideOf(int tickets) {
+    return (SCHEDULE_STRIDE1 / tickets > 0) ? SCHEDULE_STRIDE1 / tickets : 1;
+}
+
+static bool _scheduleStrideBefore(const struct ScheduleStride *a, const struct ScheduleStride *b) {
+    return a->pass < b->pass || (a->pass == b->pass && a->rank < b->rank);
+}
+
+static void _scheduleStridePush(struct ScheduleStride *heap, uint32_t *size, struct ScheduleStride entry) {
+    uint32_t pos = (*size)++;
+    while (pos > 0 && _scheduleStrideBefore(&entry, &heap[(pos - 1) / 2])) {
+        heap[pos] = heap[(pos - 1) / 2];
+        pos = (pos - 1) / 2;
+    }
+    heap[pos] = entry;
+}
+
+static struct ScheduleStride _scheduleStridePop(struct ScheduleStride *heap, uint32_t *size) {
+    struct ScheduleStride top = heap[0];
+    struct ScheduleStride last = heap[--(*size)];
+    uint32_t pos = 0;
+    for (;;) {
+        uint32_t child = 2 * pos + 1;
+        if (child >= *size) {
+            break;
+        }
+        if (child + 1 < *size && _scheduleStrideBefore(&heap[child + 1], &heap[child])) {
+            child++;
+        }
+        if (!_scheduleStrideBefore(&heap[child], &last)) {
+            break;
+        }
+        heap[pos] = heap[child];
+        pos = child;
+    }
+    heap[pos] = last;
+    return top;
+}
+
+/**
+ * Stride scheduling: each quantum goes to the process with the lowest pass, which then advances by its
+ * stride (SCHEDULE_STRIDE1 / tickets). A process that arrives joins one stride past the pass of the
+ * process dispatched last, so it neither waits behind nor jumps ahead of the ones already competing.
+ */
+static void _scheduleStride(struct ScheduleRun *run, struct ScheduleFairness *fair, struct ScheduleStride *heap,
+                            int *remaining, int quantum) {
+    const struct ScheduleJob *jobs = run->jobs;
+    uint64_t global_pass = 0;
+    uint32_t size = 0;
+    run->quantum = quantum;
+    while (run->done < run->count) {
+        _scheduleFairWindow(fair, run->time);
+        for (; run->next < run->count && jobs[run->next].start_time <= run->time; run->next++) {
+            int tickets = _scheduleTickets(run, run->next);
+            struct ScheduleStride entry = { global_pass + _scheduleStrideOf(tickets), run->next };
+            _scheduleStridePush(heap, &size, entry);
+            _scheduleFairArrive(fair, run->next, tickets);
+            remaining[run->next] = jobs[run->next].work_time;
+        }
+        if (size == 0) {
+            run->time = jobs[run->next].start_time;
+            continue;
+        }
+
+        struct ScheduleStride entry = _scheduleStridePop(heap, &size);
+        uint32_t rank = entry.rank;
+        int tickets = _scheduleTickets(run, rank);
+        global_pass = entry.pass;
+        run->ready = size;
+        run->totals.dispatches++;
+        _scheduleNotify(run, run->hooks->dispatch, rank);
+
+        int slice = (remaining[rank] < quantum) ? remaining[rank] : quantum;
+        remaining[rank] -= slice;
+        _scheduleFairRun(fair, rank, tickets, slice);
+        run->time += slice;
+        _scheduleRecord(run, rank, slice);
+        if (remaining[rank] > 0) {
+            _scheduleNotify(run, run->hooks->preempt, rank);
+            entry.pass += _scheduleStrideOf(tickets);
+            _scheduleStridePush(heap, &size, entry);
+        }
+        else {
+            _scheduleFairComplete(fair, rank, tickets, run->time, jobs[rank].work_time);
+            _scheduleFinish(run, rank);
+        }
+    }
+}
+
+#define SCHEDULE_NONE UINT32_MAX    // No process, or no lock.
+
+/**
+ * One critical section of a process, after the overlaps are resolved.
+ */
+struct ScheduleHold {
+    int offset;             // Work done when the lock is acquired.
+    int end;                // Work done when it is released (> offset).
+    uint32_t lock;          // Lock number, counted from 0 in order of first use.
+    uint32_t source;        // Index of the section in the params.
+};
+
+struct ScheduleLock {
+    uint32_t owner;         // Arrival rank of the holder, SCHEDULE_NONE while free.
+    int ceiling;            // Highest priority (lowest value) of every process that uses it.
+    uint32_t base;          // Where its wait heap starts in the shared wait array.
+    uint32_t waiting;       // Processes blocked on it.
+};
+
+enum ScheduleLockState {
+    SCHED_LOCK_ARRIVING,
+    SCHED_LOCK_READY,
+    SCHED_LOCK_RUNNING,
+    SCHED_LOCK_BLOCKED,
+    SCHED_LOCK_DONE
+};
+
+/**
+ * State of a PPRI run. The ready queue is a heap keyed by effective priority, then arrival rank, in which
+ * a process whose priority changes is pushed again rather than moved: entries that no longer match their
+ * process's state and priority are dropped as they reach the top. Every lock has its own wait heap, keyed
+ * by priority and rank, in one shared array: a lock never has more waiters than sections that use it.
+ *
+ * A process waiting (ready or blocked) accrues inversion whenever a process of lower priority than its own
+ * runs. Rather than visiting every waiting process on every slice, a Fenwick tree over the distinct
+ * priorities adds each slice to the running total of every priority above the running process's, and a
+ * waiting process takes the growth of its priority's total between when it starts and stops waiting.
+ */
+struct ScheduleLocking {
+    enum ScheduleLockProtocol protocol;
+    const struct ScheduleSection *sections;
+    struct ScheduleHold *holds;     // By process in arrival order, then offset.
+    uint32_t *first;                // First hold of each process, count + 1 entries.
+    struct ScheduleLock *locks;
+    uint64_t *waits;
+    uint64_t *ready;                // Big enough for every push a run can make (see _scheduleLockingInit).
+    uint32_t ready_size;
+    uint32_t num_ready;             // Processes that are ready, whatever the heap holds.
+    uint64_t *tree;                 // Fenwick tree of inversion totals by priority class, num_classes + 1 entries.
+    uint32_t num_classes;
+    // Per process, by arrival rank.
+    uint32_t *priority_class;       // Rank of its priority among the distinct ones, 0 for the highest.
+    int *effective;
+    int *progress;                  // Work done.
+    uint32_t *next_hold;            // First hold not released yet.
+    uint32_t *holding;              // Lock held, SCHEDULE_NONE if none.
+    uint8_t *state;
+    long long *since;               // When it blocked.
+    long long *blocked;
+    long long *inversion;           // Less its class's total when it started waiting, while it waits.
+};
+
+/**
+ * Open-addressed table from ints (process IDs or lock numbers) to dense numbers.
+ */
+struct ScheduleIndex {
+    int *keys;
+    uint32_t *values;       // Number + 1, 0 for an empty bucket.
+    uint32_t mask;
+};
+
+static bool _scheduleIndexInit(struct ScheduleIndex *index, uint32_t count) {
+    uint32_t capacity = 16;
+    while (capacity < 2 * (uint64_t)count && capacity < (1u << 31)) {
+        capacity *= 2;
+    }
+    index->keys = malloc((size_t)capacity * sizeof(int));
+    index->values = calloc(capacity, sizeof(uint32_t));
+    index->mask = capacity - 1;
+    return index->keys != NULL && index->values != NULL;
+}
+
+/**
+ * @return uint32_t Bucket holding the key, or the empty bucket where it belongs.
+ */
+static uint32_t _scheduleIndexFind(const struct ScheduleIndex *index, int key) {
+    uint32_t bucket = ((uint32_t)key * 2654435761u) & index->mask;
+    while (index->values[bucket] != 0 && index->keys[bucket] != key) {
+        bucket = (bucket + 1) & index->mask;
+    }
+    return bucket;
+}
+
+static int _scheduleCompareInt(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static void _scheduleLockingDestroy(struct ScheduleLocking *locking) {
+    free(locking->holds);
+    free(locking->first);
+    free(locking->locks);
+    free(locking->waits);
+    free(locking->ready);
+    free(locking->tree);
+    free(locking->priority_class);
+    free(locking->effective);
+    free(locking->progress);
+    free(locking->next_hold);
+    free(locking->holding);
+    free(locking->state);
+    free(locking->since);
+    free(locking->blocked);
+    free(locking->inversion);
+}
+
+/**
+ * Resolves the sections into holds, sorted by process then offset, numbers the locks and works out their
+ * ceilings and wait heaps, and numbers the distinct priorities.
+ *
+ * @return bool False if out of memory (whatever was allocated is freed by _scheduleLockingDestroy).
+ */
+static bool _scheduleLockingInit(struct ScheduleLocking *locking, const struct ScheduleRun *run,
+                                 const struct ScheduleParams *params) {
+    memset(locking, 0, sizeof(*locking));
+    uint32_t count = run->count;
+    uint32_t num_sections = (params->sections != NULL) ? params->num_sections : 0;
+    const struct ScheduleSection *sections = params->sections;
+    size_t n = (size_t)count + 1;
+    size_t s = (size_t)num_sections + 1;
+    locking->protocol = params->protocol;
+    locking->sections = sections;
+    locking->holds = malloc(s * sizeof(struct ScheduleHold));
+    locking->first = calloc(n + 1, sizeof(uint32_t));
+    locking->locks = malloc(s * sizeof(struct ScheduleLock));
+    locking->waits = malloc(s * sizeof(uint64_t));
+    // Each arrival, preemption (by an arrival or after a release), inherited priority, and handed-over lock pushes once.
+    locking->ready = malloc((2 * n + 3 * s) * sizeof(uint64_t));
+    locking->tree = calloc(n + 1, sizeof(uint64_t));
+    locking->priority_class = malloc(n * sizeof(uint32_t));
+    locking->effective = malloc(n * sizeof(int));
+    locking->progress = calloc(n, sizeof(int));
+    locking->next_hold = malloc(n * sizeof(uint32_t));
+    locking->holding = malloc(n * sizeof(uint32_t));
+    locking->state = calloc(n, sizeof(uint8_t));
+    locking->since = calloc(n, sizeof(long long));
+    locking->blocked = calloc(n, sizeof(long long));
+    locking->inversion = calloc(n, sizeof(long long));
+    int *priorities = malloc(n * sizeof(int));
+    struct ScheduleIndex ids;
+    struct ScheduleIndex numbers;
+    bool ok = _scheduleIndexInit(&ids, count);
+    ok = _scheduleIndexInit(&numbers, num_sections) && ok;
+    ok = ok && locking->holds != NULL && locking->first != NULL && locking->locks != NULL && locking->waits != NULL
+         && locking->ready != NULL && locking->tree != NULL && locking->priority_class != NULL
+         && locking->effective != NULL && locking->progress != NULL && locking->next_hold != NULL
+         && locking->holding != NULL && locking->state != NULL && locking->since != NULL
+         && locking->blocked != NULL && locking->inversion != NULL && priorities != NULL;
+    if (!ok) {
+        free(ids.keys);
+        free(ids.values);
+        free(numbers.keys);
+        free(numbers.values);
+        free(priorities);
+        return false;
+    }
+
+    // Priority classes: the distinct priorities in order, 0 for the highest (lowest value).
+    for (uint32_t rank = 0; rank < count; rank++) {
+        priorities[rank] = run->details[rank].priority;
+    }
+    qsort(priorities, count, sizeof(int), _scheduleCompareInt);
+    uint32_t num_classes = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (num_classes == 0 || priorities[num_classes - 1] != priorities[i]) {
+            priorities[num_classes++] = priorities[i];
+        }
+    }
+    locking->num_classes = num_classes;
+    for (uint32_t rank = 0; rank < count; rank++) {
+        int priority = run->details[rank].priority;
+        uint32_t low = 0;
+        uint32_t high = num_classes - 1;
+        while (low < high) {
+            uint32_t middle = low + (high - low) / 2;
+            if (priorities[middle] < priority) {
+                low = middle + 1;
+            }
+            else {
+                high = middle;
+            }
+        }
+        locking->priority_class[rank] = low;
+        locking->effective[rank] = priority;
+        locking->holding[rank] = SCHEDULE_NONE;
+        uint32_t bucket = _scheduleIndexFind(&ids, run->details[rank].id);
+        ids.keys[bucket] = run->details[rank].id;
+        ids.values[bucket] = rank + 1;
+    }
+
+    // Count the sections of each process, then place them, numbering the locks as they come.
+    for (uint32_t i = 0; i < num_sections; i++) {
+        uint32_t bucket = _scheduleIndexFind(&ids, sections[i].id);
+        if (sections[i].offset >= 0 && sections[i].length > 0 && ids.values[bucket] != 0) {
+            locking->first[ids.values[bucket]]++;
+        }
+    }
+    for (uint32_t rank = 0; rank < count; rank++) {
+        locking->first[rank + 1] += locking->first[rank];
+        locking->next_hold[rank] = locking->first[rank];
+    }
+    uint32_t num_locks = 0;
+    for (uint32_t i = 0; i < num_sections; i++) {
+        uint32_t bucket = _scheduleIndexFind(&ids, sections[i].id);
+        if (sections[i].offset < 0 || sections[i].length <= 0 || ids.values[bucket] == 0) {
+            continue;
+        }
+        uint32_t number = _scheduleIndexFind(&numbers, sections[i].lock);
+        if (numbers.values[number] == 0) {
+            numbers.keys[number] = sections[i].lock;
+            numbers.values[number] = ++num_locks;
+        }
+        struct ScheduleHold hold = { sections[i].offset, sections[i].length, numbers.values[number] - 1, i };
+        locking->holds[locking->next_hold[ids.values[bucket] - 1]++] = hold;
+    }
+
+    // Sort each process's sections by offset (there are few), and move or cut the ones that do not fit.
+    uint32_t from = 0;
+    uint32_t kept = 0;
+    for (uint32_t rank = 0; rank < count; rank++) {
+        uint32_t to = locking->first[rank + 1];
+        locking->first[rank] = kept;
+        struct ScheduleHold *holds = locking->holds;
+        for (uint32_t i = from + 1; i < to; i++) {
+            struct ScheduleHold hold = holds[i];
+            uint32_t j = i;
+            for (; j > from && holds[j - 1].offset > hold.offset; j--) {
+                holds[j] = holds[j - 1];
+            }
+            holds[j] = hold;
+        }
+        int work_time = run->jobs[rank].work_time;
+        int released = 0;
+        for (uint32_t i = from; i < to; i++) {
+            int start = (holds[i].offset > released) ? holds[i].offset : released;
+            if (start >= work_time) {
+                break;
+            }
+            long long end = (long long)start + holds[i].end;
+            struct ScheduleHold hold = { start, (end < work_time) ? (int)end : work_time, holds[i].lock, holds[i].source };
+            holds[kept++] = hold;
+            released = hold.end;
+        }
+        locking->next_hold[rank] = locking->first[rank];
+        from = to;
+    }
+    locking->first[count] = kept;
+
+    // Ceilings, and each lock's share of the wait array: one slot per section that uses it.
+    for (uint32_t l = 0; l < num_locks; l++) {
+        struct ScheduleLock lock = { SCHEDULE_NONE, INT_MAX, 0, 0 };
+        locking->locks[l] = lock;
+    }
+    for (uint32_t rank = 0; rank < count; rank++) {
+        for (uint32_t i = locking->first[rank]; i < locking->first[rank + 1]; i++) {
+            struct ScheduleLock *lock = &locking->locks[locking->holds[i].lock];
+            int priority = run->details[rank].priority;
+            lock->ceiling = (priority < lock->ceiling) ? priority : lock->ceiling;
+            lock->base++;
+        }
+    }
+    uint32_t base = 0;
+    for (uint32_t l = 0; l < num_locks; l++) {
+        uint32_t uses = locking->locks[l].base;
+        locking->locks[l].base = base;
+        base += uses;
+    }
+
+    free(ids.keys);
+    free(ids.values);
+    free(numbers.keys);
+    free(numbers.values);
+    free(priorities);
+    return true;
+}
+
+static int _scheduleLockKeyPriority(uint64_t key) {
+    return (int)((uint32_t)(key >> 32) ^ 0x80000000u);
+}
+
+static uint32_t _scheduleLockKeyRank(uint64_t key) {
+    return (uint32_t)key ^ 0x80000000u;
+}
+
+/**
+ * @return long long Inversion total of a process's priority class so far, in O(log n).
+ */
+static long long _scheduleLockTotal(const struct ScheduleLocking *locking, uint32_t rank) {
+    uint64_t total = 0;
+    for (uint64_t i = (uint64_t)locking->priority_class[rank] + 1; i > 0; i -= i & (0 - i)) {
+        total += locking->tree[i];
+    }
+    return (long long)total;
+}
+
+/**
+ * A process starts (waiting is true) or stops waiting for the CPU.
+ */
+static void _scheduleLockWait(struct ScheduleLocking *locking, uint32_t rank, bool waiting) {
+    long long total = _scheduleLockTotal(locking, rank);
+    locking->inversion[rank] += waiting ? -total : total;
+}
+
+/**
+ * Queues a ready process under its effective priority.
+ */
+static void _scheduleLockQueue(struct ScheduleLocking *locking, uint32_t rank) {
+    _scheduleHeapPush(locking->ready, &locking->ready_size, _scheduleKey(locking->effective[rank], (int)rank));
+}
+
+static void _scheduleLockReady(struct ScheduleLocking *locking, uint32_t rank) {
+    locking->state[rank] = SCHED_LOCK_READY;
+    locking->num_ready++;
+    _scheduleLockQueue(locking, rank);
+}
+
+/**
+ * Drops the stale entries from the top of the ready queue.
+ *
+ * @return uint32_t Ready process with the highest effective priority (then the earliest), SCHEDULE_NONE if none.
+ */
+static uint32_t _scheduleLockTop(struct ScheduleLocking *locking) {
+    while (locking->ready_size > 0) {
+        uint64_t key = locking->ready[0];
+        uint32_t rank = _scheduleLockKeyRank(key);
+        if (locking->state[rank] == SCHED_LOCK_READY && locking->effective[rank] == _scheduleLockKeyPriority(key)) {
+            return rank;
+        }
+        _scheduleHeapPop(locking->ready, &locking->ready_size);
+    }
+    return SCHEDULE_NONE;
+}
+
+/**
+ * @return int Priority a process runs at under the protocol: its own, or higher while it holds a lock.
+ */
+static int _scheduleLockPriority(const struct ScheduleRun *run, const struct ScheduleLocking *locking, uint32_t rank) {
+    int priority = run->details[rank].priority;
+    uint32_t held = locking->holding[rank];
+    if (held == SCHEDULE_NONE) {
+        return priority;
+    }
+    const struct ScheduleLock *lock = &locking->locks[held];
+    if (locking->protocol == SCHED_LOCK_CEILING && lock->ceiling < priority) {
+        priority = lock->ceiling;
+    }
+    if (locking->protocol == SCHED_LOCK_INHERIT && lock->waiting > 0) {
+        int waiter = _scheduleLockKeyPriority(locking->waits[lock->base]);
+        priority = (waiter < priority) ? waiter : priority;
+    }
+    return priority;
+}
+
+/**
+ * Queues every process that has arrived by the current time.
+ */
+static void _scheduleLockArrive(struct ScheduleRun *run, struct ScheduleLocking *locking) {
+    for (; run->next < run->count && run->jobs[run->next].start_time <= run->time; run->next++) {
+        _scheduleLockWait(locking, run->next, true);
+        _scheduleLockReady(locking, run->next);
+    }
+}
+
+/**
+ * Takes a lock for the running process, or blocks it in the lock's wait heap (raising the holder's
+ * priority under inheritance).
+ *
+ * @return bool False if the process blocked.
+ */
+static bool _scheduleLockAcquire(struct ScheduleRun *run, struct ScheduleLocking *locking, uint32_t rank,
+                                 const struct ScheduleHold *hold) {
+    struct ScheduleLock *lock = &locking->locks[hold->lock];
+    if (lock->owner == SCHEDULE_NONE) {
+        lock->owner = rank;
+        locking->holding[rank] = hold->lock;
+        locking->effective[rank] = _scheduleLockPriority(run, locking, rank);
+        return true;
+    }
+
+    locking->state[rank] = SCHED_LOCK_BLOCKED;
+    locking->since[rank] = run->time;
+    _scheduleLockWait(locking, rank, true);
+    _scheduleHeapPush(locking->waits + lock->base, &lock->waiting, _scheduleKey(run->details[rank].priority, (int)rank));
+    run->totals.blocks++;
+
+    // The holder is never running here, nor blocked (a process only waits for a lock while holding none).
+    int priority = _scheduleLockPriority(run, locking, lock->owner);
+    if (priority != locking->effective[lock->owner]) {
+        locking->effective[lock->owner] = priority;
+        _scheduleLockQueue(locking, lock->owner);
+    }
+    return false;
+}
+
+/**
+ * Releases the running process's lock, and hands it straight to its highest-priority waiter, if any.
+ */
+static void _scheduleLockRelease(struct ScheduleRun *run, struct ScheduleLocking *locking, uint32_t rank) {
+    uint32_t held = locking->holding[rank];
+    struct ScheduleLock *lock = &locking->locks[held];
+    locking->holding[rank] = SCHEDULE_NONE;
+    locking->effective[rank] = run->details[rank].priority;
+    lock->owner = SCHEDULE_NONE;
+    if (lock->waiting > 0) {
+        uint32_t waiter = _scheduleLockKeyRank(_scheduleHeapPop(locking->waits + lock->base, &lock->waiting));
+        lock->owner = waiter;
+        locking->holding[waiter] = held;
+        locking->blocked[waiter] += run->time - locking->since[waiter];
+        locking->effective[waiter] = _scheduleLockPriority(run, locking, waiter);
+        _scheduleLockReady(locking, waiter);
+    }
+}
+
+/**
+ * Handles whatever the running process has reached with the work it has done: the end of the section
+ * it holds, the start of its next one, or the end of its burst.
+ *
+ * @return bool True if it can keep running, false if it blocked or finished.
+ */
+static bool _scheduleLockPoint(struct ScheduleRun *run, struct ScheduleLocking *locking, uint32_t rank) {
+    int progress = locking->progress[rank];
+    uint32_t next = locking->next_hold[rank];
+    if (locking->holding[rank] != SCHEDULE_NONE && progress == locking->holds[next].end) {
+        _scheduleLockRelease(run, locking, rank);
+        locking->next_hold[rank] = ++next;
+    }
+    if (locking->holding[rank] == SCHEDULE_NONE && next < locking->first[rank + 1]
+        && progress == locking->holds[next].offset && !_scheduleLockAcquire(run, locking, rank, &locking->holds[next])) {
+        run->ready = locking->num_ready;
+        _scheduleNotify(run, run->hooks->preempt, rank);
+        return false;
+    }
+    if (progress < run->jobs[rank].work_time) {
+        return true;
+    }
+
+    locking->state[rank] = SCHED_LOCK_DONE;
+    run->totals.total_blocked += locking->blocked[rank];
+    run->totals.total_inversion += locking->inversion[rank];
+    if (locking->inversion[rank] > run->totals.max_inversion) {
+        run->totals.max_inversion = locking->inversion[rank];
+    }
+    run->ready = locking->num_ready;
+    _scheduleFinish(run, rank);
+    return false;
+}
+
+/**
+ * Fills in the lock fields of a hook's event.
+ */
+static void _scheduleLockEvent(const struct ScheduleRun *run, uint32_t rank, struct ScheduleEvent *event) {
+    const struct ScheduleLocking *locking = run->locking;
+    event->blocked = locking->blocked[rank];
+    event->inversion = locking->inversion[rank];
+    if (locking->state[rank] == SCHED_LOCK_READY || locking->state[rank] == SCHED_LOCK_BLOCKED) {
+        event->inversion += _scheduleLockTotal(locking, rank);
+    }
+    if (locking->state[rank] == SCHED_LOCK_BLOCKED) {
+        event->blocked += run->time - locking->since[rank];
+        event->section = &locking->sections[locking->holds[locking->next_hold[rank]].source];
+    }
+}
+
+/**
+ * Preemptive priority scheduling with locks. The running process is stopped at every arrival and at every
+ * lock it reaches, takes or releases, and put back if a ready process now has a higher effective priority
+ * (a lower value; ties keep it running). Every slice it runs adds to the inversion of the waiting processes
+ * of higher priority than its own.
+ */
+static void _scheduleLocked(struct ScheduleRun *run, struct ScheduleLocking *locking) {
+    const struct ScheduleJob *jobs = run->jobs;
+    uint32_t running = SCHEDULE_NONE;
+    while (run->done < run->count) {
+        _scheduleLockArrive(run, locking);
+        if (running == SCHEDULE_NONE) {
+            // Nothing ready means nothing blocked either: every lock holder is ready or running.
+            running = _scheduleLockTop(locking);
+            if (running == SCHEDULE_NONE) {
+                run->time = jobs[run->next].start_time;
+                continue;
+            }
+            _scheduleHeapPop(locking->ready, &locking->ready_size);
+            locking->state[running] = SCHED_LOCK_RUNNING;
+            locking->num_ready--;
+            _scheduleLockWait(locking, running, false);
+            run->ready = locking->num_ready;
+            _scheduleNotify(run, run->hooks->dispatch, running);
+        }
+        if (!_scheduleLockPoint(run, locking, running)) {
+            running = SCHEDULE_NONE;
+            continue;
+        }
+
+        uint32_t top = _scheduleLockTop(locking);
+        if (top != SCHEDULE_NONE && locking->effective[top] < locking->effective[running]) {
+            _scheduleLockWait(locking, running, true);
+            _scheduleLockReady(locking, running);
+            run->ready = locking->num_ready;
+            _scheduleNotify(run, run->hooks->preempt, running);
+            running = SCHEDULE_NONE;
+            continue;
+        }
+
+        uint32_t next = locking->next_hold[running];
+        int stop = jobs[running].work_time;
+        if (locking->holding[running] != SCHEDULE_NONE) {
+            stop = locking->holds[next].end;
+        }
+        else if (next < locking->first[running + 1]) {
+            stop = locking->holds[next].offset;
+        }
+        long long slice = stop - locking->progress[running];
+        if (run->next < run->count && jobs[run->next].start_time - run->time < slice) {
+            slice = jobs[run->next].start_time - run->time;
+        }
+        locking->progress[running] += (int)slice;
+        run->time += slice;
+        _scheduleRecord(run, running, slice);
+        uint32_t priority_class = locking->priority_class[running];
+        if (priority_class > 0) {
+            _scheduleFenwickAdd(locking->tree, locking->num_classes, 0, (uint64_t)slice);
+            _scheduleFenwickAdd(locking->tree, locking->num_classes, priority_class, 0 - (uint64_t)slice);
+        }
+    }
+}
+
+/**
+ * @return bool True if the settings an algorithm uses are valid.
+ */
+static bool _scheduleValid(enum SchedulePolicy policy, const struct ScheduleParams *params) {
+    if (policy == SCHED_RR) {
+        return params->quantum > 0;
+    }
+    if (policy == SCHED_ADAPTIVE_RR) {
+        return params->quantum > 0 && params->percentile >= 1 && params->percentile <= 100;
+    }
+    if (policy == SCHED_PSJF || policy == SCHED_PSRTF) {
+        return params->alpha >= 0 && params->alpha <= 1 && params->estimate > 0;
+    }
+    if (policy == SCHED_LOTTERY || policy == SCHED_STRIDE) {
+        return params->quantum > 0 && params->window > 0;
+    }
+    if (policy == SCHED_PPRI) {
+        return params->protocol == SCHED_LOCK_NONE || params->protocol == SCHED_LOCK_INHERIT
+               || params->protocol == SCHED_LOCK_CEILING;
+    }
+    return true;
+}
+
+/**
+ * Runs one algorithm with its own working memory, then works out the averages.
+ *
+ * @return bool False if the working memory could not be allocated.
+ */
+static bool _scheduleExecute(struct ScheduleRun *run, enum SchedulePolicy policy, const struct ScheduleParams *params) {
+    bool ok = true;
+    if (policy == SCHED_FCFS) {
+        _scheduleFCFS(run);
+    }
+    else if (policy == SCHED_RR || policy == SCHED_ADAPTIVE_RR) {
+        uint32_t *ring = malloc((size_t)run->count * sizeof(uint32_t) + 1);
+        int *remaining = malloc((size_t)run->count * sizeof(int) + 1);
+        struct ScheduleAdapt adapt;
+        _scheduleAdaptInit(&adapt, params);
+        ok = (ring != NULL && remaining != NULL);
+        if (ok) {
+            _scheduleRR(run, ring, remaining, params->quantum, (policy == SCHED_ADAPTIVE_RR) ? &adapt : NULL);
+        }
+        if (ok && adapt.dispatches > 0) {
+            run->totals.average_quantum = (double)adapt.quantum_sum / adapt.dispatches;
+        }
+        free(ring);
+        free(remaining);
+    }
+    else if (policy == SCHED_PSJF || policy == SCHED_PSRTF) {
+        uint64_t *heap = malloc((size_t)run->count * sizeof(uint64_t) + 1);
+        int *remaining = malloc((size_t)run->count * sizeof(int) + 1);
+        struct SchedulePredictor predictor;
+        ok = (heap != NULL && remaining != NULL && _schedulePredictorInit(&predictor, run, params));
+        if (ok) {
+            _schedulePredictive(run, &predictor, heap, remaining, policy == SCHED_PSRTF);
+            run->totals.total_error = predictor.total_error;
+            free(predictor.slot);
+            free(predictor.estimates);
+        }
+        free(heap);
+        free(remaining);
+    }
+    else if (policy == SCHED_LOTTERY || policy == SCHED_STRIDE) {
+        size_t entry_size = (policy == SCHED_LOTTERY) ? sizeof(uint64_t) : sizeof(struct ScheduleStride);
+        void *queue = malloc(((size_t)run->count + 1) * entry_size);
+        int *remaining = malloc((size_t)run->count * sizeof(int) + 1);
+        struct ScheduleFairness fair;
+        ok = (_scheduleFairInit(&fair, run->count, params->window) && queue != NULL && remaining != NULL);
+        if (ok && policy == SCHED_LOTTERY) {
+            _scheduleLottery(run, &fair, queue, remaining, params);
+        }
+        else if (ok) {
+            _scheduleStride(run, &fair, queue, remaining, params->quantum);
+        }
+        ok = ok && fair.ok;
+        if (ok) {
+            _scheduleFairFinish(&fair, &run->totals);
+        }
+        _scheduleFairDestroy(&fair);
+        free(queue);
+        free(remaining);
+    }
+    else if (policy == SCHED_PPRI) {
+        struct ScheduleLocking locking;
+        ok = _scheduleLockingInit(&locking, run, params);
+        if (ok) {
+            run->locking = &locking;
+            _scheduleLocked(run, &locking);
+            run->locking = NULL;
+        }
+        _scheduleLockingDestroy(&locking);
+    }
+    else {
+        uint64_t *heap = malloc((size_t)run->count * sizeof(uint64_t) + 1);
+        ok = (heap != NULL);
+        if (ok) {
+            _scheduleHeap(run, heap, policy == SCHED_PRI);
+        }
+        free(heap);
+    }
+
+    run->totals.count = run->count;
+    if (run->count > 0) {
+        run->totals.average_turnaround = (double)run->totals.total_turnaround / run->count;
+        run->totals.average_wait = (double)run->totals.total_wait / run->count;
+        run->totals.average_error = (double)run->totals.total_error / run->count;
+    }
+    return ok;
+}
+
+static void *_scheduleThread(void *arg) {
+    struct ScheduleTask *task = arg;
+    task->ok = _scheduleExecute(&task->run, task->policy, &task->params);
+    return NULL;
+}
+
+static const struct ScheduleHooks schedule_no_hooks = { NULL, NULL, NULL, NULL };
+static const struct ScheduleParams schedule_defaults = {
+    SCHEDULE_DEFAULT_QUANTUM, SCHEDULE_DEFAULT_ALPHA, SCHEDULE_DEFAULT_ESTIMATE, SCHEDULE_DEFAULT_WINDOW, SCHEDULE_DEFAULT_SEED,
+    SCHEDULE_DEFAULT_PERCENTILE, SCHED_LOCK_NONE, NULL, 0
+};
+
+bool schedule_run(struct ProcessTable *table, enum SchedulePolicy policy, const struct ScheduleParams *params,
+                  const struct ScheduleHooks *hooks, struct Timeline *timeline, struct ScheduleStats *stats) {
+    params = (params != NULL) ? params : &schedule_defaults;
+    if (!_scheduleValid(policy, params)) {
+        return false;
+    }
+
+    struct ScheduleRun run;
+    memset(&run, 0, sizeof(run));
+    struct ScheduleDetail *details = NULL;
+    ProcessHandle *handles = NULL;
+    run.jobs = _scheduleJobs(table, &run.count, &details, &handles);
+    run.details = details;
+    if (run.jobs == NULL && run.count > 0) {
+        return false;
+    }
+    run.table = table;
+    run.handles = handles;
+    run.hooks = (hooks != NULL) ? hooks : &schedule_no_hooks;
+    run.timeline = timeline;
+    run.recorded = true;
+    if (timeline != NULL) {
+        timeline_clear(timeline);
+    }
+
+    bool ok = _scheduleExecute(&run, policy, params) && run.recorded;
+    free(handles);
+    if (ok && stats != NULL) {
+        *stats = run.totals;
+    }
+    return ok;
+}
+
+bool schedule_compare(const struct ProcessTable *table, const enum SchedulePolicy *policies,
+                      const struct ScheduleParams *params, int count, struct ScheduleStats *stats) {
+    if (count < 1 || count > SCHEDULE_MAX_COMPARE) {
+        return false;
+    }
+    for (int i = 0; i < count; i++) {
+        if (!_scheduleValid(policies[i], &params[i])) {
+            return false;
+        }
+    }
+
+    // Loaded and sorted once, then only read by every algorithm.
+    uint32_t num_jobs = 0;
+    struct ScheduleDetail *details = NULL;
+    ProcessHandle *handles = NULL;
+    const struct ScheduleJob *jobs = _scheduleJobs(table, &num_jobs, &details, &handles);
+    if (jobs == NULL && num_jobs > 0) {
+        return false;
+    }
+
+    struct ScheduleTask tasks[SCHEDULE_MAX_COMPARE];
+    bool started[SCHEDULE_MAX_COMPARE];
+    memset(tasks, 0, sizeof(tasks));
+    for (int i = 0; i < count; i++) {
+        tasks[i].run.jobs = jobs;
+        tasks[i].run.details = details;
+        tasks[i].run.count = num_jobs;
+        tasks[i].run.hooks = &schedule_no_hooks;
+        tasks[i].policy = policies[i];
+        tasks[i].params = params[i];
+        started[i] = (pthread_create(&tasks[i].thread, NULL, _scheduleThread, &tasks[i]) == 0);
+    }
+
+    // An algorithm whose thread could not be started runs here instead.
+    bool ok = true;
+    for (int i = 0; i < count; i++) {
+        if (started[i]) {
+            pthread_join(tasks[i].thread, NULL);
+        }
+        else {
+            _scheduleThread(&tasks[i]);
+        }
+        ok = ok && tasks[i].ok;
+        stats[i] = tasks[i].run.totals;
+    }
+    free(handles);
+    return ok;
+}
+
+/**
+ * @return double Standard normal quantile of p (0 < p < 1), by Acklam's rational approximation
+ * (relative error below 1.2e-9).
+ */
+static double _scheduleNormalQuantile(double p) {
+    static const double a[] = { -3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                                1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00 };
+    static const double b[] = { -5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                                6.680131188771972e+01, -1.328068155288572e+01 };
+    static const double c[] = { -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                                -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00 };
+    static const double d[] = { 7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                                3.754408661907416e+00 };
+    if (p < 0.02425 || p > 1 - 0.02425) {
+        double q = sqrt(-2 * log((p < 0.5) ? p : 1 - p));
+        double x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+                   ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+        return (p < 0.5) ? x : -x;
+    }
+    double q = p - 0.5;
+    double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+}
+
+/**
+ * @return double Half-width of a two-sided Student t interval in standard errors: exact for 1 and 2 degrees
+ * of freedom, from the normal quantile by the Cornish-Fisher expansion above that (within 1% from 3 degrees
+ * of freedom at up to 99% confidence).
+ */
+static double _scheduleStudent(double confidence, uint32_t freedom) {
+    double p = (1 + confidence) / 2;
+    if (freedom == 1) {
+        return tan(M_PI * (p - 0.5));
+    }
+    if (freedom == 2) {
+        return (2 * p - 1) / sqrt(2 * p * (1 - p));
+    }
+    double z = _scheduleNormalQuantile(p);
+    double z2 = z * z;
+    double v = freedom;
+    double g1 = (z2 + 1) * z / 4;
+    double g2 = ((5 * z2 + 16) * z2 + 3) * z / 96;
+    double g3 = (((3 * z2 + 19) * z2 + 17) * z2 - 15) * z / 384;
+    double g4 = ((((79 * z2 + 776) * z2 + 1482) * z2 - 1920) * z2 - 945) * z / 92160;
+    return z + (g1 + (g2 + (g3 + g4 / v) / v) / v) / v;
+}
+
+/**
+ * @return double Exponentially distributed with mean 1.
+ */
+static double _scheduleExponential(uint64_t *state) {
+    return -log(((_scheduleRandom(state) >> 11) + 0.5) * 0x1p-53);
+}
+
+/**
+ * Generates the workload of one replication, already in arrival order: IDs count up from 1 with the
+ * arrivals, so the order needs no sort.
+ */
+static void _scheduleGenerate(const struct ScheduleWorkload *workload, uint64_t seed, uint32_t number,
+                              struct ScheduleJob *jobs, struct ScheduleDetail *details) {
+    uint64_t key = seed + number;
+    uint64_t state = _scheduleRandom(&key);
+    double gap = workload->mean_burst / workload->load;
+    double time = 0;
+    for (uint32_t rank = 0; rank < workload->count; rank++) {
+        time += gap * _scheduleExponential(&state);
+        time = (time < INT_MAX) ? time : INT_MAX;
+        jobs[rank].start_time = (int)time;
+        jobs[rank].work_time = (int)(workload->mean_burst * _scheduleExponential(&state) + 0.5);
+        jobs[rank].work_time = (jobs[rank].work_time > 0) ? jobs[rank].work_time : 1;
+        details[rank].priority = (int)(_scheduleRandom(&state) % (uint64_t)workload->priorities);
+        details[rank].id = (int)rank + 1;
+        details[rank].task = 0;
+    }
+}
+
+/**
+ * Running totals of one sample, by Welford's method.
+ */
+struct ScheduleMoments {
+    double mean;
+    double squares;         // Sum of squared differences from the mean.
+};
+
+static void _scheduleMomentsAdd(struct ScheduleMoments *moments, double sample, uint32_t count) {
+    double delta = sample - moments->mean;
+    moments->mean += delta / count;
+    moments->squares += delta * (sample - moments->mean);
+}
+
+/**
+ * @return double Half-width of the confidence interval of the mean.
+ */
+static double _scheduleMomentsHalfWidth(const struct ScheduleMoments *moments, uint32_t count, double critical) {
+    return critical * sqrt(moments->squares / (count - 1) / count);
+}
+
+/**
+ * Shared state of the replication threads. Replications are handed out by number, and their samples are
+ * counted in that same order, holding back any that finish before the ones ahead of them.
+ */
+struct ScheduleReplicator {
+    enum SchedulePolicy policy;
+    const struct ScheduleParams *params;
+    const struct ScheduleWorkload *workload;
+    const struct ScheduleReplication *replication;
+    pthread_mutex_t lock;
+    uint32_t next;          // Next replication to hand out.
+    uint32_t counted;       // Replications counted so far, the first ones.
+    uint32_t limit;         // Replications are only handed out and counted below this, lowered when the rule is met.
+    double *samples;        // Average wait and turnaround of each replication, by number.
+    bool *finished;
+    struct ScheduleMoments wait;
+    struct ScheduleMoments turnaround;
+    bool converged;
+    bool ok;
+};
+
+/**
+ * Counts every finished replication that is next in order, and checks the stopping rule after each.
+ */
+static void _scheduleReplicaCount(struct ScheduleReplicator *replicator) {
+    const struct ScheduleReplication *replication = replicator->replication;
+    while (replicator->counted < replicator->limit && replicator->finished[replicator->counted]) {
+        uint32_t number = replicator->counted++;
+        _scheduleMomentsAdd(&replicator->wait, replicator->samples[2 * number], replicator->counted);
+        _scheduleMomentsAdd(&replicator->turnaround, replicator->samples[2 * number + 1], replicator->counted);
+        if (replicator->counted >= replication->min_replications) {
+            double critical = _scheduleStudent(replication->confidence, replicator->counted - 1);
+            double wait = _scheduleMomentsHalfWidth(&replicator->wait, replicator->counted, critical);
+            double turnaround = _scheduleMomentsHalfWidth(&replicator->turnaround, replicator->counted, critical);
+            if (wait <= replication->precision * fabs(replicator->wait.mean) &&
+                turnaround <= replication->precision * fabs(replicator->turnaround.mean)) {
+                replicator->converged = true;
+                replicator->limit = replicator->counted;
+            }
+        }
+    }
+}
+
+/**
+ * Replication thread: generates and runs replications until the limit is reached, with its own jobs.
+ */
+static void *_scheduleReplicaThread(void *arg) {
+    struct ScheduleReplicator *replicator = arg;
+    uint32_t count = replicator->workload->count;
+    struct ScheduleJob *jobs = malloc((size_t)count * sizeof(struct ScheduleJob));
+    struct ScheduleDetail *details = malloc((size_t)count * sizeof(struct ScheduleDetail));
+
+    pthread_mutex_lock(&replicator->lock);
+    replicator->ok = replicator->ok && jobs != NULL && details != NULL;
+    while (replicator->ok && replicator->next < replicator->limit) {
+        uint32_t number = replicator->next++;
+        pthread_mutex_unlock(&replicator->lock);
+
+        _scheduleGenerate(replicator->workload, replicator->replication->seed, number, jobs, details);
+        struct ScheduleRun run;
+        memset(&run, 0, sizeof(run));
+        run.jobs = jobs;
+        run.details = details;
+        run.count = count;
+        run.hooks = &schedule_no_hooks;
+        bool ok = _scheduleExecute(&run, replicator->policy, replicator->params);
+
+        pthread_mutex_lock(&replicator->lock);
+        replicator->ok = replicator->ok && ok;
+        replicator->samples[2 * number] = run.totals.average_wait;
+        replicator->samples[2 * number + 1] = run.totals.average_turnaround;
+        replicator->finished[number] = true;
+        _scheduleReplicaCount(replicator);
+    }
+    pthread_mutex_unlock(&replicator->lock);
+    free(jobs);
+    free(details);
+    return NULL;
+}
+
+bool schedule_replicate(enum SchedulePolicy policy, const struct ScheduleParams *params,
+                        const struct ScheduleWorkload *workload, const struct ScheduleReplication *replication,
+                        struct ScheduleEstimate *estimate) {
+    params = (params != NULL) ? params : &schedule_defaults;
+    // Every arrival and burst must fit in an int: the arrivals add up to about count gaps, and a burst
+    // is at most 37.5 times the mean (the longest exponential a 53-bit draw gives). Generated processes
+    // have no tasks, so the predictive algorithms would never get past the first estimate.
+    bool valid = _scheduleValid(policy, params) && policy != SCHED_PSJF && policy != SCHED_PSRTF &&
+                 workload->count > 0 && workload->count <= INT_MAX && workload->priorities > 0 &&
+                 workload->load > 0 && workload->mean_burst >= 1 && workload->mean_burst * 40 < INT_MAX &&
+                 (workload->count + 40.0) * (workload->mean_burst / workload->load) < INT_MAX / 2 &&
+                 replication->confidence >= 0.5 && replication->confidence <= 0.9999 && replication->precision > 0 &&
+                 replication->min_replications >= 2 && replication->max_replications >= replication->min_replications &&
+                 replication->threads >= 1 && replication->threads <= SCHEDULE_MAX_THREADS;
+    if (!valid) {
+        return false;
+    }
+
+    struct timespec start, finish;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    struct ScheduleReplicator replicator;
+    memset(&replicator, 0, sizeof(replicator));
+    replicator.policy = policy;
+    replicator.params = params;
+    replicator.workload = workload;
+    replicator.replication = replication;
+    replicator.limit = replication->max_replications;
+    replicator.samples = malloc(2 * (size_t)replication->max_replications * sizeof(double));
+    replicator.finished = calloc(replication->max_replications, sizeof(bool));
+    replicator.ok = (replicator.samples != NULL && replicator.finished != NULL);
+    pthread_mutex_init(&replicator.lock, NULL);
+
+    // This thread is one of them. One that could not be started leaves its share to the others.
+    pthread_t threads[SCHEDULE_MAX_THREADS];
+    bool started[SCHEDULE_MAX_THREADS] = { false };
+    bool allocated = replicator.ok;     // Read before any thread can write it.
+    for (int i = 1; i < replication->threads; i++) {
+        started[i] = allocated && pthread_create(&threads[i], NULL, _scheduleReplicaThread, &replicator) == 0;
+    }
+    _scheduleReplicaThread(&replicator);
+    for (int i = 1; i < replication->threads; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+    pthread_mutex_destroy(&replicator.lock);
+    free(replicator.samples);
+    free(replicator.finished);
+    if (!replicator.ok) {
+        return false;
+    }
+
+    uint32_t count = replicator.counted;
+    double critical = _scheduleStudent(replication->confidence, count - 1);
+    clock_gettime(CLOCK_MONOTONIC, &finish);
+    estimate->replications = count;
+    estimate->converged = replicator.converged;
+    estimate->mean_wait = replicator.wait.mean;
+    estimate->wait_half_width = _scheduleMomentsHalfWidth(&replicator.wait, count, critical);
+    estimate->mean_turnaround = replicator.turnaround.mean;
+    estimate->turnaround_half_width = _scheduleMomentsHalfWidth(&replicator.turnaround, count, critical);
+    estimate->seconds = (finish.tv_sec - start.tv_sec) + (finish.tv_nsec - start.tv_nsec) / 1e9;
+    return true;
+}
+
+ProcessHandle *schedule_arrival_order(const struct ProcessTable *table, uint32_t *count) {
+    struct ScheduleEntry *order = _scheduleOrder(table, count, 0);
+    if (order == NULL) {
+        return NULL;
+    }
+    // Compact the handles to the front of the same allocation.
+    ProcessHandle *handles = (ProcessHandle *)order;
+    for (uint32_t i = 0; i < *count; i++) {
+        handles[i] = order[i].handle;
+    }
+    return handles;
+}
@@ -0,0 +1,257 @@
+/**
+ * Scheduling algorithm header file.
+ * Runs FCFS, SJF, RR, and PRI over the processes in a process table, in place: start time is the
+ * arrival time, work time is the burst time, and each process's finish, turnaround, and waiting
+ * time are written back into the table. Shared by the process manager and the process scheduler.
+ *
+ * SJF knows every burst time in advance, which no real scheduler does. PSJF and PSRTF only see the
+ * bursts that have completed: the processes with the same task are the CPU bursts of one task (see
+ * struct Process), and each task's next burst is estimated by exponential averaging of its last ones.
+ *
+ * LOTTERY and STRIDE share the CPU in proportion to tickets instead, one quantum at a time, taking each
+ * process's priority as its tickets (at least 1, higher is more). Every arrived, unfinished process is
+ * entitled to its tickets over the tickets of all of them of every moment of CPU time, and the run
+ * reports how far the CPU time each process actually got is from that, over its whole life and within
+ * windows of time.
+ *
+ * ADAPTIVE_RR is round robin without a fixed quantum: it keeps a streaming percentile of the bursts that
+ * completed lately, and the quantum follows it, so that about that share of the bursts finish within one
+ * quantum however the workload shifts.
+ *
+ * PPRI is preemptive priority scheduling with locks: processes may hold named locks for parts of their bursts
+ * (critical sections), and a process that reaches a lock another one holds blocks until it is released.
+ * A high-priority process blocked on a lock held by a low-priority one then also waits for every
+ * medium-priority process that preempts the holder: priority inversion, unbounded unless the holder's
+ * priority is raised, either to that of the processes it blocks (priority inheritance) or to the highest
+ * priority of any process that uses the lock as soon as it takes it (priority ceiling). The run reports
+ * how long each process was blocked on locks and how long it waited while a lower-priority process ran.
+ *
+ * One run over one workload says nothing about the spread. schedule_replicate runs an algorithm over many
+ * randomly generated workloads instead, and stops once the confidence intervals of the average wait and
+ * turnaround are as narrow as asked.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#ifndef SCHEDULE_H
+#define SCHEDULE_H
+
+#include "process_table.h"
+#include "timeline.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SCHEDULE_MAX_COMPARE 16     // Algorithms that can be compared in one call.
+#define SCHEDULE_MAX_THREADS 64     // Threads replications can run on.
+#define SCHEDULE_DEFAULT_QUANTUM 2
+#define SCHEDULE_DEFAULT_ALPHA 0.5
+#define SCHEDULE_DEFAULT_ESTIMATE 10
+#define SCHEDULE_DEFAULT_WINDOW 20
+#define SCHEDULE_DEFAULT_SEED 1
+#define SCHEDULE_DEFAULT_PERCENTILE 80
+
+enum SchedulePolicy {
+    SCHED_FCFS,     // Earliest arrival first, runs to completion.
+    SCHED_SJF,      // Shortest burst first among arrived processes, runs to completion.
+    SCHED_RR,       // Round robin with a quantum, new arrivals queue ahead of the preempted process.
+    SCHED_PRI,      // Lowest priority value first among arrived processes, runs to completion.
+    SCHED_PSJF,     // Shortest estimated burst first among arrived processes, runs to completion.
+    SCHED_PSRTF,    // Shortest estimated time left first, an arrival estimated to finish sooner preempts.
+    SCHED_LOTTERY,  // Each quantum goes to a process drawn at random, weighted by tickets.
+    SCHED_STRIDE,   // Each quantum goes to the process with the lowest pass, which grows by 1 / tickets per quantum.
+    SCHED_ADAPTIVE_RR,  // Round robin whose quantum is a percentile of the recently completed bursts.
+    SCHED_PPRI      // Lowest effective priority value first, a higher-priority arrival preempts, processes take locks.
+};
+
+/**
+ * How PPRI raises the priority of a process holding a lock.
+ */
+enum ScheduleLockProtocol {
+    SCHED_LOCK_NONE,        // Never: the holder keeps its own priority.
+    SCHED_LOCK_INHERIT,     // To the highest priority of the processes blocked on its lock, while they are.
+    SCHED_LOCK_CEILING      // To the lock's ceiling, the highest priority of every process that uses it, while held.
+};
+
+/**
+ * Part of a process's burst during which it holds a lock. A process holds one lock at a time: sections of
+ * the same process that overlap are moved back to start where the one before ends, sections are cut off
+ * at the end of the burst (and dropped if they start past it), and sections of processes that are not in
+ * the table or with a negative offset or no length are ignored.
+ */
+struct ScheduleSection {
+    int id;                 // Process ID.
+    int lock;               // Lock, any number (front ends number their lock names).
+    int offset;             // Work done when the lock is acquired (>= 0).
+    int length;             // Work done while holding it (> 0).
+};
+
+/**
+ * Settings of the algorithms that take any. Each algorithm ignores the ones it does not use.
+ */
+struct ScheduleParams {
+    int quantum;            // RR, LOTTERY, and STRIDE: time slice (> 0). ADAPTIVE_RR: slice until a burst completes.
+    double alpha;           // PSJF and PSRTF: weight of a task's last burst in its next estimate (0 to 1).
+    int estimate;           // PSJF and PSRTF: estimate of a task's first burst (> 0).
+    int window;             // LOTTERY and STRIDE: length of the windows fairness is measured over (> 0).
+    uint64_t seed;          // LOTTERY: random seed, the same seed draws the same run.
+    int percentile;         // ADAPTIVE_RR: share of the recent bursts, in percent, that fit in one quantum (1 to 100).
+    enum ScheduleLockProtocol protocol;     // PPRI: how lock holders' priorities are raised.
+    const struct ScheduleSection *sections; // PPRI: critical sections, in any order, NULL if there are none.
+    uint32_t num_sections;
+};
+
+/**
+ * What a hook is told about one step of a run.
+ */
+struct ScheduleEvent {
+    long long time;                 // When the process was dispatched, preempted, or completed.
+    const struct Process *process;
+    uint32_t arriving;              // Processes that have not arrived yet.
+    uint32_t ready;                 // Arrived processes waiting for the CPU.
+    uint32_t done;                  // Completed processes.
+    int quantum;                    // Time-sliced algorithms: quantum the process is dispatched with, 0 otherwise.
+    const struct ScheduleSection *section;  // PPRI: section whose lock the process just blocked on, NULL otherwise.
+    long long blocked;              // PPRI: time the process has spent blocked on locks so far.
+    long long inversion;            // PPRI: time it has waited so far while a lower-priority process ran.
+};
+
+/**
+ * Optional callbacks for following a run step by step (e.g. to print it). Any of them may be NULL.
+ */
+struct ScheduleHooks {
+    void (*dispatch)(const struct ScheduleEvent *event, void *context);
+    void (*preempt)(const struct ScheduleEvent *event, void *context);     // Quantum used up, preempted, or blocked on a lock.
+    void (*complete)(const struct ScheduleEvent *event, void *context);    // Results already written.
+    void *context;
+};
+
+struct ScheduleStats {
+    uint32_t count;                 // Processes scheduled.
+    long long total_turnaround;
+    long long total_wait;
+    long long finish_time;          // When the last process finished.
+    double average_turnaround;
+    double average_wait;
+    long long total_error;          // PSJF and PSRTF: sum of |estimate - burst time| over every process.
+    double average_error;
+    double share_error;             // LOTTERY and STRIDE: sum of |CPU time received - entitled| over every
+                                    // process's life, over twice the CPU time (0: exact shares, 1: worst).
+    double window_error;            // Same, within each window of time, averaged over the busy windows.
+    double max_window_error;        // Worst window.
+    uint32_t num_windows;           // Busy windows.
+    long long dispatches;           // Time-sliced algorithms: slices handed out, a context switch each at most.
+    uint32_t quantum_changes;       // ADAPTIVE_RR: times the quantum changed.
+    int min_quantum;                // Smallest and largest quantum a process was dispatched with, and the last one.
+    int max_quantum;
+    int last_quantum;
+    double average_quantum;         // Mean quantum over every dispatch.
+    long long total_blocked;        // PPRI: time spent blocked on locks, over every process.
+    long long total_inversion;      // PPRI: time spent waiting while a lower-priority process ran, over every process.
+    long long max_inversion;        // PPRI: most of it for one process.
+    uint32_t blocks;                // PPRI: times a process blocked on a lock.
+};
+
+/**
+ * Runs a scheduling algorithm over every process in the table (in any state) on one simulated CPU,
+ * and writes finish_time, turnaround_time, and waiting_time into each process. States are left alone.
+ * Ties go to the earliest arrival, then the lowest ID. The CPU idles until the next arrival when
+ * nothing is ready. Runs in O(n log n), plus one step per quantum for RR, ADAPTIVE_RR, LOTTERY, and
+ * STRIDE (O(log n) each for the last two), per arrival for PSRTF, and O(log n) per arrival, lock
+ * acquisition, and release for PPRI.
+ *
+ * @param table Process table.
+ * @param policy Scheduling algorithm.
+ * @param params Algorithm settings, NULL for the defaults.
+ * @param hooks Step callbacks, or NULL.
+ * @param timeline Cleared, then receives every slice of CPU time in order (see timeline.h), may be NULL.
+ * @param stats Receives the totals and averages, may be NULL.
+ * @return bool False if the working memory (or the timeline) could not be allocated or a setting is invalid.
+ */
+bool schedule_run(struct ProcessTable *table, enum SchedulePolicy policy, const struct ScheduleParams *params,
+                  const struct ScheduleHooks *hooks, struct Timeline *timeline, struct ScheduleStats *stats);
+
+/**
+ * Runs several algorithms over the same processes without changing the table, e.g. to print them side by side.
+ * The processes are read from the table and sorted into arrival order once, and every algorithm then runs
+ * over that shared, read-only copy on its own thread with its own working memory, so comparing k algorithms
+ * costs one load and one sort instead of k.
+ *
+ * @param table Process table, only read.
+ * @param policies Algorithms to run (a policy may appear more than once, e.g. round robin with several quanta).
+ * @param params Settings of each algorithm.
+ * @param count Number of algorithms, 1 to SCHEDULE_MAX_COMPARE.
+ * @param stats Receives the totals and averages of each algorithm.
+ * @return bool False if the working memory could not be allocated, or the count or a setting is invalid.
+ */
+bool schedule_compare(const struct ProcessTable *table, const enum SchedulePolicy *policies,
+                      const struct ScheduleParams *params, int count, struct ScheduleStats *stats);
+
+/**
+ * Workload generated for each replication: Poisson arrivals and exponentially distributed burst times.
+ */
+struct ScheduleWorkload {
+    uint32_t count;         // Processes per replication (> 0).
+    double load;            // Offered load, the mean burst time over the mean time between arrivals (> 0).
+    double mean_burst;      // Mean burst time (>= 1), every burst is at least 1.
+    int priorities;         // Priorities (and tickets) are drawn evenly from 0 to priorities - 1 (> 0).
+};
+
+/**
+ * When replications stop.
+ */
+struct ScheduleReplication {
+    double confidence;      // Confidence level of the intervals (e.g. 0.95, 0.5 to 0.9999).
+    double precision;       // Stop once both intervals' half-widths are within this fraction of their means (> 0).
+    uint32_t min_replications;  // Replications before the stopping rule is checked (>= 2).
+    uint32_t max_replications;  // Replications at most, whether the rule is met or not.
+    int threads;            // Replications run at once, 1 to SCHEDULE_MAX_THREADS.
+    uint64_t seed;          // Replication i generates its workload from (seed, i), whatever the thread.
+};
+
+/**
+ * Average wait and turnaround over the replications, each with the half-width of its confidence interval.
+ */
+struct ScheduleEstimate {
+    uint32_t replications;  // Replications counted, the first ones in order.
+    bool converged;         // True if the precision was reached, false if max_replications ran out first.
+    double mean_wait;
+    double wait_half_width;
+    double mean_turnaround;
+    double turnaround_half_width;
+    double seconds;         // Wall-clock time.
+};
+
+/**
+ * Runs an algorithm over generated workloads (Monte-Carlo replications) on several threads until the
+ * average wait and turnaround are known to the precision asked. Each replication draws a fresh workload
+ * from its own seed, runs the algorithm over it, and contributes its average wait and turnaround as one
+ * sample. The intervals are Student t intervals over those samples, and the stopping rule is checked as
+ * every replication is counted, in replication order, so the result depends only on the seed, never on
+ * the number of threads or their timing (the few replications past the stopping point are discarded).
+ * Running several algorithms with the same seed gives them the same workloads, so their differences
+ * are measured more precisely than their values.
+ *
+ * @param policy Scheduling algorithm.
+ * @param params Algorithm settings, NULL for the defaults.
+ * @param workload What to generate for each replication.
+ * @param replication Stopping rule, threads, and seed.
+ * @param estimate Receives the averages and their half-widths.
+ * @return bool False if a setting is invalid, the algorithm is PSJF or PSRTF (the generated processes have
+ *              no tasks to predict from), the workload would not fit the time in an int, or out of memory.
+ */
+bool schedule_replicate(enum SchedulePolicy policy, const struct ScheduleParams *params,
+                        const struct ScheduleWorkload *workload, const struct ScheduleReplication *replication,
+                        struct ScheduleEstimate *estimate);
+
+/**
+ * Handles of every process in arrival order (start time, then ID), sorted in O(n).
+ *
+ * @param table Process table.
+ * @param count Receives the number of handles.
+ * @return ProcessHandle* Array to free, NULL if it could not be allocated (or the table is empty).
+ */
+ProcessHandle *schedule_arrival_order(const struct ProcessTable *table, uint32_t *count);
+
+#endif // SCHEDULE_H
@@ -0,0 +1,365 @@
+/**
+ * Process manager socket server implementation file.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#define _GNU_SOURCE     // accept4
+
+#include "server.h"
+#include "dashboard.h"
+#include "journal.h"
+#include "manager.h"
+#include "protocol.h"
+#include <stdio.h>
+
+#ifdef _WIN32
+
+int runServer(struct ProcessTable *table, const char *socket_path) {
+    fprintf(stderr, "server: not supported on Windows\n");
+    return 1;
+}
+
+#else
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * One client connection. Responses to one read always fit in the output buffer, because
+ * a connection is not read again until its output has been written.
+ */
+struct ServerConnection {
+    int fd;
+    size_t in_length;       // Bytes of unprocessed requests (at most one partial request after processing).
+    size_t out_start;       // Bytes of out already written.
+    size_t out_length;
+    bool draining;          // Registered for EPOLLOUT instead of EPOLLIN until out is written.
+    char in[SERVER_BUFFER_SIZE];
+    char out[SERVER_BUFFER_SIZE];
+};
+
+/* Global Variables */
+static volatile sig_atomic_t stop_server = 0;
+static long long requests_served = 0;
+
+/**
+ * SIGINT/SIGTERM handler, ends the event loop.
+ */
+static void _serverStop(int signal) {
+    (void)signal;
+    stop_server = 1;
+}
+
+/**
+ * Executes one request against the table and journals it if it changed anything.
+ */
+static void _serverExecute(struct ProcessTable *table, const struct Request *request, struct Response *response) {
+    const int32_t *args = request->args;
+    uint32_t count = 0;
+
+    memset(response, 0, sizeof(*response));
+    response->id = request->id;
+
+    switch (request->op) {
+        case REQUEST_CREATE:
+            response->result = pm_create(table, request->id, args[0], args[1], args[2]);
+            if (response->result == PM_OK) {
+                journal_append(JOURNAL_CREATE, request->id, args[0], args[1], args[2], 0);
+            }
+            break;
+        case REQUEST_SCHEDULE:
+            response->result = pm_schedule(table, request->id, args[0], args[1]);
+            if (response->result == PM_OK) {
+                journal_append(JOURNAL_SCHEDULE, request->id, args[0], args[1], 0, 0);
+            }
+            break;
+        case REQUEST_TERMINATE:
+            response->result = pm_terminate(table, request->id);
+            if (response->result == PM_OK) {
+                journal_append(JOURNAL_TERMINATE, request->id, 0, 0, 0, 0);
+            }
+            break;
+        case REQUEST_QUERY: {
+            struct Process *process = pt_get(table, pt_find(table, request->id));
+            if (process == NULL) {
+                response->result = PM_ERR_NOT_FOUND;
+                break;
+            }
+            response->result = PM_OK;
+            response->values[0] = process->state;
+            response->values[1] = process->priority;
+            response->values[2] = process->start_time;
+            response->values[3] = process->work_time;
+            break;
+        }
+        case REQUEST_DISPATCH: {
+            int id = 0;
+            response->result = pm_dispatch(table, &id);
+            response->id = id;
+            if (response->result == PM_OK) {
+                journal_append(JOURNAL_DISPATCH, id, 0, 0, 0, 0);
+                dashboard_cpu(0, id);
+            }
+            break;
+        }
+        case REQUEST_PRIORITY:
+            response->result = pm_set_priority(table, request->id, args[0]);
+            if (response->result == PM_OK) {
+                journal_append(JOURNAL_PRIORITY, request->id, args[0], 0, 0, 0);
+            }
+            break;
+        case REQUEST_PURGE: {
+            struct ProcessFilter filter = { request->id, args[0], args[1], args[2], args[3] };
+            response->result = pm_terminate_where(table, &filter, &count);
+            if (count > 0) {
+                journal_append(JOURNAL_TERMINATE_WHERE, request->id, args[0], args[1], args[2], args[3]);
+            }
+            response->values[0] = (int32_t)count;
+            break;
+        }
+        case REQUEST_UNBLOCK:
+            response->result = pm_unblock_all(table, &count);
+            if (count > 0) {
+                journal_append(JOURNAL_UNBLOCK_ALL, 0, 0, 0, 0, 0);
+            }
+            response->values[0] = (int32_t)count;
+            break;
+        default:
+            response->result = PROTOCOL_RESULT_BAD_OP;
+            break;
+    }
+}
+
+/**
+ * Microseconds on the monotonic clock.
+ */
+static long long _serverMicros() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000LL + now.tv_nsec / 1000;
+}
+
+/**
+ * Publishes the table to the live dashboard after a batch of requests: requests served,
+ * the Blocked/Ready/Running counts, and how long the batch took.
+ */
+static void _serverPublish(const struct ProcessTable *table, size_t num_requests, long long start) {
+    requests_served += num_requests;
+    dashboard_clock(requests_served);
+    for (int state = -1; state <= 1; state++) {
+        dashboard_queue(state + 1, (int)pt_state_count(table, state));
+    }
+    dashboard_complete((int)num_requests);
+    dashboard_wait(_serverMicros() - start);
+}
+
+/**
+ * Executes every complete request in the input buffer, appending the responses to the output buffer.
+ */
+static void _serverProcess(struct ProcessTable *table, struct ServerConnection *conn) {
+    size_t num_requests = conn->in_length / sizeof(struct Request);
+    bool publish = dashboard_active();
+    long long start = publish ? _serverMicros() : 0;
+    for (size_t i = 0; i < num_requests; i++) {
+        struct Request request;
+        struct Response response;
+        memcpy(&request, conn->in + i * sizeof(struct Request), sizeof(request));
+        _serverExecute(table, &request, &response);
+        memcpy(conn->out + conn->out_length, &response, sizeof(response));
+        conn->out_length += sizeof(response);
+    }
+    if (publish && num_requests > 0) {
+        _serverPublish(table, num_requests, start);
+    }
+
+    // Keep the partial request (if any) at the start of the buffer.
+    size_t used = num_requests * sizeof(struct Request);
+    memmove(conn->in, conn->in + used, conn->in_length - used);
+    conn->in_length -= used;
+}
+
+/**
+ * Writes as much pending output as the socket takes.
+ *
+ * @return bool False if the connection failed.
+ */
+static bool _serverFlush(struct ServerConnection *conn) {
+    while (conn->out_start < conn->out_length) {
+        ssize_t written = write(conn->fd, conn->out + conn->out_start, conn->out_length - conn->out_start);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        conn->out_start += written;
+    }
+    conn->out_start = 0;
+    conn->out_length = 0;
+    return true;
+}
+
+/**
+ * Handles a readable or writable connection.
+ *
+ * @return bool False if the connection should be closed.
+ */
+static bool _serverHandle(struct ProcessTable *table, int epoll_fd, struct ServerConnection *conn, uint32_t events) {
+    if (events & (EPOLLERR | EPOLLHUP) && !(events & EPOLLIN)) {
+        return false;
+    }
+
+    if (conn->out_length == 0 && (events & EPOLLIN)) {
+        ssize_t num_read = read(conn->fd, conn->in + conn->in_length, SERVER_BUFFER_SIZE - conn->in_length);
+        if (num_read == 0) {
+            return false;
+        }
+        if (num_read < 0) {
+            return errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        conn->in_length += num_read;
+        _serverProcess(table, conn);
+    }
+
+    if (!_serverFlush(conn)) {
+        return false;
+    }
+
+    // Wait for the socket to drain before reading more, so a client that does not read cannot grow our buffers.
+    bool draining = (conn->out_length > 0);
+    if (draining == conn->draining) {
+        return true;
+    }
+    struct epoll_event event;
+    event.events = draining ? EPOLLOUT : EPOLLIN;
+    event.data.ptr = conn;
+    conn->draining = draining;
+    return epoll_ctl(epoll_fd, EPOLL_CTL_MOD, conn->fd, &event) == 0;
+}
+
+/**
+ * Accepts every pending connection on the listening socket.
+ */
+static void _serverAccept(int listen_fd, int epoll_fd, int *num_connections) {
+    while (true) {
+        int fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                perror("server: accept");
+            }
+            return;
+        }
+
+        struct ServerConnection *conn = malloc(sizeof(struct ServerConnection));
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = conn;
+        if (conn == NULL || epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            free(conn);
+            close(fd);
+            continue;
+        }
+        conn->fd = fd;
+        conn->in_length = 0;
+        conn->out_start = 0;
+        conn->out_length = 0;
+        conn->draining = false;
+        (*num_connections)++;
+    }
+}
+
+/**
+ * Creates the non-blocking listening socket.
+ *
+ * @return int Socket, -1 on failure (a message is printed).
+ */
+static int _serverListen(const char *socket_path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "server: socket path is too long\n");
+        return -1;
+    }
+    strcpy(address.sun_path, socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        perror("server: socket");
+        return -1;
+    }
+    unlink(socket_path);
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        perror(socket_path);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int runServer(struct ProcessTable *table, const char *socket_path) {
+    int listen_fd = _serverListen(socket_path);
+    if (listen_fd < 0) {
+        return 1;
+    }
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = NULL;      // NULL marks the listening socket.
+    if (epoll_fd < 0 || epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &event) != 0) {
+        perror("server: epoll");
+        close(listen_fd);
+        unlink(socket_path);
+        return 1;
+    }
+
+    // No SA_RESTART, so a signal interrupts epoll_wait. A client that disconnects mid-write must not kill the server.
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = _serverStop;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    fprintf(stderr, "server: listening on %s\n", socket_path);
+    int num_connections = 0;
+    struct epoll_event events[SERVER_MAX_EVENTS];
+    while (!stop_server) {
+        int num_events = epoll_wait(epoll_fd, events, SERVER_MAX_EVENTS, -1);
+        if (num_events < 0 && errno != EINTR) {
+            perror("server: epoll_wait");
+            break;
+        }
+        for (int i = 0; i < num_events; i++) {
+            struct ServerConnection *conn = events[i].data.ptr;
+            if (conn == NULL) {
+                _serverAccept(listen_fd, epoll_fd, &num_connections);
+            }
+            else if (!_serverHandle(table, epoll_fd, conn, events[i].events)) {
+                close(conn->fd);    // Also removes it from the epoll set.
+                free(conn);
+                num_connections--;
+            }
+        }
+    }
+
+    // Connections still open at shutdown are closed by the process exiting.
+    fprintf(stderr, "server: shutting down with %d connections open\n", num_connections);
+    close(epoll_fd);
+    close(listen_fd);
+    unlink(socket_path);
+    return 0;
+}
+
+#endif
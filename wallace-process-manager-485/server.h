@@ -0,0 +1,34 @@
+/**
+ * Process manager socket server header file.
+ * Serves the process table to local programs over a Unix domain socket (see protocol.h),
+ * with one epoll event loop handling every connection.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "process_table.h"
+
+#define SERVER_BUFFER_SIZE 65536    // Bytes of requests read from a connection at a time.
+#define SERVER_MAX_EVENTS 64        // Events handled per epoll_wait.
+
+/**
+ * Listens on a Unix domain socket and serves requests until SIGINT or SIGTERM.
+ * Every request that arrives in one read is executed before the responses are written back
+ * in a single write, so pipelined clients get their batches answered in one system call.
+ * A connection whose responses are not being read stops being read until they drain.
+ * Changes are journaled like any other (see journal.h).
+ * If the live dashboard is running (see dashboard.h), it shows requests served, the state counts,
+ * and the time taken by each batch.
+ *
+ * @param table Process table to serve.
+ * @param socket_path Path of the socket, replaced if it already exists.
+ * @return int 0 after a clean shutdown, 1 if the socket could not be set up.
+ */
+int runServer(struct ProcessTable *table, const char *socket_path);
+
+#endif // SERVER_H
@@ -0,0 +1,338 @@
+/**
+ * Process table snapshot implementation file.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#include "snapshot.h"
+#include <stdio.h>
+
+#ifdef _WIN32
+
+bool snapshot_load(struct ProcessTable *table, const char *path, uint64_t *journal_lsn) {
+    fprintf(stderr, "snapshot: not supported on Windows\n");
+    return false;
+}
+
+bool snapshot_save(const struct ProcessTable *table, const char *path, uint64_t journal_lsn) {
+    fprintf(stderr, "snapshot: not supported on Windows\n");
+    return false;
+}
+
+bool snapshot_wait() {
+    return true;
+}
+
+void snapshot_unmap() {
+}
+
+#else
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define SNAPSHOT_ALIGN 4096     // Section alignment, so mapped slabs start on a page.
+
+/* Global Variables */
+static void *mapping = NULL;        // Snapshot mapped by snapshot_load.
+static size_t mapping_size = 0;
+static pid_t writer_pid = -1;       // Child writing the current snapshot, -1 if none.
+static bool last_save_ok = true;
+
+/**
+ * Rounds an offset up to the section alignment.
+ */
+static uint64_t _snapshotAlign(uint64_t offset) {
+    return (offset + SNAPSHOT_ALIGN - 1) & ~(uint64_t)(SNAPSHOT_ALIGN - 1);
+}
+
+/**
+ * FNV-1a hash of the header with the checksum field zeroed.
+ */
+static uint64_t _snapshotChecksum(const struct SnapshotHeader *header) {
+    struct SnapshotHeader copy = *header;
+    copy.checksum = 0;
+
+    uint64_t hash = 14695981039346656037ULL;
+    const unsigned char *bytes = (const unsigned char *)&copy;
+    for (size_t i = 0; i < sizeof(copy); i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * Size in bytes of the ready heap and the ID index sections.
+ */
+static uint64_t _snapshotHeapBytes(uint32_t num_slabs) {
+    return (uint64_t)num_slabs * PT_SLAB_SIZE * sizeof(uint32_t);
+}
+static uint64_t _snapshotIndexBytes(uint32_t capacity) {
+    return sizeof(struct ProcessIndex) + (uint64_t)capacity * sizeof(uint32_t);
+}
+
+/**
+ * Fills in a header, including the section offsets, for a table.
+ */
+static void _snapshotHeader(const struct ProcessTable *table, uint64_t journal_lsn, struct SnapshotHeader *header) {
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic));
+    header->version = SNAPSHOT_VERSION;
+    header->header_size = sizeof(struct SnapshotHeader);
+    header->slot_size = sizeof(struct ProcessSlot);
+    header->slab_size = PT_SLAB_SIZE;
+
+    header->num_slabs = table->num_slabs;
+    header->free_head = table->free_head;
+    header->count = table->count;
+    for (int i = 0; i < PT_NUM_STATES; i++) {
+        header->state_head[i] = table->state_head[i];
+        header->state_tail[i] = table->state_tail[i];
+        header->state_count[i] = table->state_count[i];
+    }
+    header->created_head = table->created_head;
+    header->created_tail = table->created_tail;
+    header->index_capacity = table->index->capacity;
+    header->journal_lsn = journal_lsn;
+
+    header->slabs_offset = _snapshotAlign(sizeof(struct SnapshotHeader));
+    header->heap_offset = _snapshotAlign(header->slabs_offset + (uint64_t)table->num_slabs * sizeof(struct ProcessSlab));
+    header->index_offset = _snapshotAlign(header->heap_offset + _snapshotHeapBytes(table->num_slabs));
+    header->file_size = header->index_offset + _snapshotIndexBytes(table->index->capacity);
+    header->checksum = _snapshotChecksum(header);
+}
+
+/**
+ * Writes a whole buffer, retrying short writes.
+ */
+static bool _snapshotWrite(int fd, const void *data, size_t length) {
+    const char *ptr = data;
+    while (length > 0) {
+        ssize_t written = write(fd, ptr, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        ptr += written;
+        length -= written;
+    }
+    return true;
+}
+
+/**
+ * Moves the file position to a section offset (the gap reads back as zeros).
+ */
+static bool _snapshotSeek(int fd, uint64_t offset) {
+    return lseek(fd, (off_t)offset, SEEK_SET) == (off_t)offset;
+}
+
+/**
+ * Child side of snapshot_save: writes the table image to a temporary file and renames it into place.
+ */
+static bool _snapshotWriteFile(const struct ProcessTable *table, const char *path, uint64_t journal_lsn) {
+    struct SnapshotHeader header;
+    _snapshotHeader(table, journal_lsn, &header);
+
+    char tmp_path[4096];
+    if (snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path) >= (int)sizeof(tmp_path)) {
+        return false;
+    }
+    int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    bool ok = _snapshotWrite(fd, &header, sizeof(header)) && _snapshotSeek(fd, header.slabs_offset);
+    for (uint32_t i = 0; ok && i < table->num_slabs; i++) {
+        ok = _snapshotWrite(fd, table->slabs[i], sizeof(struct ProcessSlab));
+    }
+    ok = ok && _snapshotSeek(fd, header.heap_offset);
+    if (ok && table->num_slabs > 0) {
+        ok = _snapshotWrite(fd, table->ready_heap, _snapshotHeapBytes(table->num_slabs));
+    }
+    ok = ok && _snapshotSeek(fd, header.index_offset)
+            && _snapshotWrite(fd, table->index, _snapshotIndexBytes(table->index->capacity))
+            && fdatasync(fd) == 0;
+    ok = (close(fd) == 0) && ok;
+
+    if (!ok || rename(tmp_path, path) != 0) {
+        unlink(tmp_path);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Checks that a header describes a snapshot this build can map, with every section inside the file.
+ */
+static const char *_snapshotValidate(const struct SnapshotHeader *header, uint64_t file_size) {
+    if (file_size < sizeof(struct SnapshotHeader) || memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0) {
+        return "not a snapshot file";
+    }
+    if (header->version != SNAPSHOT_VERSION) {
+        return "unsupported snapshot version";
+    }
+    if (header->header_size != sizeof(struct SnapshotHeader) || header->slot_size != sizeof(struct ProcessSlot) ||
+        header->slab_size != PT_SLAB_SIZE) {
+        return "snapshot was written by an incompatible build";
+    }
+    if (header->checksum != _snapshotChecksum(header)) {
+        return "snapshot header is corrupt";
+    }
+
+    uint64_t num_slots = (uint64_t)header->num_slabs * PT_SLAB_SIZE;
+    uint64_t state_total = 0;
+    for (int i = 0; i < PT_NUM_STATES; i++) {
+        if ((header->state_head[i] != PT_NO_SLOT && header->state_head[i] >= num_slots) ||
+            (header->state_tail[i] != PT_NO_SLOT && header->state_tail[i] >= num_slots)) {
+            return "snapshot state lists are out of range";
+        }
+        state_total += header->state_count[i];
+    }
+    if (header->num_slabs > PT_MAX_SLABS || header->count > num_slots || state_total != header->count ||
+        (header->free_head != PT_NO_SLOT && header->free_head >= num_slots) ||
+        (header->created_head != PT_NO_SLOT && header->created_head >= num_slots) ||
+        (header->created_tail != PT_NO_SLOT && header->created_tail >= num_slots)) {
+        return "snapshot counts are out of range";
+    }
+    if (header->index_capacity == 0 || (header->index_capacity & (header->index_capacity - 1)) != 0 ||
+        header->count >= header->index_capacity) {
+        return "snapshot ID index is invalid";
+    }
+
+    if (header->file_size != file_size ||
+        header->slabs_offset != _snapshotAlign(sizeof(struct SnapshotHeader)) ||
+        header->heap_offset != _snapshotAlign(header->slabs_offset + (uint64_t)header->num_slabs * sizeof(struct ProcessSlab)) ||
+        header->index_offset != _snapshotAlign(header->heap_offset + _snapshotHeapBytes(header->num_slabs)) ||
+        header->file_size != header->index_offset + _snapshotIndexBytes(header->index_capacity)) {
+        return "snapshot sections do not match the file size";
+    }
+    return NULL;
+}
+
+bool snapshot_load(struct ProcessTable *table, const char *path, uint64_t *journal_lsn) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        if (errno != ENOENT) {
+            perror(path);
+        }
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(struct SnapshotHeader)) {
+        fprintf(stderr, "snapshot: %s: not a snapshot file\n", path);
+        close(fd);
+        return false;
+    }
+
+    // Private mapping: pages are shared with the page cache until the table writes to them.
+    void *base = mmap(NULL, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        perror(path);
+        return false;
+    }
+
+    const struct SnapshotHeader *header = base;
+    const char *error = _snapshotValidate(header, (uint64_t)info.st_size);
+    if (error != NULL) {
+        fprintf(stderr, "snapshot: %s: %s\n", path, error);
+        munmap(base, (size_t)info.st_size);
+        return false;
+    }
+
+    char *bytes = base;
+    struct ProcessSlab *slabs = (struct ProcessSlab *)(bytes + header->slabs_offset);
+    for (uint32_t i = 0; i < PT_MAX_SLABS; i++) {
+        table->slabs[i] = (i < header->num_slabs) ? &slabs[i] : NULL;
+    }
+    table->num_slabs = header->num_slabs;
+    table->free_head = header->free_head;
+    table->count = header->count;
+    for (int i = 0; i < PT_NUM_STATES; i++) {
+        table->state_head[i] = header->state_head[i];
+        table->state_tail[i] = header->state_tail[i];
+        table->state_count[i] = header->state_count[i];
+    }
+    table->created_head = header->created_head;
+    table->created_tail = header->created_tail;
+    table->ready_heap = (header->num_slabs > 0) ? (uint32_t *)(bytes + header->heap_offset) : NULL;
+    table->index = (struct ProcessIndex *)(bytes + header->index_offset);
+    table->index->retired = NULL;
+    table->retain_retired = false;
+    table->borrowed = bytes;
+    table->borrowed_size = (size_t)info.st_size;
+    *journal_lsn = header->journal_lsn;
+
+    mapping = base;
+    mapping_size = (size_t)info.st_size;
+    return true;
+}
+
+/**
+ * Collects the snapshot child if it has finished.
+ *
+ * @param block Wait for the child instead of returning if it is still running.
+ */
+static void _snapshotReap(bool block) {
+    if (writer_pid < 0) {
+        return;
+    }
+
+    int status;
+    pid_t pid = waitpid(writer_pid, &status, block ? 0 : WNOHANG);
+    if (pid == writer_pid) {
+        last_save_ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        if (!last_save_ok) {
+            fprintf(stderr, "snapshot: writing the snapshot failed\n");
+        }
+        writer_pid = -1;
+    }
+    else if (pid < 0) {
+        writer_pid = -1;
+    }
+}
+
+bool snapshot_save(const struct ProcessTable *table, const char *path, uint64_t journal_lsn) {
+    _snapshotReap(false);
+    if (writer_pid >= 0) {
+        return false;
+    }
+
+    // The child gets a copy-on-write image of the table as it is right now, the parent carries on.
+    pid_t pid = fork();
+    if (pid < 0) {
+        return false;
+    }
+    if (pid == 0) {
+        _exit(_snapshotWriteFile(table, path, journal_lsn) ? 0 : 1);
+    }
+    writer_pid = pid;
+    return true;
+}
+
+bool snapshot_wait() {
+    _snapshotReap(true);
+    return last_save_ok;
+}
+
+void snapshot_unmap() {
+    if (mapping != NULL) {
+        munmap(mapping, mapping_size);
+        mapping = NULL;
+        mapping_size = 0;
+    }
+}
+
+#endif
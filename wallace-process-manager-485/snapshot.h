@@ -0,0 +1,86 @@
+/**
+ * Process table snapshot header file.
+ * Saves the process table to a file that can be memory-mapped straight back into a table,
+ * so startup never parses or re-inserts processes. Linux/Unix only.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "process_table.h"
+#include <stdbool.h>
+
+#define SNAPSHOT_MAGIC "PRMSNAP"    // First 8 bytes of every snapshot file.
+#define SNAPSHOT_VERSION 6          // Bumped whenever the file layout changes.
+
+/**
+ * Snapshot file header, followed by the slabs, the ready heap, and the ID index,
+ * each starting on a page boundary and laid out exactly as they are in memory.
+ */
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;       // sizeof(struct SnapshotHeader).
+    uint32_t slot_size;         // sizeof(struct ProcessSlot), rejects files from a different build.
+    uint32_t slab_size;         // PT_SLAB_SIZE.
+
+    uint32_t num_slabs;
+    uint32_t free_head;
+    uint32_t count;
+    uint32_t state_head[PT_NUM_STATES];
+    uint32_t state_tail[PT_NUM_STATES];
+    uint32_t state_count[PT_NUM_STATES];
+    uint32_t created_head;
+    uint32_t created_tail;
+    uint32_t index_capacity;
+    uint64_t journal_lsn;       // Last journal record contained in the snapshot.
+
+    uint64_t slabs_offset;
+    uint64_t heap_offset;
+    uint64_t index_offset;
+    uint64_t file_size;
+    uint64_t checksum;          // FNV-1a of the header, computed with this field set to 0.
+};
+
+/**
+ * Initializes a table from a snapshot file instead of pt_init. The file is mapped copy-on-write,
+ * so the table can be changed freely without touching the file, and only the pages that are
+ * used get read from disk. Only the header is validated, there are no per-process inserts.
+ * Call snapshot_unmap after pt_destroy when done with the table.
+ *
+ * @param table Uninitialized table, left uninitialized if loading fails.
+ * @param path Snapshot file.
+ * @param journal_lsn Receives the LSN of the last journal record contained in the snapshot.
+ * @return bool False if the file is missing or not a valid snapshot (a message is printed unless missing).
+ */
+bool snapshot_load(struct ProcessTable *table, const char *path, uint64_t *journal_lsn);
+
+/**
+ * Saves a snapshot without pausing the caller: a forked child writes the copy-on-write image
+ * of the table to "<path>.tmp", syncs it, and renames it over the old snapshot.
+ * Only one snapshot is written at a time.
+ *
+ * @param table Table to snapshot.
+ * @param path Snapshot file.
+ * @param journal_lsn LSN of the last journal record applied to the table (0 without a journal).
+ * @return bool False if a snapshot is already being written or the child could not be started.
+ */
+bool snapshot_save(const struct ProcessTable *table, const char *path, uint64_t journal_lsn);
+
+/**
+ * Waits for the snapshot being written (if any) to finish.
+ *
+ * @return bool False if the last snapshot failed.
+ */
+bool snapshot_wait();
+
+/**
+ * Unmaps the snapshot loaded by snapshot_load. The table must already be destroyed.
+ */
+void snapshot_unmap();
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,173 @@
+/**
+ * Concurrent process table stress driver. See README for more information.
+ * Runs a mix of lookups and create/schedule/terminate calls from 1, 2, 4, ... threads
+ * against a shared concurrent table and reports throughput for each thread count.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#include "concurrent_table.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define KEY_SPACE (1 << 20)     // Process IDs are drawn from [0, KEY_SPACE).
+
+struct StressWorker {
+    pthread_t tid;
+    uint64_t seed;
+    long long ops;
+    long long torn_reads;       // Lookups that returned a process not matching its ID.
+};
+
+/* Global Variables */
+struct ConcurrentTable *table;
+atomic_bool stop;
+int lookup_percent = 90;        // Share of operations that are lookups.
+
+/**
+ * xorshift64 pseudo-random generator, one state per thread.
+ */
+static uint64_t _stressRandom(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+/**
+ * Fields derived from the process ID, so a lookup can check that it read a whole process.
+ */
+static int _stressStart(int id) { return id % 50 + 1; }
+static int _stressWork(int id) { return id % 1000 + 1; }
+
+/**
+ * Worker thread: runs random operations until told to stop.
+ */
+void *stressWorker(void *ptr) {
+    struct StressWorker *worker = ptr;
+    struct Process process;
+    long long ops = 0;
+
+    while (!atomic_load_explicit(&stop, memory_order_relaxed)) {
+        uint64_t r = _stressRandom(&worker->seed);
+        int id = (int)(r % KEY_SPACE);
+        int op = (int)((r >> 32) % 100);
+
+        if (op < lookup_percent) {
+            if (ct_lookup(table, id, &process) &&
+                (process.id != id || process.start_time != _stressStart(id) || process.work_time != _stressWork(id))) {
+                worker->torn_reads++;
+            }
+        }
+        else {
+            switch (op % 4) {
+                case 0:
+                    ct_create(table, id, (int)(r >> 48) % 10, _stressStart(id), _stressWork(id));
+                    break;
+                case 1:
+                    ct_schedule(table, id, 0, 1);
+                    break;
+                case 2:
+                    ct_schedule(table, id, 1, 0);
+                    break;
+                case 3:
+                    ct_terminate(table, id);
+                    break;
+            }
+        }
+        ops++;
+    }
+
+    worker->ops = ops;
+    return NULL;
+}
+
+/**
+ * Runs one timed round with a given number of threads.
+ *
+ * @return double Operations per second.
+ */
+double stressRun(int num_threads, double seconds, long long *torn_reads) {
+    struct StressWorker *workers = calloc(num_threads, sizeof(struct StressWorker));
+    struct timespec start, finish;
+
+    atomic_store(&stop, false);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < num_threads; i++) {
+        workers[i].seed = 0x9E3779B97F4A7C15ULL * (i + 1);
+        pthread_create(&workers[i].tid, NULL, stressWorker, &workers[i]);
+    }
+
+    usleep((useconds_t)(seconds * 1e6));
+    atomic_store(&stop, true);
+
+    long long total_ops = 0;
+    for (int i = 0; i < num_threads; i++) {
+        pthread_join(workers[i].tid, NULL);
+        total_ops += workers[i].ops;
+        *torn_reads += workers[i].torn_reads;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &finish);
+    free(workers);
+
+    double elapsed = (finish.tv_sec - start.tv_sec) + (finish.tv_nsec - start.tv_nsec) / 1e9;
+    return total_ops / elapsed;
+}
+
+/**
+ * Main function.
+ * Usage: PRM_STRESS [max threads] [seconds per run] [lookup percent]
+ *
+ * @return int Successful run returns 0, otherwise returns 1.
+ */
+int main(int argc, char *argv[]) {
+    int max_threads = (argc > 1) ? atoi(argv[1]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    double seconds = (argc > 2) ? atof(argv[2]) : 1.0;
+    lookup_percent = (argc > 3) ? atoi(argv[3]) : 90;
+    if (max_threads < 1 || seconds <= 0 || lookup_percent < 0 || lookup_percent > 100) {
+        fprintf(stderr, "Usage: %s [max threads] [seconds per run] [lookup percent]\n", argv[0]);
+        return 1;
+    }
+
+    table = malloc(sizeof(struct ConcurrentTable));
+    if (table == NULL || !ct_init(table)) {
+        fprintf(stderr, "Could not allocate the process table.\n");
+        return 1;
+    }
+
+    // Start half full so lookups, schedules, and terminates mostly find something.
+    for (int id = 0; id < KEY_SPACE; id += 2) {
+        ct_create(table, id, id % 10, _stressStart(id), _stressWork(id));
+    }
+
+    printf("%d%% lookups, %d shards, %.1f s per run\n", lookup_percent, CT_NUM_SHARDS, seconds);
+    printf("THREADS  OPS/SEC        SPEEDUP  TORN READS\n");
+
+    double base = 0;
+    for (int threads = 1; ; threads *= 2) {
+        if (threads > max_threads) {
+            threads = max_threads;
+        }
+        long long torn_reads = 0;
+        double rate = stressRun(threads, seconds, &torn_reads);
+        if (threads == 1) {
+            base = rate;
+        }
+        printf("%-8d %-14.0f %-8.2f %lld\n", threads, rate, rate / base, torn_reads);
+        fflush(stdout);
+        if (threads == max_threads) {
+            break;
+        }
+    }
+
+    printf("%u processes in table\n", ct_count(table));
+    ct_destroy(table);
+    free(table);
+    return 0;
+}
@@ -0,0 +1,388 @@
+/**
+ * Execution timeline implementation file.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#include "timeline.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define TIMELINE_MAX_SLICE 30       // Longest encoding of one slice (three varints).
+
+/**
+ * Decodes slices forward from a checkpoint.
+ */
+struct TimelineCursor {
+    const uint8_t *next;
+    long long end;          // End of the last decoded slice.
+    long long id;           // Process ID of the last decoded slice.
+    uint64_t slice;         // Number of the next slice.
+};
+
+static uint64_t _timelineZigzag(long long value) {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static long long _timelineUnzigzag(uint64_t value) {
+    return (long long)(value >> 1) ^ -(long long)(value & 1);
+}
+
+/**
+ * Writes an unsigned LEB128 varint, 7 bits per byte with the high bit set on all but the last byte.
+ *
+ * @return int Bytes written (at most 10).
+ */
+static int _timelinePut(uint8_t *out, uint64_t value) {
+    int length = 0;
+    while (value >= 0x80) {
+        out[length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[length++] = (uint8_t)value;
+    return length;
+}
+
+static uint64_t _timelineGet(const uint8_t **cursor) {
+    uint64_t value = 0;
+    int shift = 0;
+    const uint8_t *in = *cursor;
+    while (*in & 0x80) {
+        value |= (uint64_t)(*in++ & 0x7F) << shift;
+        shift += 7;
+    }
+    value |= (uint64_t)*in++ << shift;
+    *cursor = in;
+    return value;
+}
+
+/**
+ * Encodes one slice at the end of the timeline, adding a checkpoint at the start of every block.
+ */
+static bool _timelineEncode(struct Timeline *timeline, long long start, long long length, int id) {
+    if (timeline->num_slices == 0) {
+        timeline->end = start;
+        timeline->last_id = id;
+    }
+    if (timeline->num_slices % TIMELINE_BLOCK == 0) {
+        if (timeline->num_checkpoints == timeline->checkpoint_capacity) {
+            uint32_t capacity = timeline->checkpoint_capacity ? timeline->checkpoint_capacity * 2 : 16;
+            struct TimelineCheckpoint *checkpoints = realloc(timeline->checkpoints, capacity * sizeof(struct TimelineCheckpoint));
+            if (checkpoints == NULL) {
+                return false;
+            }
+            timeline->checkpoints = checkpoints;
+            timeline->checkpoint_capacity = capacity;
+        }
+        struct TimelineCheckpoint *checkpoint = &timeline->checkpoints[timeline->num_checkpoints];
+        checkpoint->start = start;
+        checkpoint->previous_end = timeline->end;
+        checkpoint->busy = timeline->busy;
+        checkpoint->offset = timeline->length;
+        checkpoint->previous_id = timeline->last_id;
+    }
+    if (timeline->length + TIMELINE_MAX_SLICE > timeline->capacity) {
+        size_t capacity = timeline->capacity ? timeline->capacity * 2 : 1024;
+        uint8_t *data = realloc(timeline->data, capacity);
+        if (data == NULL) {
+            return false;
+        }
+        timeline->data = data;
+        timeline->capacity = capacity;
+    }
+    if (timeline->num_slices % TIMELINE_BLOCK == 0) {
+        timeline->num_checkpoints++;
+    }
+    uint8_t *out = timeline->data + timeline->length;
+    int num_bytes = _timelinePut(out, (uint64_t)(start - timeline->end));
+    num_bytes += _timelinePut(out + num_bytes, (uint64_t)length);
+    num_bytes += _timelinePut(out + num_bytes, _timelineZigzag((long long)id - timeline->last_id));
+    timeline->length += num_bytes;
+    timeline->num_slices++;
+    timeline->end = start + length;
+    timeline->busy += length;
+    timeline->last_id = id;
+    return true;
+}
+
+void timeline_init(struct Timeline *timeline) {
+    memset(timeline, 0, sizeof(*timeline));
+    timeline->by_process_slices = UINT64_MAX;
+}
+
+void timeline_destroy(struct Timeline *timeline) {
+    free(timeline->data);
+    free(timeline->checkpoints);
+    free(timeline->by_process);
+    timeline_init(timeline);
+}
+
+void timeline_clear(struct Timeline *timeline) {
+    timeline->length = 0;
+    timeline->num_slices = 0;
+    timeline->num_checkpoints = 0;
+    timeline->end = 0;
+    timeline->busy = 0;
+    timeline->last_id = 0;
+    timeline->pending = false;
+    timeline->by_process_slices = UINT64_MAX;
+}
+
+bool timeline_append(struct Timeline *timeline, long long start, long long length, int id) {
+    if (length <= 0) {
+        return true;
+    }
+    if (timeline->pending) {
+        long long pending_end = timeline->pending_start + timeline->pending_length;
+        if (start < pending_end) {
+            return false;
+        }
+        if (start == pending_end && id == timeline->pending_id) {
+            timeline->pending_length += length;
+            return true;
+        }
+        if (!_timelineEncode(timeline, timeline->pending_start, timeline->pending_length, timeline->pending_id)) {
+            return false;
+        }
+    }
+    timeline->pending = true;
+    timeline->pending_start = start;
+    timeline->pending_length = length;
+    timeline->pending_id = id;
+    return true;
+}
+
+/**
+ * Positions a cursor at the first slice of a block.
+ */
+static void _timelineSeek(const struct Timeline *timeline, struct TimelineCursor *cursor, uint64_t block) {
+    const struct TimelineCheckpoint *checkpoint = &timeline->checkpoints[block];
+    cursor->next = timeline->data + checkpoint->offset;
+    cursor->end = checkpoint->previous_end;
+    cursor->id = checkpoint->previous_id;
+    cursor->slice = block * TIMELINE_BLOCK;
+}
+
+/**
+ * Decodes the next slice.
+ */
+static void _timelineNext(struct TimelineCursor *cursor, long long *start, long long *length) {
+    *start = cursor->end + (long long)_timelineGet(&cursor->next);
+    *length = (long long)_timelineGet(&cursor->next);
+    cursor->id += _timelineUnzigzag(_timelineGet(&cursor->next));
+    cursor->end = *start + *length;
+    cursor->slice++;
+}
+
+/**
+ * @return long Index of the last checkpoint starting at or before a time, -1 if none.
+ */
+static long _timelineBlock(const struct Timeline *timeline, long long time) {
+    long low = 0;
+    long high = (long)timeline->num_checkpoints - 1;
+    long found = -1;
+    while (low <= high) {
+        long middle = low + (high - low) / 2;
+        if (timeline->checkpoints[middle].start <= time) {
+            found = middle;
+            low = middle + 1;
+        }
+        else {
+            high = middle - 1;
+        }
+    }
+    return found;
+}
+
+bool timeline_at(const struct Timeline *timeline, long long time, int *id) {
+    // The pending slice comes after every encoded one.
+    if (timeline->pending && time >= timeline->pending_start) {
+        *id = timeline->pending_id;
+        return time < timeline->pending_start + timeline->pending_length;
+    }
+    long block = _timelineBlock(timeline, time);
+    if (block < 0) {
+        return false;
+    }
+
+    struct TimelineCursor cursor;
+    long long start, length;
+    _timelineSeek(timeline, &cursor, block);
+    uint64_t last = (block + 1) * (uint64_t)TIMELINE_BLOCK;
+    while (cursor.slice < timeline->num_slices && cursor.slice < last) {
+        _timelineNext(&cursor, &start, &length);
+        if (start > time) {
+            break;
+        }
+        if (time < start + length) {
+            *id = (int)cursor.id;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @return long long Busy time before a time.
+ */
+static long long _timelineBusyBefore(const struct Timeline *timeline, long long time) {
+    long long busy = 0;
+    long block = _timelineBlock(timeline, time);
+    if (block >= 0) {
+        struct TimelineCursor cursor;
+        long long start, length;
+        _timelineSeek(timeline, &cursor, block);
+        busy = timeline->checkpoints[block].busy;
+        uint64_t last = (block + 1) * (uint64_t)TIMELINE_BLOCK;
+        while (cursor.slice < timeline->num_slices && cursor.slice < last) {
+            _timelineNext(&cursor, &start, &length);
+            if (start >= time) {
+                break;
+            }
+            busy += (start + length <= time) ? length : time - start;
+        }
+    }
+    if (timeline->pending && timeline->pending_start < time) {
+        long long end = timeline->pending_start + timeline->pending_length;
+        busy += ((end <= time) ? end : time) - timeline->pending_start;
+    }
+    return busy;
+}
+
+long long timeline_busy(const struct Timeline *timeline, long long from, long long to) {
+    if (to <= from) {
+        return 0;
+    }
+    return _timelineBusyBefore(timeline, to) - _timelineBusyBefore(timeline, from);
+}
+
+/**
+ * Sorts the slice numbers by process ID (then slice number) with an LSD radix sort, skipping bytes that
+ * are the same in every key.
+ *
+ * @return bool False if out of memory.
+ */
+static bool _timelineIndex(struct Timeline *timeline) {
+    uint64_t count = timeline->num_slices;
+    if (timeline->by_process_capacity < count) {
+        uint64_t *by_process = realloc(timeline->by_process, count * sizeof(uint64_t));
+        if (by_process == NULL) {
+            return false;
+        }
+        timeline->by_process = by_process;
+        timeline->by_process_capacity = count;
+    }
+    uint64_t *scratch = malloc(count * sizeof(uint64_t) + 1);
+    if (scratch == NULL) {
+        return false;
+    }
+
+    uint64_t *keys = timeline->by_process;
+    struct TimelineCursor cursor;
+    long long start, length;
+    if (count > 0) {
+        _timelineSeek(timeline, &cursor, 0);
+    }
+    for (uint64_t i = 0; i < count; i++) {
+        _timelineNext(&cursor, &start, &length);
+        keys[i] = ((uint64_t)((uint32_t)cursor.id ^ 0x80000000u) << 32) | i;
+    }
+
+    uint64_t histogram[8][256];     // 16 KiB on the stack, so timelines on several threads never share it.
+    memset(histogram, 0, sizeof(histogram));
+    for (uint64_t i = 0; i < count; i++) {
+        for (int byte = 0; byte < 8; byte++) {
+            histogram[byte][(keys[i] >> (byte * 8)) & 0xFF]++;
+        }
+    }
+    uint64_t *from = keys;
+    uint64_t *to = scratch;
+    for (int byte = 0; byte < 8 && count > 0; byte++) {
+        uint64_t *buckets = histogram[byte];
+        if (buckets[(from[0] >> (byte * 8)) & 0xFF] == count) {
+            continue;
+        }
+        uint64_t offset = 0;
+        for (int b = 0; b < 256; b++) {
+            uint64_t size = buckets[b];
+            buckets[b] = offset;
+            offset += size;
+        }
+        for (uint64_t i = 0; i < count; i++) {
+            to[buckets[(from[i] >> (byte * 8)) & 0xFF]++] = from[i];
+        }
+        uint64_t *swap = from;
+        from = to;
+        to = swap;
+    }
+    if (from != keys) {
+        memcpy(keys, from, count * sizeof(uint64_t));
+    }
+    free(scratch);
+    timeline->by_process_slices = count;
+    return true;
+}
+
+uint32_t timeline_slices(struct Timeline *timeline, int id,
+                         void (*visit)(long long start, long long length, void *context), void *context) {
+    uint32_t count = 0;
+    struct TimelineCursor cursor;
+    long long start, length;
+    cursor.slice = 0;
+    if (timeline->num_slices > UINT32_MAX ||
+        (timeline->by_process_slices != timeline->num_slices && !_timelineIndex(timeline))) {
+        // No index: scan every slice.
+        if (timeline->num_slices > 0) {
+            _timelineSeek(timeline, &cursor, 0);
+        }
+        while (cursor.slice < timeline->num_slices) {
+            _timelineNext(&cursor, &start, &length);
+            if (cursor.id == id) {
+                visit(start, length, context);
+                count++;
+            }
+        }
+    }
+    else {
+        // First key of the process, then its slices in time order.
+        uint64_t first_key = (uint64_t)((uint32_t)id ^ 0x80000000u) << 32;
+        uint64_t low = 0;
+        uint64_t high = timeline->num_slices;
+        while (low < high) {
+            uint64_t middle = low + (high - low) / 2;
+            if (timeline->by_process[middle] < first_key) {
+                low = middle + 1;
+            }
+            else {
+                high = middle;
+            }
+        }
+        cursor.slice = UINT64_MAX;
+        for (uint64_t i = low; i < timeline->num_slices && (timeline->by_process[i] >> 32) == (first_key >> 32); i++) {
+            uint64_t slice = (uint32_t)timeline->by_process[i];
+            // Keep decoding forward when the next slice is later in the same block.
+            if (cursor.slice > slice || slice / TIMELINE_BLOCK != cursor.slice / TIMELINE_BLOCK) {
+                _timelineSeek(timeline, &cursor, slice / TIMELINE_BLOCK);
+            }
+            do {
+                _timelineNext(&cursor, &start, &length);
+            } while (cursor.slice <= slice);
+            visit(start, length, context);
+            count++;
+        }
+    }
+
+    if (timeline->pending && timeline->pending_id == id) {
+        visit(timeline->pending_start, timeline->pending_length, context);
+        count++;
+    }
+    return count;
+}
+
+size_t timeline_bytes(const struct Timeline *timeline) {
+    return timeline->capacity
+         + (size_t)timeline->checkpoint_capacity * sizeof(struct TimelineCheckpoint)
+         + (size_t)timeline->by_process_capacity * sizeof(uint64_t);
+}
@@ -0,0 +1,120 @@
+/**
+ * Execution timeline header file.
+ * Records which process ran when during a scheduling run (see schedule.h) as a run-length-encoded list
+ * of (start, length, process ID) slices, and answers "who ran at time t", "how busy was the CPU
+ * between a and b", and "when did process p run" without replaying the run.
+ * Memory grows with the number of slices (context switches), not with the simulated time: each slice is
+ * a few varint-encoded bytes, back-to-back slices of the same process are merged, and idle time is free.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TIMELINE_BLOCK 64           // Slices between index checkpoints.
+
+/**
+ * Where decoding can start: the first slice of every block of TIMELINE_BLOCK slices.
+ */
+struct TimelineCheckpoint {
+    long long start;        // Start time of the block's first slice.
+    long long previous_end; // End of the slice before the block (slice gaps are encoded relative to it).
+    long long busy;         // Busy time before the block.
+    uint64_t offset;        // Byte offset of the block's first slice.
+    int previous_id;        // Process ID of the slice before the block (IDs are encoded as differences).
+};
+
+struct Timeline {
+    // Slices in time order: varint gap since the previous slice ended, varint length,
+    // zigzag varint difference from the previous slice's process ID.
+    uint8_t *data;
+    size_t length;
+    size_t capacity;
+    uint64_t num_slices;
+
+    struct TimelineCheckpoint *checkpoints;
+    uint32_t num_checkpoints;
+    uint32_t checkpoint_capacity;
+
+    // Encoder state after the last encoded slice.
+    long long end;
+    long long busy;
+    int last_id;
+
+    // Last slice, held back until it can no longer be merged with the next one.
+    bool pending;
+    long long pending_start;
+    long long pending_length;
+    int pending_id;
+
+    // Encoded slices ordered by process ID, then time: (ID with the sign bit flipped) << 32 | slice number.
+    // Only built by timeline_slices, and rebuilt when slices were added since.
+    uint64_t *by_process;
+    uint64_t by_process_slices;     // Encoded slices when it was built.
+    uint64_t by_process_capacity;
+};
+
+/**
+ * Initializes an empty timeline. Nothing is allocated until the first slice.
+ */
+void timeline_init(struct Timeline *timeline);
+
+/**
+ * Frees everything the timeline holds.
+ */
+void timeline_destroy(struct Timeline *timeline);
+
+/**
+ * Empties the timeline, keeping its memory for the next run.
+ */
+void timeline_clear(struct Timeline *timeline);
+
+/**
+ * Records that a process ran from start for length (> 0) time units. Slices must be added in time order
+ * and must not overlap. A slice that continues the previous one for the same process is merged into it.
+ *
+ * @return bool False if the slice starts before the previous one ended, or out of memory (the slice is lost).
+ */
+bool timeline_append(struct Timeline *timeline, long long start, long long length, int id);
+
+/**
+ * Finds the process that was running at a time, in O(log n) (a binary search over the checkpoints,
+ * then decoding at most one block).
+ *
+ * @param time Simulated time.
+ * @param id Receives the process ID.
+ * @return bool False if the CPU was idle at that time.
+ */
+bool timeline_at(const struct Timeline *timeline, long long time, int *id);
+
+/**
+ * Time the CPU was busy in [from, to), in O(log n). Divide by (to - from) for the utilization.
+ */
+long long timeline_busy(const struct Timeline *timeline, long long from, long long to);
+
+/**
+ * Visits every slice of one process in time order. The first call after slices were added sorts the
+ * slices by process in O(n); after that, finding a process takes O(log n) and each slice is decoded
+ * from its block's checkpoint. Without the memory for that index, the whole timeline is scanned instead.
+ *
+ * @param id Process ID.
+ * @param visit Called with the start and length of each slice.
+ * @param context Passed to visit.
+ * @return uint32_t Number of slices visited.
+ */
+uint32_t timeline_slices(struct Timeline *timeline, int id,
+                         void (*visit)(long long start, long long length, void *context), void *context);
+
+/**
+ * @return size_t Bytes of memory the timeline uses.
+ */
+size_t timeline_bytes(const struct Timeline *timeline);
+
+#endif // TIMELINE_H
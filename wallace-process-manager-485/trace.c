@@ -0,0 +1,498 @@
+/**
+ * Scheduler trace importer implementation file.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#include "trace.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * What is known about one task. Tasks are kept in an open-addressed table keyed by PID
+ * (PID 0, the idle task, is never tracked and marks an empty slot).
+ */
+struct TraceTask {
+    int pid;
+    int priority;
+    bool runnable;          // Woken up (or seen running) and has not gone to sleep since.
+    bool running;           // Switched in and not switched out yet.
+    long long arrival;      // When the current burst (the first one in per-task mode) began, -1 if none.
+    long long running_since;
+    long long runtime;      // CPU time of the current burst (all bursts in per-task mode).
+};
+
+/**
+ * State of one import.
+ */
+struct TraceImport {
+    const struct TraceOptions *options;
+    bool (*job)(const struct TraceJob *job, void *context);
+    void *context;
+    struct TraceTask *tasks;
+    uint32_t capacity;      // Power of two.
+    uint32_t count;
+    long long unit_ns;
+    long long first_time;   // Timestamp of the first event, -1 before it.
+    long long last_time;
+    enum TraceResult result;
+    struct TraceStats stats;
+};
+
+/* Global Variables */
+static char input_buffer[TRACE_BLOCK_SIZE];
+
+static uint32_t _traceHash(int pid, uint32_t capacity) {
+    return ((uint32_t)pid * 2654435769u) & (capacity - 1);
+}
+
+/**
+ * @return struct TraceTask* Slot of a task, or the empty slot where it would go.
+ */
+static struct TraceTask *_traceSlot(const struct TraceImport *import, int pid) {
+    uint32_t index = _traceHash(pid, import->capacity);
+    while (import->tasks[index].pid != 0 && import->tasks[index].pid != pid) {
+        index = (index + 1) & (import->capacity - 1);
+    }
+    return &import->tasks[index];
+}
+
+/**
+ * Finds a task, adding it if it is new. The table doubles once it is half full, which moves the tasks.
+ *
+ * @return struct TraceTask* The task, NULL if out of memory.
+ */
+static struct TraceTask *_traceTask(struct TraceImport *import, int pid) {
+    if ((import->count + 1) * 2 > import->capacity) {
+        uint32_t capacity = import->capacity ? import->capacity * 2 : 1024;
+        struct TraceTask *tasks = calloc(capacity, sizeof(struct TraceTask));
+        if (tasks == NULL) {
+            import->result = TRACE_ERR_MEMORY;
+            return NULL;
+        }
+        struct TraceTask *old = import->tasks;
+        uint32_t old_capacity = import->capacity;
+        import->tasks = tasks;
+        import->capacity = capacity;
+        for (uint32_t i = 0; i < old_capacity; i++) {
+            if (old[i].pid != 0) {
+                *_traceSlot(import, old[i].pid) = old[i];
+            }
+        }
+        free(old);
+    }
+
+    struct TraceTask *task = _traceSlot(import, pid);
+    if (task->pid == 0) {
+        task->pid = pid;
+        task->priority = 0;
+        task->runnable = false;
+        task->running = false;
+        task->arrival = -1;
+        task->runtime = 0;
+        import->count++;
+        if (import->count > import->stats.max_tasks) {
+            import->stats.max_tasks = import->count;
+        }
+    }
+    return task;
+}
+
+/**
+ * Removes a task, shifting back the tasks after it in its probe run so no tombstones are needed.
+ */
+static void _traceForget(struct TraceImport *import, struct TraceTask *task) {
+    uint32_t mask = import->capacity - 1;
+    uint32_t hole = (uint32_t)(task - import->tasks);
+    uint32_t index = hole;
+    for (;;) {
+        index = (index + 1) & mask;
+        if (import->tasks[index].pid == 0) {
+            break;
+        }
+        uint32_t home = _traceHash(import->tasks[index].pid, import->capacity);
+        if (((index - home) & mask) >= ((index - hole) & mask)) {
+            import->tasks[hole] = import->tasks[index];
+            hole = index;
+        }
+    }
+    import->tasks[hole].pid = 0;
+    import->count--;
+}
+
+/**
+ * Passes a task's burst (or all its CPU time in per-task mode) to the callback, if it ran at all.
+ */
+static void _traceEmit(struct TraceImport *import, const struct TraceTask *task) {
+    if (task->runtime <= 0 || task->arrival < 0 || import->result != TRACE_OK) {
+        return;
+    }
+    long long arrival = (task->arrival > import->first_time) ? task->arrival - import->first_time : 0;
+    arrival = 1 + arrival / import->unit_ns;
+    long long burst = (task->runtime + import->unit_ns - 1) / import->unit_ns;
+    if (arrival > INT_MAX || burst > INT_MAX) {
+        import->result = TRACE_ERR_TIME;
+        return;
+    }
+
+    struct TraceJob job = { task->pid, task->priority, (int)arrival, (int)burst };
+    import->stats.jobs++;
+    if (!import->job(&job, import->context)) {
+        import->result = TRACE_ERR_STOPPED;
+    }
+}
+
+/**
+ * A task became runnable (woken up, or switched in without a wakeup being seen): a new burst begins.
+ */
+static void _traceArrive(struct TraceImport *import, struct TraceTask *task, long long time) {
+    if (task->runnable) {
+        return;
+    }
+    task->runnable = true;
+    if (!import->options->per_task || task->arrival < 0) {
+        task->arrival = time;
+    }
+}
+
+static void _traceWakeup(struct TraceImport *import, long long time, int pid, int priority) {
+    if (pid == 0) {
+        return;
+    }
+    struct TraceTask *task = _traceTask(import, pid);
+    if (task != NULL) {
+        task->priority = priority;
+        _traceArrive(import, task, time);
+    }
+}
+
+static void _traceSwitch(struct TraceImport *import, long long time, int prev_pid, int prev_priority,
+                         bool prev_runnable, int next_pid, int next_priority) {
+    if (prev_pid != 0) {
+        struct TraceTask *task = _traceTask(import, prev_pid);
+        if (task == NULL) {
+            return;
+        }
+        task->priority = prev_priority;
+        if (task->running) {
+            task->runtime += time - task->running_since;
+            task->running = false;
+        }
+        else if (!task->runnable) {
+            // Running since before the trace started: that part of the burst is unknown.
+            import->stats.partial++;
+        }
+
+        if (prev_runnable) {
+            _traceArrive(import, task, time);
+        }
+        else if (import->options->per_task) {
+            task->runnable = false;
+        }
+        else {
+            _traceEmit(import, task);
+            _traceForget(import, task);
+        }
+    }
+
+    if (next_pid != 0) {
+        struct TraceTask *task = _traceTask(import, next_pid);
+        if (task == NULL) {
+            return;
+        }
+        task->priority = next_priority;
+        _traceArrive(import, task, time);
+        task->running = true;
+        task->running_since = time;
+    }
+}
+
+/**
+ * @return const char* First occurrence of a string in [start, end), NULL if there is none.
+ */
+static const char *_traceSearch(const char *start, const char *end, const char *str, size_t length) {
+    while ((size_t)(end - start) >= length) {
+        const char *found = memchr(start, str[0], end - start - length + 1);
+        if (found == NULL) {
+            return NULL;
+        }
+        if (memcmp(found, str, length) == 0) {
+            return found;
+        }
+        start = found + 1;
+    }
+    return NULL;
+}
+
+/**
+ * Finds the next "key=value" field (the key includes the '='), searching from the cursor,
+ * and moves the cursor to its value.
+ *
+ * @return bool False if there is no such field.
+ */
+static bool _traceField(const char **cursor, const char *start, const char *end, const char *key) {
+    size_t length = strlen(key);
+    for (const char *found = _traceSearch(*cursor, end, key, length); found != NULL;
+         found = _traceSearch(found + 1, end, key, length)) {
+        if (found == start || found[-1] == ' ') {
+            *cursor = found + length;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Parses a decimal integer.
+ *
+ * @return bool False if there are no digits.
+ */
+static bool _traceInt(const char *cursor, const char *end, int *out) {
+    bool negative = (cursor < end && *cursor == '-');
+    cursor += negative;
+    long long value = 0;
+    const char *digits = cursor;
+    while (cursor < end && *cursor >= '0' && *cursor <= '9' && value <= INT_MAX) {
+        value = value * 10 + (*cursor++ - '0');
+    }
+    if (cursor == digits || value > INT_MAX) {
+        return false;
+    }
+    *out = (int)(negative ? -value : value);
+    return true;
+}
+
+/**
+ * Parses the "comm:pid [prio]" of the compact format, which ends at end. The command name may contain
+ * spaces and colons, so the line is read from the right.
+ *
+ * @return bool False if it is not in that form.
+ */
+static bool _traceCompactTask(const char *start, const char *end, int *pid, int *priority) {
+    const char *bracket = end;
+    while (bracket > start && *(bracket - 1) != '[') {
+        bracket--;
+    }
+    if (bracket == start || !_traceInt(bracket, end, priority)) {
+        return false;
+    }
+    const char *digits = bracket - 2;   // Before " [".
+    while (digits > start && *(digits - 1) >= '0' && *(digits - 1) <= '9') {
+        digits--;
+    }
+    return digits > start && *(digits - 1) == ':' && _traceInt(digits, end, pid);
+}
+
+/**
+ * Parses one trace line and applies its event, if it is a scheduler event.
+ */
+static void _traceLine(struct TraceImport *import, const char *line, const char *end) {
+    // The event name follows the timestamp: "<ts>: sched_switch:" (ftrace) or "<ts>: sched:sched_switch:" (perf).
+    const char *colon = line;
+    for (;;) {
+        colon = memchr(colon, ':', end - colon);
+        if (colon == NULL) {
+            return;
+        }
+        if (end - colon >= 7 && memcmp(colon, ": sched", 7) == 0) {
+            break;
+        }
+        colon++;
+    }
+    const char *event = colon + 7;
+    if (end - event >= 6 && memcmp(event, ":sched", 6) == 0) {
+        event += 6;
+    }
+
+    bool is_switch;
+    const char *payload;
+    if (end - event >= 9 && memcmp(event, "_switch: ", 9) == 0) {
+        is_switch = true;
+        payload = event + 9;
+    }
+    else if (end - event >= 9 && memcmp(event, "_wakeup: ", 9) == 0) {
+        is_switch = false;
+        payload = event + 9;
+    }
+    else if (end - event >= 13 && memcmp(event, "_wakeup_new: ", 13) == 0) {
+        is_switch = false;
+        payload = event + 13;
+    }
+    else {
+        return;
+    }
+
+    // Timestamp in seconds with up to nine decimals, read back from the colon.
+    const char *stamp = colon;
+    while (stamp > line && ((*(stamp - 1) >= '0' && *(stamp - 1) <= '9') || *(stamp - 1) == '.')) {
+        stamp--;
+    }
+    long long seconds = 0;
+    long long fraction = 0;
+    int decimals = -1;
+    for (const char *c = stamp; c < colon; c++) {
+        if (*c == '.') {
+            decimals = 0;
+        }
+        else if (decimals < 0) {
+            seconds = seconds * 10 + (*c - '0');
+        }
+        else if (decimals < 9) {
+            fraction = fraction * 10 + (*c - '0');
+            decimals++;
+        }
+    }
+    if (stamp == colon || seconds > LLONG_MAX / 1000000000LL - 1) {
+        return;
+    }
+    for (decimals = (decimals < 0) ? 0 : decimals; decimals < 9; decimals++) {
+        fraction *= 10;
+    }
+    long long time = seconds * 1000000000LL + fraction;
+
+    bool parsed;
+    if (is_switch) {
+        int prev_pid, prev_priority, next_pid, next_priority;
+        bool prev_runnable;
+        if (end - payload >= 10 && memcmp(payload, "prev_comm=", 10) == 0) {
+            // The kernel always prints the fields in this order.
+            const char *cursor = payload;
+            const char *state = NULL;
+            parsed = _traceField(&cursor, payload, end, "prev_pid=") && _traceInt(cursor, end, &prev_pid) &&
+                     _traceField(&cursor, payload, end, "prev_prio=") && _traceInt(cursor, end, &prev_priority) &&
+                     _traceField(&cursor, payload, end, "prev_state=") && (state = cursor) < end &&
+                     _traceField(&cursor, payload, end, "next_pid=") && _traceInt(cursor, end, &next_pid) &&
+                     _traceField(&cursor, payload, end, "next_prio=") && _traceInt(cursor, end, &next_priority);
+            prev_runnable = parsed && *state == 'R';
+        }
+        else {
+            // "comm:pid [prio] state ==> comm:pid [prio]"
+            const char *arrow = _traceSearch(payload, end, " ==> ", 5);
+            const char *state = (arrow != NULL) ? arrow : payload;
+            while (state > payload && *(state - 1) != ' ') {
+                state--;
+            }
+            parsed = arrow != NULL && state > payload &&
+                     _traceCompactTask(payload, state - 1, &prev_pid, &prev_priority) &&
+                     _traceCompactTask(arrow + 5, end, &next_pid, &next_priority);
+            prev_runnable = parsed && *state == 'R';
+        }
+        if (parsed) {
+            _traceSwitch(import, time, prev_pid, prev_priority, prev_runnable, next_pid, next_priority);
+        }
+    }
+    else {
+        int pid, priority;
+        if (end - payload >= 5 && memcmp(payload, "comm=", 5) == 0) {
+            const char *cursor = payload;
+            parsed = _traceField(&cursor, payload, end, "pid=") && _traceInt(cursor, end, &pid) &&
+                     _traceField(&cursor, payload, end, "prio=") && _traceInt(cursor, end, &priority);
+        }
+        else {
+            // "comm:pid [prio] CPU:001" (possibly with "success=1" before the CPU)
+            const char *bracket_end = end;
+            while (bracket_end > payload && *(bracket_end - 1) != ']') {
+                bracket_end--;
+            }
+            parsed = bracket_end > payload && _traceCompactTask(payload, bracket_end - 1, &pid, &priority);
+        }
+        if (parsed) {
+            _traceWakeup(import, time, pid, priority);
+        }
+    }
+
+    if (parsed) {
+        if (import->first_time < 0) {
+            import->first_time = time;
+        }
+        import->last_time = time;
+        import->stats.events++;
+    }
+}
+
+enum TraceResult trace_import(FILE *input, const struct TraceOptions *options,
+                              bool (*job)(const struct TraceJob *job, void *context), void *context,
+                              struct TraceStats *stats) {
+    struct timespec start, finish;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    struct TraceImport import;
+    memset(&import, 0, sizeof(import));
+    import.options = options;
+    import.job = job;
+    import.context = context;
+    import.unit_ns = (options->unit_us > 0) ? options->unit_us * 1000LL : 1000;
+    import.first_time = -1;
+    import.result = TRACE_OK;
+
+    size_t length = 0;      // Bytes of the current block still to be processed.
+    bool eof = false;
+    while (!eof && import.result == TRACE_OK) {
+        size_t num_read = fread(input_buffer + length, 1, TRACE_BLOCK_SIZE - length, input);
+        eof = (num_read == 0);
+        length += num_read;
+        import.stats.bytes += num_read;
+
+        // Every complete line, plus the unterminated last line at end of input.
+        char *cursor = input_buffer;
+        char *end = input_buffer + length;
+        while (cursor < end && import.result == TRACE_OK) {
+            char *newline = memchr(cursor, '\n', end - cursor);
+            if (newline == NULL) {
+                if (!eof) {
+                    break;
+                }
+                newline = end;
+            }
+            import.stats.lines++;
+            _traceLine(&import, cursor, (newline > cursor && *(newline - 1) == '\r') ? newline - 1 : newline);
+            cursor = (newline < end) ? newline + 1 : end;
+        }
+
+        // Keep the partial line for the next block, drop it if it fills the whole buffer.
+        length = end - cursor;
+        if (length == TRACE_BLOCK_SIZE) {
+            import.stats.lines++;
+            length = 0;
+        }
+        memmove(input_buffer, cursor, length);
+    }
+    if (ferror(input) && import.result == TRACE_OK) {
+        import.result = TRACE_ERR_READ;
+    }
+
+    // Bursts still open when the trace ends, up to the last event.
+    for (uint32_t i = 0; i < import.capacity && import.result == TRACE_OK; i++) {
+        struct TraceTask *task = &import.tasks[i];
+        if (task->pid != 0 && task->running) {
+            task->runtime += import.last_time - task->running_since;
+            task->running = false;
+        }
+        if (task->pid != 0) {
+            _traceEmit(&import, task);
+        }
+    }
+    free(import.tasks);
+
+    clock_gettime(CLOCK_MONOTONIC, &finish);
+    import.stats.seconds = (finish.tv_sec - start.tv_sec) + (finish.tv_nsec - start.tv_nsec) / 1e9;
+    if (stats != NULL) {
+        *stats = import.stats;
+    }
+    return import.result;
+}
+
+const char *trace_error(enum TraceResult result) {
+    switch (result) {
+        case TRACE_OK:          return "ok";
+        case TRACE_ERR_READ:    return "could not read the trace";
+        case TRACE_ERR_MEMORY:  return "not enough memory";
+        case TRACE_ERR_TIME:    return "trace too long for the time unit";
+        case TRACE_ERR_STOPPED: return "import stopped";
+        default:                return "unknown error";
+    }
+}
@@ -0,0 +1,84 @@
+/**
+ * Scheduler trace importer header file.
+ * Turns the text output of Linux scheduler tracing (ftrace's trace / trace_pipe, "perf sched script",
+ * or "trace-cmd report") into processes for the scheduling algorithms (see schedule.h), so what a real
+ * host ran can be replayed under each policy. Only sched_switch, sched_wakeup, and sched_wakeup_new
+ * events are used; every other line is skipped. Both the "key=value" event format and the compact
+ * "comm:pid [prio] state ==> comm:pid [prio]" format are understood.
+ *
+ * The trace is read once, in large blocks, and parsed in place without scanf. Memory is bounded by
+ * the tasks that are runnable at the same time (by the tasks in the trace in per-task mode), not by
+ * the length of the trace.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define TRACE_BLOCK_SIZE (1 << 20)      // Input block size, also the longest accepted line.
+#define TRACE_DEFAULT_UNIT_US 1         // Microseconds per simulated time unit.
+
+enum TraceResult {
+    TRACE_OK = 0,
+    TRACE_ERR_READ,         // The input could not be read.
+    TRACE_ERR_MEMORY,       // The task table could not grow.
+    TRACE_ERR_TIME,         // A time does not fit in an int with this time unit.
+    TRACE_ERR_STOPPED       // The job callback asked to stop.
+};
+
+struct TraceOptions {
+    bool per_task;          // One job per task (all its CPU time), instead of one job per CPU burst.
+    int unit_us;            // Microseconds per simulated time unit (> 0).
+};
+
+/**
+ * One imported job. Times are in simulated time units, counted from the first event in the trace.
+ */
+struct TraceJob {
+    int pid;                // Task (thread) ID in the trace.
+    int priority;           // Kernel priority of the task (lower value == higher priority, 120 == nice 0).
+    int arrival_time;       // When the task woke up (>= 1, so the process manager accepts it).
+    int burst_time;         // CPU time it ran before going to sleep or exiting (>= 1, rounded up).
+};
+
+struct TraceStats {
+    uint64_t bytes;
+    uint64_t lines;
+    uint64_t events;        // sched_switch and sched_wakeup events used.
+    uint64_t jobs;          // Jobs passed to the callback.
+    uint64_t partial;       // Bursts left out because they started before the trace did.
+    uint32_t max_tasks;     // Most tasks tracked at once.
+    double seconds;         // Import time.
+};
+
+/**
+ * Imports a scheduler trace in one pass. In the default mode every CPU burst of a task becomes a job:
+ * it arrives when the task wakes up (or is first switched in), accumulates the CPU time of every slice
+ * until the task is switched out in a state other than Running (it slept, blocked, or exited), and is
+ * passed to the callback then. Tasks preempted while still runnable keep their burst open. Bursts
+ * still open at the end of the trace are passed to the callback last.
+ *
+ * @param input Trace text.
+ * @param options Job mode and time unit.
+ * @param job Called with every job, returns false to stop the import.
+ * @param context Passed to job.
+ * @param stats Receives the import statistics, may be NULL.
+ * @return enum TraceResult TRACE_OK, or why the import stopped.
+ */
+enum TraceResult trace_import(FILE *input, const struct TraceOptions *options,
+                              bool (*job)(const struct TraceJob *job, void *context), void *context,
+                              struct TraceStats *stats);
+
+/**
+ * @return const char* Message for a result.
+ */
+const char *trace_error(enum TraceResult result);
+
+#endif // TRACE_H
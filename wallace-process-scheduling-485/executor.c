@@ -0,0 +1,408 @@
+/**
+ * Threaded executor implementation file.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#include "executor.h"
+#include <stdio.h>
+
+#ifdef _WIN32
+
+bool runExecutor(const struct ExecJob *jobs, int num_jobs, enum ExecPolicy policy, int quantum,
+                 int num_workers, long unit_us, struct ExecResult *results) {
+    fprintf(stderr, "executor: not supported on Windows\n");
+    return false;
+}
+
+#else
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define EXEC_IDLE_NS 20000L     // Longest an idle worker sleeps before looking for work again.
+
+/**
+ * Chase-Lev work-stealing deque of job indexes, owned by one worker. Only the owner pushes (at the
+ * bottom); anyone, the owner included, takes from the top with a compare-and-swap. The owner taking
+ * from the top as well keeps its own jobs in round-robin (first in, first out) order.
+ */
+struct ExecDeque {
+    atomic_llong top;
+    atomic_llong bottom;
+    atomic_int *buffer;     // Capacity is a power of two larger than the number of jobs, so it never fills.
+    long long mask;
+} __attribute__((aligned(64)));
+
+struct ExecWorker {
+    pthread_t tid;
+    int index;
+};
+
+/* Global Variables */
+static const struct ExecJob *exec_jobs;
+static int exec_num_jobs;
+static enum ExecPolicy exec_policy;
+static int exec_quantum;
+static int exec_num_workers;
+static long long unit_ns;
+static long long start_ns;          // When the run started, arrival times count from here.
+
+static int *arrival_order;          // Job indexes sorted by arrival time.
+static atomic_int next_arrival;     // Next job in arrival_order to release.
+static atomic_int completed;
+static int *remaining;              // Units of work left per job, only touched by the worker running it.
+static long long *first_run_ns;
+static long long *finish_ns;
+static int *finish_worker;
+
+static pthread_mutex_t ready_lock = PTHREAD_MUTEX_INITIALIZER;
+static int *ready_heap;             // Ready jobs for FCFS, SJF, and PRI, best first.
+static int ready_size;
+static struct ExecDeque *deques;    // One per worker, for RR.
+static pthread_cond_t start_signal = PTHREAD_COND_INITIALIZER;
+static bool started;                // Set (under ready_lock) once every worker exists and the clock has started.
+
+/**
+ * Nanoseconds on the monotonic clock.
+ */
+static long long _execNow() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+/**
+ * Spins until the calling thread has used the given amount of CPU time.
+ */
+static void _execSpin(long long ns) {
+    struct timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    long long end = now.tv_sec * 1000000000LL + now.tv_nsec + ns;
+    do {
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    } while (now.tv_sec * 1000000000LL + now.tv_nsec < end);
+}
+
+/**
+ * Sleeps until the next job arrives, or at most EXEC_IDLE_NS.
+ */
+static void _execIdle() {
+    long long wait = EXEC_IDLE_NS;
+    int next = atomic_load(&next_arrival);
+    if (next < exec_num_jobs) {
+        long long until = start_ns + exec_jobs[arrival_order[next]].arrival_time * unit_ns - _execNow();
+        if (until < wait) {
+            wait = (until > 0) ? until : 0;
+        }
+    }
+    struct timespec pause = { 0, wait };
+    nanosleep(&pause, NULL);
+}
+
+/**
+ * Claims the next job whose arrival time has passed, if any. Each job is claimed by exactly one worker.
+ *
+ * @return int Job index, or -1 if no job has arrived.
+ */
+static int _execClaim() {
+    int next = atomic_load(&next_arrival);
+    long long now = _execNow();
+    while (next < exec_num_jobs && start_ns + exec_jobs[arrival_order[next]].arrival_time * unit_ns <= now) {
+        if (atomic_compare_exchange_weak(&next_arrival, &next, next + 1)) {
+            return arrival_order[next];
+        }
+    }
+    return -1;
+}
+
+/**
+ * Comparison functions: true if job a should run before job b under the current policy.
+ * Ties go to the earlier arrival, then to the earlier position in the list.
+ */
+static bool _execBefore(int a, int b) {
+    const struct ExecJob *ja = &exec_jobs[a], *jb = &exec_jobs[b];
+    int ka = 0, kb = 0;
+    if (exec_policy == EXEC_SJF) {
+        ka = ja->burst_time;
+        kb = jb->burst_time;
+    }
+    else if (exec_policy == EXEC_PRI) {
+        ka = ja->priority;
+        kb = jb->priority;
+    }
+    if (ka != kb) {
+        return ka < kb;
+    }
+    if (ja->arrival_time != jb->arrival_time) {
+        return ja->arrival_time < jb->arrival_time;
+    }
+    return a < b;
+}
+
+/**
+ * Ready heap push and pop, called with ready_lock held.
+ */
+static void _execHeapPush(int job) {
+    int pos = ready_size++;
+    while (pos > 0 && _execBefore(job, ready_heap[(pos - 1) / 2])) {
+        ready_heap[pos] = ready_heap[(pos - 1) / 2];
+        pos = (pos - 1) / 2;
+    }
+    ready_heap[pos] = job;
+}
+
+static int _execHeapPop() {
+    int best = ready_heap[0];
+    int last = ready_heap[--ready_size];
+    int pos = 0;
+    while (true) {
+        int child = pos * 2 + 1;
+        if (child >= ready_size) {
+            break;
+        }
+        if (child + 1 < ready_size && _execBefore(ready_heap[child + 1], ready_heap[child])) {
+            child++;
+        }
+        if (!_execBefore(ready_heap[child], last)) {
+            break;
+        }
+        ready_heap[pos] = ready_heap[child];
+        pos = child;
+    }
+    ready_heap[pos] = last;
+    return best;
+}
+
+/**
+ * Owner only: adds a job at the bottom of its deque.
+ */
+static void _dequePush(struct ExecDeque *deque, int job) {
+    long long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    atomic_store_explicit(&deque->buffer[bottom & deque->mask], job, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+}
+
+/**
+ * Any thread: takes the job at the top (the oldest) of a deque.
+ *
+ * @return int Job index, or -1 if the deque was empty or another thread took the job first.
+ */
+static int _dequeSteal(struct ExecDeque *deque) {
+    long long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    if (top >= bottom) {
+        return -1;
+    }
+    int job = atomic_load_explicit(&deque->buffer[top & deque->mask], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed)) {
+        return -1;
+    }
+    return job;
+}
+
+/**
+ * Runs a job for a number of units and records when it first ran and when it finished.
+ *
+ * @return bool True if the job is finished.
+ */
+static bool _execRun(int job, int units, int worker) {
+    if (first_run_ns[job] < 0) {
+        first_run_ns[job] = _execNow();
+    }
+    _execSpin(units * unit_ns);
+    remaining[job] -= units;
+    if (remaining[job] > 0) {
+        return false;
+    }
+    finish_ns[job] = _execNow();
+    finish_worker[job] = worker;
+    atomic_fetch_add(&completed, 1);
+    return true;
+}
+
+/**
+ * Worker thread for FCFS, SJF, and PRI: takes the best arrived job from the ready heap and runs it to completion.
+ */
+static void _execOrderedWorker(int worker) {
+    while (atomic_load(&completed) < exec_num_jobs) {
+        int job = -1;
+        pthread_mutex_lock(&ready_lock);
+        for (int arrived = _execClaim(); arrived >= 0; arrived = _execClaim()) {
+            _execHeapPush(arrived);
+        }
+        if (ready_size > 0) {
+            job = _execHeapPop();
+        }
+        pthread_mutex_unlock(&ready_lock);
+
+        if (job < 0) {
+            _execIdle();
+            continue;
+        }
+        _execRun(job, remaining[job], worker);
+    }
+}
+
+/**
+ * Worker thread for RR: runs the oldest job in its own deque for one quantum and puts it back at the end,
+ * stealing from the other workers when its deque is empty.
+ */
+static void _execRoundRobinWorker(int worker) {
+    struct ExecDeque *own = &deques[worker];
+    while (atomic_load(&completed) < exec_num_jobs) {
+        for (int arrived = _execClaim(); arrived >= 0; arrived = _execClaim()) {
+            _dequePush(own, arrived);
+        }
+        int job = _dequeSteal(own);
+        for (int i = 1; job < 0 && i < exec_num_workers; i++) {
+            job = _dequeSteal(&deques[(worker + i) % exec_num_workers]);
+        }
+        if (job < 0) {
+            _execIdle();
+            continue;
+        }
+
+        int units = (remaining[job] < exec_quantum) ? remaining[job] : exec_quantum;
+        if (!_execRun(job, units, worker)) {
+            // Jobs that arrived during the slice go ahead of the preempted one, as in the simulator.
+            for (int arrived = _execClaim(); arrived >= 0; arrived = _execClaim()) {
+                _dequePush(own, arrived);
+            }
+            _dequePush(own, job);
+        }
+    }
+}
+
+void *execWorker(void *ptr) {
+    struct ExecWorker *worker = ptr;
+    pthread_mutex_lock(&ready_lock);
+    while (!started) {
+        pthread_cond_wait(&start_signal, &ready_lock);
+    }
+    pthread_mutex_unlock(&ready_lock);
+    if (exec_policy == EXEC_RR) {
+        _execRoundRobinWorker(worker->index);
+    }
+    else {
+        _execOrderedWorker(worker->index);
+    }
+    return NULL;
+}
+
+/**
+ * Comparison function used by quicksort to order jobs by arrival time (then by position).
+ */
+static int _execCompareArrival(const void *p1, const void *p2) {
+    int a = *(const int *)p1, b = *(const int *)p2;
+    if (exec_jobs[a].arrival_time != exec_jobs[b].arrival_time) {
+        return exec_jobs[a].arrival_time - exec_jobs[b].arrival_time;
+    }
+    return a - b;
+}
+
+bool runExecutor(const struct ExecJob *jobs, int num_jobs, enum ExecPolicy policy, int quantum,
+                 int num_workers, long unit_us, struct ExecResult *results) {
+    if (num_jobs <= 0) {
+        return true;
+    }
+    if (num_workers < 1) {
+        num_workers = 1;
+    }
+    if (num_workers > EXEC_MAX_WORKERS) {
+        num_workers = EXEC_MAX_WORKERS;
+    }
+    exec_jobs = jobs;
+    exec_num_jobs = num_jobs;
+    exec_policy = policy;
+    exec_quantum = (quantum > 0) ? quantum : 1;
+    exec_num_workers = num_workers;
+    unit_ns = unit_us * 1000LL;
+
+    long long capacity = 1;
+    while (capacity <= num_jobs) {
+        capacity <<= 1;
+    }
+    arrival_order = malloc(num_jobs * sizeof(int));
+    remaining = malloc(num_jobs * sizeof(int));
+    first_run_ns = malloc(num_jobs * sizeof(long long));
+    finish_ns = malloc(num_jobs * sizeof(long long));
+    finish_worker = malloc(num_jobs * sizeof(int));
+    ready_heap = malloc(num_jobs * sizeof(int));
+    deques = aligned_alloc(64, num_workers * sizeof(struct ExecDeque));
+    atomic_int *buffers = calloc(num_workers * capacity, sizeof(atomic_int));
+    struct ExecWorker *workers = calloc(num_workers, sizeof(struct ExecWorker));
+    bool ok = arrival_order != NULL && remaining != NULL && first_run_ns != NULL && finish_ns != NULL &&
+              finish_worker != NULL && ready_heap != NULL && deques != NULL && buffers != NULL && workers != NULL;
+
+    if (ok) {
+        for (int i = 0; i < num_jobs; i++) {
+            arrival_order[i] = i;
+            remaining[i] = (jobs[i].burst_time > 0) ? jobs[i].burst_time : 0;
+            first_run_ns[i] = -1;
+        }
+        qsort(arrival_order, num_jobs, sizeof(int), _execCompareArrival);
+        for (int i = 0; i < num_workers; i++) {
+            atomic_init(&deques[i].top, 0);
+            atomic_init(&deques[i].bottom, 0);
+            deques[i].buffer = buffers + i * capacity;
+            deques[i].mask = capacity - 1;
+        }
+        ready_size = 0;
+        atomic_store(&next_arrival, 0);
+        atomic_store(&completed, 0);
+
+        // Every worker waits for the start signal, so all of them exist when the clock starts.
+        started = false;
+        int num_started = 0;
+        for (; num_started < num_workers; num_started++) {
+            workers[num_started].index = num_started;
+            if (pthread_create(&workers[num_started].tid, NULL, execWorker, &workers[num_started]) != 0) {
+                break;
+            }
+        }
+        if (num_started < num_workers) {
+            // Let the workers that did start finish with nothing to do.
+            atomic_store(&completed, num_jobs);
+            ok = false;
+            fprintf(stderr, "executor: could not start worker threads\n");
+        }
+        pthread_mutex_lock(&ready_lock);
+        start_ns = _execNow();
+        started = true;
+        pthread_cond_broadcast(&start_signal);
+        pthread_mutex_unlock(&ready_lock);
+        for (int i = 0; i < num_started; i++) {
+            pthread_join(workers[i].tid, NULL);
+        }
+    }
+
+    for (int i = 0; ok && i < num_jobs; i++) {
+        double arrival = jobs[i].arrival_time;
+        results[i].id = jobs[i].id;
+        results[i].worker = finish_worker[i];
+        results[i].start_time = (double)(first_run_ns[i] - start_ns) / unit_ns;
+        results[i].finish_time = (double)(finish_ns[i] - start_ns) / unit_ns;
+        results[i].turnaround_time = results[i].finish_time - arrival;
+        results[i].waiting_time = results[i].turnaround_time - ((jobs[i].burst_time > 0) ? jobs[i].burst_time : 0);
+    }
+
+    free(arrival_order);
+    free(remaining);
+    free(first_run_ns);
+    free(finish_ns);
+    free(finish_worker);
+    free(ready_heap);
+    free(deques);
+    free(buffers);
+    free(workers);
+    return ok;
+}
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * Threaded executor header file.
+ * Runs processes as real CPU-bound jobs on a pool of worker threads, in the order a scheduling
+ * policy picks, and measures their wall-clock wait and turnaround, so the simulator's numbers
+ * can be checked against what the hardware actually does.
+ *
+ * @author  J. Kenneth Wallace
+ * @version 0.1
+ * @since   2026-10-19
+ */
+
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include <stdbool.h>
+
+#define EXEC_DEFAULT_UNIT_US 2000   // Wall-clock length of one simulated time unit.
+#define EXEC_MAX_WORKERS 64
+
+enum ExecPolicy {
+    EXEC_FCFS,      // Earliest arrival first, runs to completion.
+    EXEC_SJF,       // Shortest burst first among arrived jobs, runs to completion.
+    EXEC_RR,        // Round robin with a quantum, per-worker work-stealing deques.
+    EXEC_PRI        // Lowest priority value first among arrived jobs, runs to completion.
+};
+
+/**
+ * One job, with times in simulated time units.
+ */
+struct ExecJob {
+    int id;
+    int priority;
+    int arrival_time;
+    int burst_time;     // Units of CPU time the job spins for.
+};
+
+/**
+ * Measured times of one job, converted back to simulated time units.
+ */
+struct ExecResult {
+    int id;
+    int worker;             // Worker that finished the job.
+    double start_time;      // First time the job ran, since the executor started.
+    double finish_time;
+    double turnaround_time; // Finish minus arrival.
+    double waiting_time;    // Turnaround minus burst.
+};
+
+/**
+ * Runs the jobs and waits for all of them to finish.
+ * Each job is released at its arrival time and, once dispatched, spins for burst_time units of its
+ * worker's CPU time (time the thread spends descheduled by the OS does not count as work).
+ * FCFS, SJF, and PRI dispatch from one shared ready queue in policy order, each job running to
+ * completion. RR gives every worker its own work-stealing deque: a worker runs the oldest job in its
+ * deque for one quantum and puts it back at the end, and an idle worker steals the oldest job from
+ * another worker's deque.
+ *
+ * @param jobs Jobs to run.
+ * @param num_jobs Number of jobs.
+ * @param policy Dispatch policy.
+ * @param quantum Round-robin time slice in units, ignored by the other policies.
+ * @param num_workers Worker threads (1 matches the single CPU the simulator models).
+ * @param unit_us Microseconds per time unit.
+ * @param results One result per job, in the same order as jobs.
+ * @return bool False if the workers could not be started.
+ */
+bool runExecutor(const struct ExecJob *jobs, int num_jobs, enum ExecPolicy policy, int quantum,
+                 int num_workers, long unit_us, struct ExecResult *results);
+
+#endif // EXECUTOR_H
@@ -7,136 +7,306 @@
  */
 
 #include "cosmetic.h"
+#include "dashboard.h"
+#include "executor.h"
+#include "output.h"
+#include "process_table.h"
+#include "schedule.h"
+#include "snapshot.h"
+#include "timeline.h"
+#include "trace.h"
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
-#include <windows.h>
 #include <stdbool.h>
-#define SIZE 100    // Default process list size.
+#include <string.h>
+#include <time.h>
 
-typedef struct {
-    int id;
-    int state;
-    int priority;
-
-    int arrival_time;
-    int burst_time;         // Amount of time needed to complete.
-    int finish_time;
-    int turnaround_time;    // Time from arrival to finish.
-    int waiting_time;       // Time not being worked on.
-
-    int work_done;          // Round-robin exclusive. Holds the amount of work that has been done.
-} Process;
+#define PSA_MAX_SECTIONS 64     // Critical sections that can be set for preemptive priority.
+#define PSA_MAX_LOCKS 16        // Lock names they can use.
+#define PSA_LOCK_NAME_SIZE 16
 
 /* Global Variables */
-Process process_list[SIZE];     // Process list that holds all processes.
-int num_processes = 0;          // Number of processes, used for process list indexing.
+struct ProcessTable process_table;  // Process table shared with the process manager (see process_table.h).
+                                    // Arrival time is the start time, burst time is the work time.
 int round_robin_quanta = 2;     // Amount of time allotted to each process 
                                 // in the round-robin scheduling algorithm.
+int adaptive_percentile = SCHEDULE_DEFAULT_PERCENTILE;   // Share of the recent bursts, in percent, that fit in one
+                                                        // time quanta in adaptive round-robin.
+double prediction_alpha = SCHEDULE_DEFAULT_ALPHA;   // Weight of a task's last burst in its next estimate
+                                                    // in the predictive shortest job first algorithms.
+int lock_protocol = SCHED_LOCK_NONE;    // How preemptive priority raises the priority of a process holding a lock.
+struct ScheduleSection critical_sections[PSA_MAX_SECTIONS] = {
+    // Process ID, lock (index into lock_names), work done before taking it, work done holding it.
+    { 10, 0, 3, 3 },
+    { 50, 0, 6, 2 }
+};
+int num_critical_sections = 2;
+char lock_names[PSA_MAX_LOCKS][PSA_LOCK_NAME_SIZE] = { "DISK" };
 float last_avg_wait = -1;       // Last algorithm's average wait time result.
 float last_avg_turn = -1;       // Last algorithm's average turnaround result.
+struct Timeline timeline;       // Execution timeline of the last algorithm run (see timeline.h).
+const char *timeline_name = NULL;   // Name of the last algorithm run, NULL if none has run.
 
 
-//TODO: 
-// 1. Add options for quanta in menu
-// 2. Add options for scheduling algorithms (replace scheduling option)
-
 /**
- * Initializes the process_list with hard-coded processes.
+ * Initializes the process table with hard-coded processes.
  */
 void init_process_list();
 
 /**
- * Prints out a user interface with six options:
- * 1. View processes, 2. FCFS algorithm, 3. SJF algorithm, 4. RRS algorithm, 5. PRI algorithm, 6. Exit program
+ * Initializes the process table with the jobs of a Linux scheduler trace (see trace.h).
+ * In per-task mode the process ID is the task's PID, otherwise jobs are numbered from 1.
+ * @param path Trace file, "-" for stdin.
+ * @param options Job mode and time unit.
+ * @return bool False if the trace could not be read or the table filled up.
+ */
+bool init_process_trace(const char *path, const struct TraceOptions *options);
+
+/**
+ * Trace job callback for init_process_trace.
+ */
+bool _traceJob(const struct TraceJob *job, void *context);
+
+/**
+ * Prints out a user interface with ten options:
+ * 0. View processes, 1. FCFS algorithm, 2. SJF algorithm, 3. RRS algorithm, 4. PRI algorithm,
+ * 5. Toggle typewriter effect, 6. Execute an algorithm on worker threads, 7. Query the timeline,
+ * 8. Compare algorithms, 9. Exit program
  */
 void userInterface();
 
 /**
- * Shows current process list.
- * For this program, the processes are hard-coded.
+ * Shows the process table in arrival order, with the results of the last algorithm run.
+ * The processes are hard-coded unless a snapshot or a trace was loaded.
  */
 void viewProcesses();
 
 /**
- * Comparison functions used by quicksort to re-order the process list.
- * @param p1 Process 1.
- * @param p2 Process 2.
- * @return int The difference in value (arrival time, burst time, or priority) between the two processes.
+ * Publishes the simulation state to the live dashboard, if it is running: the clock, how many processes
+ * have not arrived yet, are ready, or are done, and which process is on the CPU.
+ * @param event Current step of the algorithm.
+ * @param running_id ID of the process on the CPU, -1 if none.
+ */
+void _publishState(const struct ScheduleEvent *event, int running_id);
+
+/**
+ * Records a completed process on the live dashboard.
+ * @param process Process that just completed.
+ */
+void _publishComplete(const struct Process *process);
+
+/**
+ * Algorithm step hooks (see schedule.h): print each dispatch, preemption, and completion
+ * and publish it to the live dashboard. With a context, it holds the last time quanta printed,
+ * and each dispatch with a new time quanta prints it first.
+ */
+void _psaDispatch(const struct ScheduleEvent *event, void *context);
+void _psaPreempt(const struct ScheduleEvent *event, void *context);
+void _psaComplete(const struct ScheduleEvent *event, void *context);
+
+/**
+ * Shows the critical sections preemptive priority runs with, and lets the user keep them or enter new ones.
+ * The processes hold their locks for parts of their bursts, and the locks are named by the user.
+ * @return bool False if an entry was invalid (the sections are left as they were).
+ */
+bool _psaSections();
+
+/**
+ * Runs an algorithm over the process table in place (see schedule.h) and prints its statistics.
+ * Round-robin, lottery, and stride ask for the time quanta first, adaptive round-robin for the target
+ * percentile (starting from the last time quanta), the predictive algorithms for alpha, and preemptive
+ * priority for the locking protocol and the critical sections.
+ * @param policy Algorithm to run.
+ * @param name Name printed and shown on the dashboard.
+ * @return True if the algorithm ran, false if a setting was invalid or memory ran out.
+ */
+bool _psaRun(enum SchedulePolicy policy, const char *name);
+
+/**
+ * Runs one of the algorithms in the simulator, then runs the same processes as real CPU-bound jobs on
+ * worker threads under the same policy (see executor.h), and prints the simulated and measured
+ * wait and turnaround times side by side.
+ */
+void executeAlgorithm();
+
+/**
+ * Answers questions about the execution timeline of the last algorithm run, without running it again:
+ * which process was on the CPU at a time, the CPU utilization over a range, or every slice of a process.
+ */
+void queryTimeline();
+
+/**
+ * Runs the chosen algorithms (round-robin with one or more time quanta) over the process table side by side
+ * and prints their statistics in one table. The processes are loaded and sorted once for all of them, the
+ * algorithms run concurrently, and the table and the last algorithm's results are left alone (see schedule_compare).
+ * Can instead run them over generated workloads, replicated until the averages are known to a precision.
+ */
+void compareAlgorithms();
+
+/**
+ * Runs each chosen algorithm over the same generated workloads (see schedule_replicate) on every CPU, until its
+ * average wait and turnaround are known to the precision asked for at 95% confidence, and prints them with
+ * their confidence intervals in one table.
+ * @param selected Algorithms, in the order chosen.
+ * @param params Settings of each algorithm.
+ * @param names Name of each algorithm, as in the table.
+ * @param count Number of algorithms.
  */
-int _compare_arrival(const void *p1, const void *p2);
-int _compare_burst(const void *p1, const void *p2);
-int _compare_priority(const void *p1, const void *p2);
+void _compareReplicated(const enum SchedulePolicy *selected, const struct ScheduleParams *params,
+                        const char **names, int count);
 
 /**
- * Ordering function used to re-order the process list with the help of quick sort.
- * @param order_type Type of ordering to do; 0 == Arrival time, 1 == Burst time, 2 == Priority.
+ * Prints one slice of a process (see timeline_slices).
  */
-void _psa_order(int order_type);
+void _printSlice(long long start, long long length, void *context);
 
 /* Process Scheduling Algorithms */
 /**
  * First-Come First-Serve scheduling algorithm.
- * Order process_list by [arrival_time] and execute in order.
+ * Execute processes in order of [arrival_time].
  */
 void psa_FCFS();
 
 /**
  * Shortest Job First scheduling algorithm.
- * Order process_list by [burst_time]. Initialize a [current_time] to 0.
  * Pick the shortest available job from processes that are ready ([arrival_time] <= [current_time]).
  * Does not stop mid-execution.
+ * Asks whether the burst times are known in advance, or predicted from each task's earlier bursts
+ * (PSJF, or PSRTF which preempts when a job estimated to finish sooner arrives).
  */
 void psa_SJF();
 
 /**
  * Round-Robin scheduling algorithm.
- * Order process_list by [arrival_time] and execute in order.
- * Each process can only execute for X amount of time, where X is the time quantum.
+ * Execute ready processes in queue order, starting in order of [arrival_time].
+ * Each process can only execute for X amount of time, where X is the time quantum,
+ * then goes to the back of the queue behind any processes that arrived meanwhile.
+ * Asks whether the time quantum is fixed, or adapts to a percentile of the recently completed bursts.
  */
 void psa_RRS();
 
 /**
  * Priority scheduling algorithm.
- * Order process_list by [priority]. Initialize a [current_time] to 0.
  * Pick the highest priority from processes that are ready ([arrival_time] <= [current_time]).
  * Does not stop mid-execution.
  * Lower value == Higher priority.
+ * Can instead share the CPU in proportion to the priorities, taken as lottery or stride tickets
+ * (higher value == bigger share), one time quantum at a time, or preempt the running process whenever
+ * a higher priority arrives, with processes blocking on the locks of their critical sections.
  */
 void psa_PRI();
 
 /**
  * Main function that primarily calls userInterface.
+ * With "--dashboard", a live dashboard of the running algorithm is kept at the top of the terminal.
+ * All output is written by an output thread (see output.h), so the algorithms never wait on the terminal.
+ * With "--drop-output", output that does not fit in its buffer is dropped instead of waited for.
+ * With "--snapshot <file>", the algorithms run on a process table snapshot saved by the process manager
+ * instead of the hard-coded processes, and the results are saved back into it on exit.
+ * With "--trace <file>", the algorithms run on the CPU bursts of a Linux scheduler trace instead
+ * ("--trace-tasks" for one process per task, "--trace-unit-us n" for the length of a time unit).
  * 
  * @return int Successful run returns 0, otherwise returns 1.
  */
-int main() {
+int main(int argc, char *argv[]) {
+    bool show_dashboard = false;
+    enum OutputPolicy policy = OUTPUT_BLOCK;
+    char *snapshot_path = NULL;
+    char *trace_path = NULL;
+    struct TraceOptions trace_options = { false, TRACE_DEFAULT_UNIT_US };
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--dashboard") == 0) {
+            show_dashboard = true;
+        }
+        else if (strcmp(argv[i], "--drop-output") == 0) {
+            policy = OUTPUT_DROP;
+        }
+        else if (strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc) {
+            snapshot_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--trace-tasks") == 0) {
+            trace_options.per_task = true;
+        }
+        else if (strcmp(argv[i], "--trace-unit-us") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+            trace_options.unit_us = atoi(argv[++i]);
+        }
+        else {
+            fprintf(stderr, "Usage: %s [--dashboard] [--drop-output] [--snapshot file | --trace file [--trace-tasks] [--trace-unit-us n]]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // The snapshot is mapped straight into the table, the processes are never copied or re-parsed.
+    uint64_t journal_lsn = 0;
+    if (snapshot_path != NULL && trace_path != NULL) {
+        fprintf(stderr, "Usage: %s [--dashboard] [--drop-output] [--snapshot file | --trace file [--trace-tasks] [--trace-unit-us n]]\n", argv[0]);
+        return 1;
+    }
+    if (snapshot_path != NULL) {
+        if (!snapshot_load(&process_table, snapshot_path, &journal_lsn)) {
+            fprintf(stderr, "snapshot: could not load %s\n", snapshot_path);
+            return 1;
+        }
+    }
+    else if (trace_path != NULL) {
+        if (!init_process_trace(trace_path, &trace_options)) {
+            pt_destroy(&process_table);
+            return 1;
+        }
+    }
+    else {
+        init_process_list();
+    }
+    _renderInit();
     _clearTerminal();
-    init_process_list();
+
+    if (show_dashboard) {
+        dashboard_setup("PROCESS SCHEDULING SIMULATION", "TIME", "WAIT (TIME UNITS)", 1);
+        dashboard_add_queue("ARRIVING");
+        dashboard_add_queue("READY");
+        dashboard_add_queue("DONE");
+        dashboard_start(DASHBOARD_DEFAULT_FPS);
+    }
+    output_start(policy);
 
     char *intro_text_1    = "PROCESS SCHEDULING SIMULATION     ";
     char *intro_text_2    = "KENNETH WALLACE - CSCI 485        ";
     char *exit_text       = "EXITING PROGRAM ! ! !";
     
-    printf("\033[30m"); // black text
-    printf("\033[41m"); // red background
+    _textColor("\033[30m"); // black text
+    _textColor("\033[41m"); // red background
     _typewriterPrint(intro_text_1, 3);
     _typewriterPrint(intro_text_2, 2);
     
-    printf("\033[0m");  // normal text and background
+    _textColor("\033[0m");  // normal text and background
     _toggleDelay();
     userInterface();
 
-    printf("\033[32m"); // green text
+    _textColor("\033[32m"); // green text
     _typewriterPrint(exit_text, 2);
-    printf("\033[0m\n");  // default text
+    _textColor("\033[0m");  // default text
+    output_printf("\n");
+    dashboard_stop();
+    output_stop();
+
+    if (snapshot_path != NULL && (!snapshot_save(&process_table, snapshot_path, journal_lsn) || !snapshot_wait())) {
+        fprintf(stderr, "snapshot: could not save %s\n", snapshot_path);
+    }
+    timeline_destroy(&timeline);
+    pt_destroy(&process_table);
+    snapshot_unmap();
     return 0;
 }
 
 void userInterface() {
     int user_option = -1;
 
-    while (user_option != 6) {
+    while (user_option != 9) {
         char *option_menu = "PLEASE INPUT A COMMAND:";
         char *option_0    = "> [0] VIEW PROCESSES";
         char *option_1    = "> [1] FIRST-COME FIRST-SERVE ALGORITHM";
@@ -144,7 +314,10 @@ void userInterface() {
         char *option_3    = "> [3] ROUND-ROBIN SCHEDULING ALGORITHM";
         char *option_4    = "> [4] PRIORITY ALGORITHM";
         char *option_5    = "> [5] TOGGLE TYPEWRITER EFFECT";
-        char *option_6    = "> [6] EXIT PROGRAM";
+        char *option_6    = "> [6] EXECUTE ALGORITHM ON WORKER THREADS";
+        char *option_7    = "> [7] QUERY TIMELINE";
+        char *option_8    = "> [8] COMPARE ALGORITHMS";
+        char *option_9    = "> [9] EXIT PROGRAM";
         char *invalid     = "INVALID COMMAND ! ! !";
 
         _typewriterPrint(option_menu, 2);
@@ -155,375 +328,843 @@ void userInterface() {
         _typewriterPrint(option_4, 1);
         _typewriterPrint(option_5, 1);
         _typewriterPrint(option_6, 1);
-        printf("\n\n  User > ");
+        _typewriterPrint(option_7, 1);
+        _typewriterPrint(option_8, 1);
+        _typewriterPrint(option_9, 1);
+        output_printf("\n\n  User > ");
 
+        output_flush();
         scanf("%d", &user_option);
+        _skipLine();
 
-        _removeLines(11);
+        _removeLines(14);
         switch (user_option) {
             case 0:
-                printf("  User > [0] VIEW PROCESSES");
+                output_printf("  User > [0] VIEW PROCESSES");
                 viewProcesses();
                 break;
             case 1:
-                printf("  User > [1] FIRST-COME FIRST-SERVE ALGORITHM");
+                output_printf("  User > [1] FIRST-COME FIRST-SERVE ALGORITHM");
                 psa_FCFS();
                 break;
             case 2:
-                printf("  User > [2] SHORTEST JOB FIRST ALGORITHM");
+                output_printf("  User > [2] SHORTEST JOB FIRST ALGORITHM");
                 psa_SJF();
                 break;
             case 3:
-                printf("  User > [3] ROUND-ROBIN SCHEDULING ALGORITHM");
+                output_printf("  User > [3] ROUND-ROBIN SCHEDULING ALGORITHM");
                 psa_RRS();
                 break;
             case 4:
-                printf("  User > [4] PRIORITY ALGORITHM");
+                output_printf("  User > [4] PRIORITY ALGORITHM");
                 psa_PRI();
                 break;
             case 5:
-                printf("  User > [5] TOGGLE TYPEWRITER EFFECT");
+                output_printf("  User > [5] TOGGLE TYPEWRITER EFFECT");
                 _toggleDelay();
                 break;
             case 6:
-                printf("  User > [6] EXIT PROGRAM");
+                output_printf("  User > [6] EXECUTE ALGORITHM ON WORKER THREADS");
+                executeAlgorithm();
+                break;
+            case 7:
+                output_printf("  User > [7] QUERY TIMELINE");
+                queryTimeline();
+                break;
+            case 8:
+                output_printf("  User > [8] COMPARE ALGORITHMS");
+                compareAlgorithms();
+                break;
+            case 9:
+                output_printf("  User > [9] EXIT PROGRAM");
                 return;
             default:
-                printf("  User > [%d]", user_option);
-                printf("\033[31m"); // red text
+                output_printf("  User > [%d]", user_option);
+                _textColor("\033[31m"); // red text
                 _typewriterPrint(invalid, 2);
-                printf("\033[0m");  // default text
+                _textColor("\033[0m");  // default text
         }
     }
 }
 
 void init_process_list() {
-    int temp_num_processes = 0;
-
-    // Process 1
-    Process new_process;
-    new_process.id = 10;
-    new_process.priority = 2;
-    new_process.arrival_time = 0;
-    new_process.burst_time = 6;
-    process_list[temp_num_processes] = new_process;
-    temp_num_processes++;
-
-    // Process 2
-    Process new_process_2;
-    new_process_2.id = 20;
-    new_process_2.priority = 4;
-    new_process_2.arrival_time = 2;
-    new_process_2.burst_time = 20;
-    process_list[temp_num_processes] = new_process_2;
-    temp_num_processes++;
-
-    // Process 3
-    Process new_process_3;
-    new_process_3.id = 30;
-    new_process_3.priority = 6;
-    new_process_3.arrival_time = 8;
-    new_process_3.burst_time = 10;
-    process_list[temp_num_processes] = new_process_3;
-    temp_num_processes++;
-
-    // Process 4
-    Process new_process_4;
-    new_process_4.id = 40;
-    new_process_4.priority = 8;
-    new_process_4.arrival_time = 6;
-    new_process_4.burst_time = 4;
-    process_list[temp_num_processes] = new_process_4;
-    temp_num_processes++;
-
-    // Process 5
-    Process new_process_5;
-    new_process_5.id = 50;
-    new_process_5.priority = 0;
-    new_process_5.arrival_time = 4;
-    new_process_5.burst_time = 8;
-    process_list[temp_num_processes] = new_process_5;
-    temp_num_processes++;
-
-    // Process 6
-    Process new_process_6;
-    new_process_6.id = 60;
-    new_process_6.priority = 1;
-    new_process_6.arrival_time = 10;
-    new_process_6.burst_time = 13;
-    process_list[temp_num_processes] = new_process_6;
-    temp_num_processes++;
-
-    // Init
-    for (int i = 0; i < temp_num_processes; i++) {
-        Process * curr = &process_list[i];
-        curr->state = 0;
-        curr->finish_time = 0;
-        curr->turnaround_time = 0;
-        curr->waiting_time = 0;
-        curr->work_done = 0;
-    }
-    if (temp_num_processes != num_processes) {
-        num_processes = temp_num_processes;
+    // ID, state, priority, arrival time, burst time, then the results and the task (none).
+    struct Process processes[] = {
+        { 10, 0, 2, 0,  6,  0, 0, 0, 0 },
+        { 20, 0, 4, 2,  20, 0, 0, 0, 0 },
+        { 30, 0, 6, 8,  10, 0, 0, 0, 0 },
+        { 40, 0, 8, 6,  4,  0, 0, 0, 0 },
+        { 50, 0, 0, 4,  8,  0, 0, 0, 0 },
+        { 60, 0, 1, 10, 13, 0, 0, 0, 0 }
+    };
+
+    pt_init(&process_table);
+    for (size_t i = 0; i < sizeof(processes) / sizeof(processes[0]); i++) {
+        pt_insert(&process_table, &processes[i]);
     }
 }
 
+bool init_process_trace(const char *path, const struct TraceOptions *options) {
+    FILE *input = (strcmp(path, "-") == 0) ? stdin : fopen(path, "rb");
+    if (input == NULL) {
+        perror(path);
+        return false;
+    }
+    int next_id = options->per_task ? -1 : 1;   // -1: the PID is the ID.
+    struct TraceStats stats;
+    pt_init(&process_table);
+    enum TraceResult result = trace_import(input, options, _traceJob, &next_id, &stats);
+    if (input != stdin) {
+        fclose(input);
+    }
+
+    fprintf(stderr, "trace: %u processes from %llu events (%llu lines, %.1f MB) in %.3f s, %.0f MB/s\n",
+            process_table.count, (unsigned long long)stats.events, (unsigned long long)stats.lines,
+            stats.bytes / 1e6, stats.seconds, (stats.seconds > 0) ? stats.bytes / 1e6 / stats.seconds : 0.0);
+    if (result != TRACE_OK) {
+        fprintf(stderr, "trace: %s\n", (result == TRACE_ERR_STOPPED) ? "process table full" : trace_error(result));
+        return false;
+    }
+    return true;
+}
+
+bool _traceJob(const struct TraceJob *job, void *context) {
+    int *next_id = context;
+    struct Process process = { job->pid, 0, job->priority, job->arrival_time, job->burst_time, 0, 0, 0, 0 };
+    if (*next_id >= 0) {
+        // One process per burst, each estimated from the bursts of its task before it (see SCHED_PSJF).
+        process.id = (*next_id)++;
+        process.task = job->pid;
+    }
+    return pt_insert(&process_table, &process) != PT_NULL_HANDLE;
+}
+
 void viewProcesses() {
-    _psa_order(0);
-
-    /* If you are reading this, I was too lazy to create a separate function for printing borders. */
-    // Top Border
-    printf("\n\n");
-    printf("  ");
-    for (int i = 0; i < 76; i++) { printf("="); }
-    printf("\n");
-    printf("  | ----ID---- | STATE | PRIORITY | ARRIVAL | BURST | FINISH | TURN. | WAIT. |\n");
-    printf("  ");
-    for (int i = 0; i < 76; i++) { printf("="); }
-    printf("\n");
-
-    for (int i = 0; i < num_processes; i++) {
-        int p_id = process_list[i].id;
-        int p_state = process_list[i].state;
-        int p_priority = process_list[i].priority;
-        int p_arrive = process_list[i].arrival_time;
-        int p_burst = process_list[i].burst_time;
-        int p_finish = process_list[i].finish_time;
-        int p_turnaround = process_list[i].turnaround_time;
-        int p_wait = process_list[i].waiting_time;
-        printf("  | %-10d | %-5d | %-8d | %-7d | %-5d | %-6d | %-5d | %-5d |\n", p_id, p_state, p_priority, p_arrive, p_burst, p_finish, p_turnaround, p_wait);
+    uint32_t count = 0;
+    ProcessHandle *order = schedule_arrival_order(&process_table, &count);
+
+    // The whole table is composed into one frame and written at once.
+    char border[80];
+    memset(border, '=', 76);
+    border[76] = '\0';
+
+    _frameBegin();
+    _frameAppend("\n\n  %s\n", border);
+    _frameAppend("  | ----ID---- | STATE | PRIORITY | ARRIVAL | BURST | FINISH | TURN. | WAIT. |\n");
+    _frameAppend("  %s\n", border);
+
+    for (uint32_t i = 0; i < count; i++) {
+        const struct Process *process = pt_get(&process_table, order[i]);
+        int p_id = process->id;
+        int p_state = process->state;
+        int p_priority = process->priority;
+        int p_arrive = process->start_time;
+        int p_burst = process->work_time;
+        int p_finish = process->finish_time;
+        int p_turnaround = process->turnaround_time;
+        int p_wait = process->waiting_time;
+        if (!_frameRow("  | %-10d | %-5d | %-8d | %-7d | %-5d | %-6d | %-5d | %-5d |\n", p_id, p_state, p_priority, p_arrive, p_burst, p_finish, p_turnaround, p_wait)) {
+            break;
+        }
     }
+    free(order);
 
     // Bottom Border
-    printf("  ");
-    for (int i = 0; i < 76; i++) { printf("="); }
+    _frameAppend("  %s", border);
 
     if (last_avg_wait != -1 && last_avg_turn != -1) {
-        printf("\n");
-        for (int i = 0; i < 53; i++) { printf(" "); }
-        printf("AVERAGE:  %.3f  %.3f", last_avg_turn, last_avg_wait);
+        _frameAppend("\n%53sAVERAGE:  %.3f  %.3f", "", last_avg_turn, last_avg_wait);
     }
+    _frameEnd();
 }
 
-int _compare_arrival(const void *p1, const void *p2) {
-    const Process *process1 = (const Process *) p1;
-    const Process *process2 = (const Process *) p2;
-    return process1->arrival_time - process2->arrival_time;
-}
-int _compare_burst(const void *p1, const void *p2) {
-    const Process *process1 = (const Process *) p1;
-    const Process *process2 = (const Process *) p2;
-    return process1->burst_time - process2->burst_time;
+void _publishState(const struct ScheduleEvent *event, int running_id) {
+    if (!dashboard_active()) {
+        return;
+    }
+    dashboard_clock(event->time);
+    dashboard_queue(0, event->arriving);
+    dashboard_queue(1, event->ready);
+    dashboard_queue(2, event->done);
+    dashboard_cpu(0, running_id);
 }
-int _compare_priority(const void *p1, const void *p2) {
-    const Process *process1 = (const Process *) p1;
-    const Process *process2 = (const Process *) p2;
-    return process1->priority - process2->priority;
+
+void _publishComplete(const struct Process *process) {
+    dashboard_complete(1);
+    dashboard_wait(process->waiting_time);
 }
 
-void _psa_order(int order_type) {
-    switch (order_type) {
-        case 0: // Arrival Time.
-            qsort(process_list, num_processes, sizeof(Process), _compare_arrival);
-            break;
-        case 1: // Burst Time.
-            qsort(process_list, num_processes, sizeof(Process), _compare_burst);
-            break;
-        case 2: // Priority.
-            qsort(process_list, num_processes, sizeof(Process), _compare_priority);
-            break;
-        
-        default:
-            break;
+void _psaDispatch(const struct ScheduleEvent *event, void *context) {
+    int *last_quantum = context;
+    if (last_quantum != NULL && event->quantum != *last_quantum) {
+        *last_quantum = event->quantum;
+        output_printf("\n\n  Syst > Time quanta set to %d at time %lld.", event->quantum, event->time);
     }
+    output_printf("\n\n  Syst > Process %d moving from state %d to state 1.", event->process->id, event->process->state);
+    _publishState(event, event->process->id);
 }
 
-void psa_FCFS() {
-    init_process_list();
-    _psa_order(0);
+void _psaPreempt(const struct ScheduleEvent *event, void *context) {
+    (void)context;
+    if (event->section != NULL) {
+        output_printf("\n  Syst > Process %d blocked on lock %s, set to state -1.", event->process->id, lock_names[event->section->lock]);
+        return;
+    }
+    output_printf("\n  Syst > Process %d incomplete, set to state 0.", event->process->id);
+}
 
-    printf("\n\n  Syst > FCFS algorithm running. . .");
+void _psaComplete(const struct ScheduleEvent *event, void *context) {
+    (void)context;
+    output_printf("\n  Syst > Process %d complete, set to state -1.", event->process->id);
+    if (event->blocked > 0 || event->inversion > 0) {
+        output_printf(" Blocked on locks for %lld, waited behind lower priorities for %lld.", event->blocked, event->inversion);
+    }
+    _publishComplete(event->process);
+}
 
-    int total_wait = 0;
-    int total_turnaround = 0;
-    int previous_finish = 0;
+bool _psaSections() {
+    output_printf("\n  Syst > Critical sections:");
+    for (int i = 0; i < num_critical_sections; i++) {
+        const struct ScheduleSection *section = &critical_sections[i];
+        output_printf("\n    - Process %d holds %s from %d to %d of its burst", section->id, lock_names[section->lock],
+                      section->offset, section->offset + section->length);
+    }
+    if (num_critical_sections == 0) {
+        output_printf("\n    - None");
+    }
 
-    for (int i = 0; i < num_processes; i++) {
-        Process * curr = &process_list[i];
-        printf("\n\n  Syst > Process %d moving from state %d to state 1.", curr->id, curr->state);
-        curr->state = 1;
+    int mode = 0;
+    output_printf("\n  Syst > Please choose the critical sections: (1: Keep them, 2: Enter new ones)");
+    output_printf("\n\n  User > ");
+    output_flush();
+    scanf("%d", &mode);
+    _skipLine();
+    if (mode == 1) {
+        return true;
+    }
+    if (mode != 2) {
+        _textColor("\033[31m"); // red text
+        _typewriterPrint("INVALID CRITICAL SECTIONS ! ! !", 2);
+        _textColor("\033[0m");  // default text
+        return false;
+    }
 
-        curr->finish_time = previous_finish + curr->burst_time;
-        curr->waiting_time = previous_finish - curr->arrival_time;
-        curr->turnaround_time = curr->finish_time - curr->arrival_time;
+    // Entered into copies, which replace the current ones once every entry is valid.
+    struct ScheduleSection sections[PSA_MAX_SECTIONS];
+    char names[PSA_MAX_LOCKS][PSA_LOCK_NAME_SIZE];
+    int num_sections = 0;
+    int num_names = 0;
+    output_printf("\n  Syst > Please enter each critical section: (Process ID, lock name, work done before taking the lock, work done holding it; -1 to finish)");
+    while (num_sections < PSA_MAX_SECTIONS) {
+        struct ScheduleSection section = { -1, 0, 0, 0 };
+        char name[PSA_LOCK_NAME_SIZE];
+        output_printf("\n\n  User > ");
+        output_flush();
+        scanf("%d", &section.id);
+        if (section.id == -1) {
+            _skipLine();
+            break;
+        }
+        int parsed = scanf("%15s %d %d", name, &section.offset, &section.length);
+        _skipLine();
+        int lock = 0;
+        while (lock < num_names && strcmp(names[lock], name) != 0) {
+            lock++;
+        }
+        if (parsed != 3 || section.offset < 0 || section.length <= 0 || lock == PSA_MAX_LOCKS) {
+            _textColor("\033[31m"); // red text
+            _typewriterPrint((lock == PSA_MAX_LOCKS) ? "TOO MANY LOCKS ! ! !" : "INVALID CRITICAL SECTION ! ! !", 2);
+            _textColor("\033[0m");  // default text
+            return false;
+        }
+        if (lock == num_names) {
+            strcpy(names[num_names++], name);
+        }
+        section.lock = lock;
+        sections[num_sections++] = section;
+    }
+    memcpy(critical_sections, sections, num_sections * sizeof(struct ScheduleSection));
+    memcpy(lock_names, names, num_names * sizeof(names[0]));
+    num_critical_sections = num_sections;
+    output_printf("\n  Syst > %d critical section(s) set.", num_sections);
+    return true;
+}
 
-        previous_finish = curr->finish_time;
-        total_wait += curr->waiting_time;
-        total_turnaround += curr->turnaround_time;
+bool _psaRun(enum SchedulePolicy policy, const char *name) {
+    output_printf("\n\n  Syst > %s algorithm running. . .", name);
+    dashboard_reset(name);
+
+    if (policy == SCHED_RR || policy == SCHED_LOTTERY || policy == SCHED_STRIDE) {
+        output_printf("\n  Syst > Please set the time quanta: (Integer, >0)");
+        output_printf("\n\n  User > ");
+
+        output_flush();
+        scanf("%d", &round_robin_quanta);
+        _skipLine();
+        if (round_robin_quanta <= 0) {
+            round_robin_quanta = 2;
+            _textColor("\033[31m"); // red text
+            _typewriterPrint("INVALID TIME QUANTA ! ! !", 2);
+            _textColor("\033[0m");  // default text
+            return false;
+        }
+    }
+    if (policy == SCHED_ADAPTIVE_RR) {
+        output_printf("\n  Syst > Please set the target percentile, the share of recent bursts to fit in one time quanta: (Integer, 1-100)");
+        output_printf("\n\n  User > ");
+
+        output_flush();
+        scanf("%d", &adaptive_percentile);
+        _skipLine();
+        if (adaptive_percentile < 1 || adaptive_percentile > 100) {
+            adaptive_percentile = SCHEDULE_DEFAULT_PERCENTILE;
+            _textColor("\033[31m"); // red text
+            _typewriterPrint("INVALID PERCENTILE ! ! !", 2);
+            _textColor("\033[0m");  // default text
+            return false;
+        }
+    }
+    bool predictive = (policy == SCHED_PSJF || policy == SCHED_PSRTF);
+    if (predictive) {
+        output_printf("\n  Syst > Please set alpha, the weight of the last burst in the next estimate: (Decimal, 0-1)");
+        output_printf("\n\n  User > ");
+
+        output_flush();
+        scanf("%lf", &prediction_alpha);
+        _skipLine();
+        if (!(prediction_alpha >= 0 && prediction_alpha <= 1)) {
+            prediction_alpha = SCHEDULE_DEFAULT_ALPHA;
+            _textColor("\033[31m"); // red text
+            _typewriterPrint("INVALID ALPHA ! ! !", 2);
+            _textColor("\033[0m");  // default text
+            return false;
+        }
+    }
+    if (policy == SCHED_PPRI) {
+        output_printf("\n  Syst > Please choose the locking protocol: (1: None, 2: Priority inheritance, 3: Priority ceiling)");
+        output_printf("\n\n  User > ");
+
+        output_flush();
+        int protocol = 0;
+        scanf("%d", &protocol);
+        _skipLine();
+        if (protocol < 1 || protocol > 3) {
+            _textColor("\033[31m"); // red text
+            _typewriterPrint("INVALID PROTOCOL ! ! !", 2);
+            _textColor("\033[0m");  // default text
+            return false;
+        }
+        lock_protocol = protocol - 1;
+        if (!_psaSections()) {
+            return false;
+        }
+    }
 
-        printf("\n  Syst > Process %d complete, set to state -1.", curr->id);
-        curr->state = -1;
+    int last_quantum = 0;
+    struct ScheduleHooks hooks = { _psaDispatch, _psaPreempt, _psaComplete, (policy == SCHED_ADAPTIVE_RR) ? &last_quantum : NULL };
+    struct ScheduleParams params = {
+        round_robin_quanta, prediction_alpha, SCHEDULE_DEFAULT_ESTIMATE, SCHEDULE_DEFAULT_WINDOW, SCHEDULE_DEFAULT_SEED,
+        adaptive_percentile, (enum ScheduleLockProtocol)lock_protocol, critical_sections, (uint32_t)num_critical_sections
+    };
+    struct ScheduleStats stats;
+    timeline_name = NULL;
+    if (!schedule_run(&process_table, policy, &params, &hooks, &timeline, &stats)) {
+        _textColor("\033[31m"); // red text
+        _typewriterPrint("NOT ENOUGH MEMORY ! ! !", 2);
+        _textColor("\033[0m");  // default text
+        return false;
     }
 
-    last_avg_wait = (float)total_wait / num_processes;
-    last_avg_turn = (float)total_turnaround / num_processes;
+    struct ScheduleEvent finish = { stats.finish_time, NULL, 0, 0, stats.count, 0, NULL, 0, 0 };
+    _publishState(&finish, -1);
+    last_avg_wait = (float)stats.average_wait;
+    last_avg_turn = (float)stats.average_turnaround;
 
-    printf("\n\n  Syst > FCFS algorithm complete, statistics:\n    - Total turnaround: %d\n    - Total wait: %d\n    - Average turnaround: %.3f\n    - Average wait: %.3f", total_turnaround, total_wait, last_avg_turn, last_avg_wait);
+    output_printf("\n\n  Syst > %s algorithm complete, statistics:\n    - Total turnaround: %lld\n    - Total wait: %lld\n    - Average turnaround: %.3f\n    - Average wait: %.3f", name, stats.total_turnaround, stats.total_wait, last_avg_turn, last_avg_wait);
+    if (predictive) {
+        output_printf("\n    - Average prediction error: %.3f", stats.average_error);
+    }
+    if (policy == SCHED_LOTTERY || policy == SCHED_STRIDE) {
+        output_printf("\n    - CPU share error: %.2f%% over each process's life, %.2f%% on average and %.2f%% at worst in %u windows of %d",
+                      stats.share_error * 100, stats.window_error * 100, stats.max_window_error * 100, stats.num_windows, params.window);
+    }
+    if (policy == SCHED_ADAPTIVE_RR) {
+        output_printf("\n    - Time quanta: %d to %d, %.3f on average over %lld dispatches, changed %u times, ending at %d",
+                      stats.min_quantum, stats.max_quantum, stats.average_quantum, stats.dispatches, stats.quantum_changes, stats.last_quantum);
+    }
+    if (policy == SCHED_PPRI) {
+        output_printf("\n    - Blocked on locks: %lld in all, %u time(s)\n    - Priority inversion: %lld in all, %lld at worst",
+                      stats.total_blocked, stats.blocks, stats.total_inversion, stats.max_inversion);
+    }
+    timeline_name = name;
+    output_printf("\n    - Timeline: %llu slices in %zu bytes", (unsigned long long)timeline.num_slices + timeline.pending, timeline_bytes(&timeline));
+    return true;
 }
 
-void psa_SJF() {
-    init_process_list();
-    _psa_order(1);
-
-    printf("\n\n  Syst > SJF algorithm running. . .");
-
-    int total_wait = 0;
-    int total_turnaround = 0;
-    int previous_finish = 0;
-    int complete_processes = 0;
-    int current_time = 0;
-
-    while (complete_processes != num_processes) {
-        for (int i = 0; i < num_processes; i++) {
-            Process * curr = &process_list[i];
-            if (curr->arrival_time <= current_time && curr->state != -1) {
-                printf("\n\n  Syst > Process %d moving from state %d to state 1.", curr->id, curr->state);
-                curr->state = 1;
-
-                curr->finish_time = previous_finish + curr->burst_time;
-                curr->waiting_time = previous_finish - curr->arrival_time;
-                curr->turnaround_time = curr->finish_time - curr->arrival_time;
-
-                previous_finish = curr->finish_time;
-                total_wait += curr->waiting_time;
-                total_turnaround += curr->turnaround_time;
-                current_time += curr->finish_time;
-
-                printf("\n  Syst > Process %d complete, set to state -1.", curr->id);
-                curr->state = -1;
-                complete_processes++;
-                i = num_processes;
-            }
-        }
+void executeAlgorithm() {
+    int algorithm = 0;
+    int num_workers = 1;
+
+    output_printf("\n\n  Syst > Please choose the algorithm: (1: FCFS, 2: SJF, 3: RRS, 4: PRI)");
+    output_printf("\n\n  User > ");
+    output_flush();
+    scanf("%d", &algorithm);
+    _skipLine();
+    if (algorithm < 1 || algorithm > 4) {
+        _textColor("\033[31m"); // red text
+        _typewriterPrint("INVALID ALGORITHM ! ! !", 2);
+        _textColor("\033[0m");  // default text
+        return;
+    }
+    output_printf("\n  Syst > Please set the number of worker threads: (Integer, 1-%d, 1 matches the simulator)", EXEC_MAX_WORKERS);
+    output_printf("\n\n  User > ");
+    output_flush();
+    scanf("%d", &num_workers);
+    _skipLine();
+    if (num_workers < 1 || num_workers > EXEC_MAX_WORKERS) {
+        num_workers = 1;
     }
 
-    last_avg_wait = (float)total_wait / num_processes;
-    last_avg_turn = (float)total_turnaround / num_processes;
+    // Simulate first, the simulated results are left in the process table.
+    enum ExecPolicy policies[] = { EXEC_FCFS, EXEC_SJF, EXEC_RR, EXEC_PRI };
+    const char *names[] = { "FCFS", "SJF", "RRS", "PRI" };
+    enum SchedulePolicy schedule_policies[] = { SCHED_FCFS, SCHED_SJF, SCHED_RR, SCHED_PRI };
+    if (!_psaRun(schedule_policies[algorithm - 1], names[algorithm - 1])) {
+        return;
+    }
 
-    printf("\n\n  Syst > SJF algorithm complete, statistics:\n    - Total turnaround: %d\n    - Total wait: %d\n    - Average turnaround: %.3f\n    - Average wait: %.3f", total_turnaround, total_wait, last_avg_turn, last_avg_wait);
+    uint32_t num_processes = 0;
+    ProcessHandle *order = schedule_arrival_order(&process_table, &num_processes);
+    struct ExecJob *jobs = malloc((num_processes + 1) * sizeof(struct ExecJob));
+    struct ExecResult *results = malloc((num_processes + 1) * sizeof(struct ExecResult));
+    if (order == NULL || jobs == NULL || results == NULL) {
+        free(order);
+        free(jobs);
+        free(results);
+        return;
+    }
+    for (uint32_t i = 0; i < num_processes; i++) {
+        const struct Process *process = pt_get(&process_table, order[i]);
+        jobs[i].id = process->id;
+        jobs[i].priority = process->priority;
+        jobs[i].arrival_time = process->start_time;
+        jobs[i].burst_time = process->work_time;
+    }
+
+    output_printf("\n\n  Syst > Executing %s on %d worker thread(s), 1 time unit = %d us. . .", names[algorithm - 1], num_workers, EXEC_DEFAULT_UNIT_US);
+    output_flush();
+    if (runExecutor(jobs, (int)num_processes, policies[algorithm - 1], round_robin_quanta, num_workers, EXEC_DEFAULT_UNIT_US, results)) {
+        char border[80];
+        memset(border, '=', 77);
+        border[77] = '\0';
+        double sim_wait = 0, sim_turn = 0, real_wait = 0, real_turn = 0;
+
+        _frameBegin();
+        _frameAppend("\n\n  %s\n", border);
+        _frameAppend("  | ----ID---- | ARRIVAL | BURST | SIM. WAIT | REAL WAIT | SIM. TURN. | REAL TURN. |\n");
+        _frameAppend("  %s\n", border);
+        for (uint32_t i = 0; i < num_processes; i++) {
+            const struct Process *process = pt_get(&process_table, order[i]);
+            sim_wait += process->waiting_time;
+            sim_turn += process->turnaround_time;
+            real_wait += results[i].waiting_time;
+            real_turn += results[i].turnaround_time;
+            _frameRow("  | %-10d | %-7d | %-5d | %-9d | %-9.2f | %-10d | %-10.2f |\n", process->id, process->start_time,
+                      process->work_time, process->waiting_time, results[i].waiting_time,
+                      process->turnaround_time, results[i].turnaround_time);
+        }
+        _frameAppend("  %s", border);
+        _frameAppend("\n%29sAVERAGE:  %-9.3f   %-9.3f   %-10.3f   %-10.3f", "", sim_wait / num_processes, real_wait / num_processes,
+                     sim_turn / num_processes, real_turn / num_processes);
+        _frameEnd();
+    }
+    free(order);
+    free(jobs);
+    free(results);
 }
 
-void psa_RRS() {
-    init_process_list();
-    _psa_order(0);
-
-    printf("\n\n  Syst > RRS algorithm running. . .");
-    printf("\n  Syst > Please set the time quanta: (Integer, >0)");
-    printf("\n\n  User > ");
-
-    scanf("%d", &round_robin_quanta);
-
-    int total_wait = 0;
-    int total_turnaround = 0;
-    int complete_processes = 0;
-    int current_time = 0;
-
-    while (complete_processes != num_processes) {
-        for (int i = 0; i < num_processes; i++) {
-            Process * curr = &process_list[i];
-            if (curr->arrival_time <= current_time && curr->state != -1) {
-                printf("\n\n  Syst > Process %d moving from state %d to state 1.", curr->id, curr->state);
-                curr->state = 1;
-                
-                int process_time = 0;   // Time spent in this process.
-                int remaining_work = curr->burst_time - curr->work_done;
-
-                // If we finish the process.
-                if (remaining_work - round_robin_quanta <= 0) {
-                    process_time = round_robin_quanta + (remaining_work - round_robin_quanta);
-                    curr->work_done += process_time;
-                }
-                // If we don't finish the process.
-                else {
-                    process_time = round_robin_quanta;
-                    curr->work_done += process_time;
-                }
+void queryTimeline() {
+    int query = 0;
+    int first = 0;
+    int second = 0;
 
-                // Add wait time to other processes.
-                for (int j = 0; j < num_processes; j++) {
-                    Process * other = &process_list[j];
-                    if (other->arrival_time <= current_time && other->state != -1) {
-                        other->waiting_time += process_time;
-                    }
-                }
+    if (timeline_name == NULL) {
+        _textColor("\033[31m"); // red text
+        _typewriterPrint("NO ALGORITHM HAS RUN YET ! ! !", 2);
+        _textColor("\033[0m");  // default text
+        return;
+    }
+    output_printf("\n\n  Syst > Timeline of the last %s run: %llu slices in %zu bytes.", timeline_name,
+                  (unsigned long long)timeline.num_slices + timeline.pending, timeline_bytes(&timeline));
+    output_printf("\n  Syst > Please choose the query: (1: Process at a time, 2: CPU utilization of a range, 3: Slices of a process)");
+    output_printf("\n\n  User > ");
+    output_flush();
+    scanf("%d", &query);
+    _skipLine();
+
+    if (query == 1) {
+        output_printf("\n  Syst > Please set the time: (Integer)");
+        output_printf("\n\n  User > ");
+        output_flush();
+        scanf("%d", &first);
+        _skipLine();
+
+        int id;
+        if (timeline_at(&timeline, first, &id)) {
+            output_printf("\n  Syst > Process %d was running at time %d.", id, first);
+        }
+        else {
+            output_printf("\n  Syst > The CPU was idle at time %d.", first);
+        }
+    }
+    else if (query == 2) {
+        output_printf("\n  Syst > Please set the range: (Integer start, Integer end)");
+        output_printf("\n\n  User > ");
+        output_flush();
+        scanf("%d %d", &first, &second);
+        _skipLine();
+        if (second <= first) {
+            _textColor("\033[31m"); // red text
+            _typewriterPrint("INVALID RANGE ! ! !", 2);
+            _textColor("\033[0m");  // default text
+            return;
+        }
 
-                // Check if process is finished.
-                if (curr->work_done == curr->burst_time) {
-                    curr->finish_time = curr->waiting_time + curr->burst_time;
-                    curr->turnaround_time = curr->finish_time - curr->arrival_time;
+        long long busy = timeline_busy(&timeline, first, second);
+        output_printf("\n  Syst > The CPU was busy for %lld of %lld time units from %d to %d (%.1f%%).", busy,
+                      (long long)second - first, first, second, 100.0 * busy / ((long long)second - first));
+    }
+    else if (query == 3) {
+        output_printf("\n  Syst > Please set the process ID: (Integer)");
+        output_printf("\n\n  User > ");
+        output_flush();
+        scanf("%d", &first);
+        _skipLine();
+
+        uint32_t count = timeline_slices(&timeline, first, _printSlice, NULL);
+        output_printf("\n  Syst > Process %d ran in %u slice(s).", first, count);
+    }
+    else {
+        _textColor("\033[31m"); // red text
+        _typewriterPrint("INVALID QUERY ! ! !", 2);
+        _textColor("\033[0m");  // default text
+    }
+}
 
-                    total_wait += curr->waiting_time;
-                    total_turnaround += curr->turnaround_time;
+void compareAlgorithms() {
+    static const enum SchedulePolicy policies[] = {
+        SCHED_FCFS, SCHED_SJF, SCHED_RR, SCHED_PRI, SCHED_PSJF, SCHED_PSRTF, SCHED_LOTTERY, SCHED_STRIDE, SCHED_ADAPTIVE_RR
+    };
+    static const char *names[] = { "FCFS", "SJF", "RRS", "PRI", "PSJF", "PSRTF", "LOT", "STR", "ARR" };
+    int choice = 0;
+    int digits[SCHEDULE_MAX_COMPARE];
+    int num_digits = 0;
+    int quanta[SCHEDULE_MAX_COMPARE];
+    int num_quanta = 0;
+    bool wants_rr = false;
+    bool wants_alpha = false;
+
+    output_printf("\n\n  Syst > Please choose the algorithms: (Digits, e.g. 1234; 1: FCFS, 2: SJF, 3: RRS, 4: PRI, 5: PSJF, 6: PSRTF, 7: LOT, 8: STR, 9: ARR)");
+    output_printf("\n\n  User > ");
+    output_flush();
+    scanf("%d", &choice);
+    _skipLine();
+    bool valid = (choice > 0);
+    for (int rest = choice; rest > 0 && valid; rest /= 10) {
+        valid = (rest % 10 >= 1 && num_digits < SCHEDULE_MAX_COMPARE);
+        digits[num_digits++] = rest % 10;
+        wants_rr = wants_rr || (rest % 10 == 3 || rest % 10 == 7 || rest % 10 == 8);
+        wants_alpha = wants_alpha || (rest % 10 == 5 || rest % 10 == 6);
+    }
+    if (!valid) {
+        _textColor("\033[31m"); // red text
+        _typewriterPrint("INVALID ALGORITHM ! ! !", 2);
+        _textColor("\033[0m");  // default text
+        return;
+    }
 
-                    printf("\n  Syst > Process %d complete, set to state -1.", curr->id);
-                    curr->state = -1;
-                    complete_processes++;
-                }
-                else {
-                    printf("\n  Syst > Process %d incomplete, set to state 0.", curr->id);
-                    curr->state = 0;
+    if (wants_rr) {
+        char line[256];
+        output_printf("\n  Syst > Please set the time quanta to compare: (Integers >0, e.g. 2 3 4)");
+        output_printf("\n\n  User > ");
+        output_flush();
+        if (fgets(line, sizeof(line), stdin) != NULL) {
+            char *cursor = line;
+            char *end;
+            for (long value = strtol(cursor, &end, 10); end != cursor; value = strtol(cursor, &end, 10)) {
+                if (value <= 0 || value > INT_MAX || num_quanta == SCHEDULE_MAX_COMPARE) {
+                    num_quanta = 0;
+                    break;
                 }
-
-                // Iterate.
-                current_time += process_time;
+                quanta[num_quanta++] = (int)value;
+                cursor = end;
             }
         }
+        if (num_quanta == 0) {
+            _textColor("\033[31m"); // red text
+            _typewriterPrint("INVALID TIME QUANTA ! ! !", 2);
+            _textColor("\033[0m");  // default text
+            return;
+        }
+    }
+    if (wants_alpha) {
+        output_printf("\n  Syst > Please set alpha, the weight of the last burst in the next estimate: (Decimal, 0-1)");
+        output_printf("\n\n  User > ");
+        output_flush();
+        scanf("%lf", &prediction_alpha);
+        _skipLine();
+        if (!(prediction_alpha >= 0 && prediction_alpha <= 1)) {
+            prediction_alpha = SCHEDULE_DEFAULT_ALPHA;
+            _textColor("\033[31m"); // red text
+            _typewriterPrint("INVALID ALPHA ! ! !", 2);
+            _textColor("\033[0m");  // default text
+            return;
+        }
     }
 
-    last_avg_wait = (float)total_wait / num_processes;
-    last_avg_turn = (float)total_turnaround / num_processes;
+    // Generated processes have no tasks, so PSJF and PSRTF only run over the process table.
+    int source = 1;
+    if (!wants_alpha) {
+        output_printf("\n  Syst > Please choose the processes: (1: Process table, 2: Generated, replicated until the averages are stable)");
+        output_printf("\n\n  User > ");
+        output_flush();
+        scanf("%d", &source);
+        _skipLine();
+    }
+    else {
+        output_printf("\n  Syst > PSJF and PSRTF predict from the tasks of the process table, so the comparison runs over the process table.");
+    }
+    if (source != 1 && source != 2) {
+        _textColor("\033[31m"); // red text
+        _typewriterPrint("INVALID PROCESSES ! ! !", 2);
+        _textColor("\033[0m");  // default text
+        return;
+    }
 
-    printf("\n\n  Syst > RRS algorithm complete, statistics:\n    - Total turnaround: %d\n    - Total wait: %d\n    - Average turnaround: %.3f\n    - Average wait: %.3f", total_turnaround, total_wait, last_avg_turn, last_avg_wait);
+    // One row per algorithm, in the order chosen, the time-sliced ones once per time quantum.
+    enum SchedulePolicy selected[SCHEDULE_MAX_COMPARE];
+    struct ScheduleParams selected_params[SCHEDULE_MAX_COMPARE];
+    const char *selected_names[SCHEDULE_MAX_COMPARE];
+    int count = 0;
+    for (int i = num_digits - 1; i >= 0; i--) {
+        bool sliced = (digits[i] == 3 || digits[i] == 7 || digits[i] == 8);
+        int runs = sliced ? num_quanta : 1;
+        for (int q = 0; q < runs && count < SCHEDULE_MAX_COMPARE; q++) {
+            selected[count] = policies[digits[i] - 1];
+            selected_params[count].quantum = sliced ? quanta[q] : round_robin_quanta;
+            selected_params[count].alpha = prediction_alpha;
+            selected_params[count].estimate = SCHEDULE_DEFAULT_ESTIMATE;
+            selected_params[count].window = SCHEDULE_DEFAULT_WINDOW;
+            selected_params[count].seed = SCHEDULE_DEFAULT_SEED;
+            selected_params[count].percentile = adaptive_percentile;
+            selected_params[count].protocol = (enum ScheduleLockProtocol)lock_protocol;
+            selected_params[count].sections = critical_sections;
+            selected_params[count].num_sections = (uint32_t)num_critical_sections;
+            selected_names[count] = names[digits[i] - 1];
+            count++;
+        }
+    }
+
+    if (source == 2) {
+        _compareReplicated(selected, selected_params, selected_names, count);
+        return;
+    }
+
+    struct ScheduleStats stats[SCHEDULE_MAX_COMPARE];
+    struct timespec start, finish;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (!schedule_compare(&process_table, selected, selected_params, count, stats)) {
+        _textColor("\033[31m"); // red text
+        _typewriterPrint("NOT ENOUGH MEMORY ! ! !", 2);
+        _textColor("\033[0m");  // default text
+        return;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &finish);
+    double seconds = (finish.tv_sec - start.tv_sec) + (finish.tv_nsec - start.tv_nsec) / 1e9;
+
+    // Same layout as the results table in the README.
+    char border[80];
+    memset(border, '=', 77);
+    border[77] = '\0';
+    _frameBegin();
+    _frameAppend("\n\n  %s\n", border);
+    _frameAppend("  | ALGORITHM  | TOTAL TURN.     | TOTAL WAIT      | AVG. TURN.  | AVG. WAIT   |\n");
+    _frameAppend("  %s\n", border);
+    for (int i = 0; i < count; i++) {
+        char name[24];
+        if (selected[i] == SCHED_RR || selected[i] == SCHED_LOTTERY || selected[i] == SCHED_STRIDE) {
+            snprintf(name, sizeof(name), "%s (%d)", selected_names[i], selected_params[i].quantum);
+        }
+        else {
+            snprintf(name, sizeof(name), "%s", selected_names[i]);
+        }
+        _frameRow("  | %-10s | %-15lld | %-15lld | %-11.3f | %-11.3f |\n", name, stats[i].total_turnaround,
+                  stats[i].total_wait, stats[i].average_turnaround, stats[i].average_wait);
+    }
+    _frameAppend("  %s", border);
+    _frameEnd();
+    for (int i = 0; i < count; i++) {
+        if (selected[i] == SCHED_PSJF || selected[i] == SCHED_PSRTF) {
+            output_printf("\n  Syst > %s average prediction error: %.3f (alpha %.2f)", selected_names[i], stats[i].average_error, prediction_alpha);
+        }
+        else if (selected[i] == SCHED_LOTTERY || selected[i] == SCHED_STRIDE) {
+            output_printf("\n  Syst > %s (%d) CPU share error: %.2f%% over each process's life, %.2f%% on average in windows of %d",
+                          selected_names[i], selected_params[i].quantum, stats[i].share_error * 100, stats[i].window_error * 100,
+                          SCHEDULE_DEFAULT_WINDOW);
+        }
+        else if (selected[i] == SCHED_ADAPTIVE_RR) {
+            output_printf("\n  Syst > %s time quanta: %d to %d, %.3f on average over %lld dispatches (percentile %d)",
+                          selected_names[i], stats[i].min_quantum, stats[i].max_quantum, stats[i].average_quantum,
+                          stats[i].dispatches, adaptive_percentile);
+        }
+    }
+    output_printf("\n\n  Syst > Compared %d algorithm(s) over %u processes in %.3f s.", count, stats[0].count, seconds);
 }
 
-void psa_PRI() {
-    init_process_list();
-    _psa_order(2);
-
-    printf("\n\n  Syst > PRI algorithm running. . .");
-
-    int total_wait = 0;
-    int total_turnaround = 0;
-    int previous_finish = 0;
-    int complete_processes = 0;
-    int current_time = 0;
-
-    while (complete_processes != num_processes) {
-        for (int i = 0; i < num_processes; i++) {
-            Process * curr = &process_list[i];
-            if (curr->arrival_time <= current_time && curr->state != -1) {
-                printf("\n\n  Syst > Process %d moving from state %d to state 1.", curr->id, curr->state);
-                curr->state = 1;
-
-                curr->finish_time = previous_finish + curr->burst_time;
-                curr->waiting_time = previous_finish - curr->arrival_time;
-                curr->turnaround_time = curr->finish_time - curr->arrival_time;
-
-                previous_finish = curr->finish_time;
-                total_wait += curr->waiting_time;
-                total_turnaround += curr->turnaround_time;
-                current_time += curr->finish_time;
-
-                printf("\n  Syst > Process %d complete, set to state -1.", curr->id);
-                curr->state = -1;
-                complete_processes++;
-                i = num_processes;
-            }
+void _compareReplicated(const enum SchedulePolicy *selected, const struct ScheduleParams *params,
+                        const char **names, int count) {
+    struct ScheduleWorkload workload = { 0, 0, 0, 10 };
+    double precision = 0;
+    int num_processes = 0;
+
+    output_printf("\n  Syst > Please set the generated processes: (Integer processes, Decimal load, Decimal mean burst, e.g. 1000 0.9 10)");
+    output_printf("\n\n  User > ");
+    output_flush();
+    scanf("%d %lf %lf", &num_processes, &workload.load, &workload.mean_burst);
+    _skipLine();
+    output_printf("\n  Syst > Please set the precision: (Decimal percent of each average at 95%% confidence, e.g. 1)");
+    output_printf("\n\n  User > ");
+    output_flush();
+    scanf("%lf", &precision);
+    _skipLine();
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    workload.count = (num_processes > 0) ? (uint32_t)num_processes : 0;
+    struct ScheduleReplication replication = {
+        0.95, precision / 100, 10, 100000, (cpus < 1) ? 1 : (cpus > SCHEDULE_MAX_THREADS) ? SCHEDULE_MAX_THREADS : (int)cpus, 1
+    };
+
+    // Every algorithm gets the same seed, so they all run over the same workloads.
+    struct ScheduleEstimate estimates[SCHEDULE_MAX_COMPARE];
+    double seconds = 0;
+    for (int i = 0; i < count; i++) {
+        if (!schedule_replicate(selected[i], &params[i], &workload, &replication, &estimates[i])) {
+            _textColor("\033[31m"); // red text
+            _typewriterPrint("INVALID WORKLOAD OR NOT ENOUGH MEMORY ! ! !", 2);
+            _textColor("\033[0m");  // default text
+            return;
         }
+        seconds += estimates[i].seconds;
     }
 
-    last_avg_wait = (float)total_wait / num_processes;
-    last_avg_turn = (float)total_turnaround / num_processes;
+    char border[80];
+    memset(border, '=', 77);
+    border[77] = '\0';
+    bool capped = false;
+    _frameBegin();
+    _frameAppend("\n\n  %s\n", border);
+    _frameAppend("  | ALGORITHM  | AVG. TURN. (95%%)       | AVG. WAIT (95%%)        | RUNS       |\n");
+    _frameAppend("  %s\n", border);
+    for (int i = 0; i < count; i++) {
+        char name[24], turnaround[32], wait[32];
+        if (selected[i] == SCHED_RR || selected[i] == SCHED_LOTTERY || selected[i] == SCHED_STRIDE) {
+            snprintf(name, sizeof(name), "%s (%d)", names[i], params[i].quantum);
+        }
+        else {
+            snprintf(name, sizeof(name), "%s", names[i]);
+        }
+        snprintf(turnaround, sizeof(turnaround), "%.3f +- %.3f", estimates[i].mean_turnaround, estimates[i].turnaround_half_width);
+        snprintf(wait, sizeof(wait), "%.3f +- %.3f", estimates[i].mean_wait, estimates[i].wait_half_width);
+        capped = capped || !estimates[i].converged;
+        _frameRow("  | %-10s | %-22s | %-22s | %-9u%s |\n", name, turnaround, wait, estimates[i].replications,
+                  estimates[i].converged ? " " : "*");
+    }
+    _frameAppend("  %s", border);
+    _frameEnd();
+    if (capped) {
+        output_printf("\n  Syst > * Stopped at %u replications before reaching the precision.", replication.max_replications);
+    }
+    output_printf("\n\n  Syst > Replicated %d algorithm(s) over workloads of %u processes in %.3f s on %d thread(s).",
+                  count, workload.count, seconds, replication.threads);
+}
+
+void _printSlice(long long start, long long length, void *context) {
+    (void)context;
+    output_printf("\n    - From %lld to %lld", start, start + length);
+}
+
+void psa_FCFS() {
+    _psaRun(SCHED_FCFS, "FCFS");
+}
 
-    printf("\n\n  Syst > PRI algorithm complete, statistics:\n    - Total turnaround: %d\n    - Total wait: %d\n    - Average turnaround: %.3f\n    - Average wait: %.3f", total_turnaround, total_wait, last_avg_turn, last_avg_wait);
+void psa_SJF() {
+    int mode = 0;
+    output_printf("\n\n  Syst > Please choose the burst times: (1: Known in advance, 2: Predicted, 3: Predicted with preemption)");
+    output_printf("\n\n  User > ");
+    output_flush();
+    scanf("%d", &mode);
+    _skipLine();
+    switch (mode) {
+        case 1:
+            _psaRun(SCHED_SJF, "SJF");
+            break;
+        case 2:
+            _psaRun(SCHED_PSJF, "PSJF");
+            break;
+        case 3:
+            _psaRun(SCHED_PSRTF, "PSRTF");
+            break;
+        default:
+            _textColor("\033[31m"); // red text
+            _typewriterPrint("INVALID BURST TIMES ! ! !", 2);
+            _textColor("\033[0m");  // default text
+    }
+}
+
+void psa_RRS() {
+    int mode = 0;
+    output_printf("\n\n  Syst > Please choose the time quanta: (1: Fixed, 2: Adaptive to the burst times)");
+    output_printf("\n\n  User > ");
+    output_flush();
+    scanf("%d", &mode);
+    _skipLine();
+    switch (mode) {
+        case 1:
+            _psaRun(SCHED_RR, "RRS");
+            break;
+        case 2:
+            _psaRun(SCHED_ADAPTIVE_RR, "ARR");
+            break;
+        default:
+            _textColor("\033[31m"); // red text
+            _typewriterPrint("INVALID TIME QUANTA ! ! !", 2);
+            _textColor("\033[0m");  // default text
+    }
+}
+
+void psa_PRI() {
+    int mode = 0;
+    output_printf("\n\n  Syst > Please choose how the priorities are used: (1: Strict priority, 2: Lottery tickets, 3: Stride tickets, 4: Preemptive with locks)");
+    output_printf("\n\n  User > ");
+    output_flush();
+    scanf("%d", &mode);
+    _skipLine();
+    switch (mode) {
+        case 1:
+            _psaRun(SCHED_PRI, "PRI");
+            break;
+        case 2:
+            _psaRun(SCHED_LOTTERY, "LOTTERY");
+            break;
+        case 3:
+            _psaRun(SCHED_STRIDE, "STRIDE");
+            break;
+        case 4:
+            _psaRun(SCHED_PPRI, "PPRI");
+            break;
+        default:
+            _textColor("\033[31m"); // red text
+            _typewriterPrint("INVALID PRIORITY USE ! ! !", 2);
+            _textColor("\033[0m");  // default text
+    }
 }